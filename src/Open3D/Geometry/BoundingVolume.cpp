@@ -26,12 +26,11 @@
 
 #include "Open3D/Geometry/BoundingVolume.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointKernels.h"
 #include "Open3D/Geometry/Qhull.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 
-#include <numeric>
-
 #include <Eigen/Eigenvalues>
 
 namespace open3d {
@@ -129,32 +128,9 @@ std::vector<Eigen::Vector3d> OrientedBoundingBox::GetBoxPoints() const {
 
 std::vector<size_t> OrientedBoundingBox::GetPointIndicesWithinBoundingBox(
         const std::vector<Eigen::Vector3d>& points) const {
-    auto box_points = GetBoxPoints();
-    auto TestPlane = [](const Eigen::Vector3d& a, const Eigen::Vector3d& b,
-                        const Eigen::Vector3d c, const Eigen::Vector3d& x) {
-        Eigen::Matrix3d design;
-        design << (b - a), (c - a), (x - a);
-        return design.determinant();
-    };
-    std::vector<size_t> indices;
-    for (size_t idx = 0; idx < points.size(); idx++) {
-        const auto& point = points[idx];
-        if (TestPlane(box_points[0], box_points[1], box_points[3], point) <=
-                    0 &&
-            TestPlane(box_points[0], box_points[5], box_points[3], point) >=
-                    0 &&
-            TestPlane(box_points[2], box_points[5], box_points[7], point) <=
-                    0 &&
-            TestPlane(box_points[1], box_points[4], box_points[7], point) >=
-                    0 &&
-            TestPlane(box_points[3], box_points[4], box_points[5], point) <=
-                    0 &&
-            TestPlane(box_points[0], box_points[1], box_points[7], point) >=
-                    0) {
-            indices.push_back(idx);
-        }
-    }
-    return indices;
+    std::vector<char> mask;
+    kernel::ComputeMaskInOrientedBox(points, center_, R_, extent_, mask);
+    return kernel::MaskToIndices(mask);
 }
 
 OrientedBoundingBox OrientedBoundingBox::CreateFromAxisAlignedBoundingBox(
@@ -305,21 +281,7 @@ AxisAlignedBoundingBox& AxisAlignedBoundingBox::operator+=(
 AxisAlignedBoundingBox AxisAlignedBoundingBox::CreateFromPoints(
         const std::vector<Eigen::Vector3d>& points) {
     AxisAlignedBoundingBox box;
-    if (points.empty()) {
-        box.min_bound_ = Eigen::Vector3d(0.0, 0.0, 0.0);
-        box.max_bound_ = Eigen::Vector3d(0.0, 0.0, 0.0);
-    } else {
-        box.min_bound_ = std::accumulate(
-                points.begin(), points.end(), points[0],
-                [](const Eigen::Vector3d& a, const Eigen::Vector3d& b) {
-                    return a.array().min(b.array()).matrix();
-                });
-        box.max_bound_ = std::accumulate(
-                points.begin(), points.end(), points[0],
-                [](const Eigen::Vector3d& a, const Eigen::Vector3d& b) {
-                    return a.array().max(b.array()).matrix();
-                });
-    }
+    kernel::ComputeBounds(points, box.min_bound_, box.max_bound_);
     return box;
 }
 
@@ -341,16 +303,9 @@ std::vector<Eigen::Vector3d> AxisAlignedBoundingBox::GetBoxPoints() const {
 
 std::vector<size_t> AxisAlignedBoundingBox::GetPointIndicesWithinBoundingBox(
         const std::vector<Eigen::Vector3d>& points) const {
-    std::vector<size_t> indices;
-    for (size_t idx = 0; idx < points.size(); idx++) {
-        const auto& point = points[idx];
-        if (point(0) >= min_bound_(0) && point(0) <= max_bound_(0) &&
-            point(1) >= min_bound_(1) && point(1) <= max_bound_(1) &&
-            point(2) >= min_bound_(2) && point(2) <= max_bound_(2)) {
-            indices.push_back(idx);
-        }
-    }
-    return indices;
+    std::vector<char> mask;
+    kernel::ComputeMaskInAxisAlignedBox(points, min_bound_, max_bound_, mask);
+    return kernel::MaskToIndices(mask);
 }
 
 }  // namespace geometry
@@ -217,16 +217,16 @@ Eigen::Vector3d FastEigen3x3(Eigen::Matrix3d &A) {
     }
 }
 
-Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
-                              const std::vector<int> &indices,
-                              bool fast_normal_computation) {
-    if (indices.size() == 0) {
-        return Eigen::Vector3d::Zero();
+Eigen::Matrix3d ComputeCovariance(const PointCloud &cloud,
+                                  const int *indices,
+                                  size_t count) {
+    if (count == 0) {
+        return Eigen::Matrix3d::Zero();
     }
     Eigen::Matrix3d covariance;
     Eigen::Matrix<double, 9, 1> cumulants;
     cumulants.setZero();
-    for (size_t i = 0; i < indices.size(); i++) {
+    for (size_t i = 0; i < count; i++) {
         const Eigen::Vector3d &point = cloud.points_[indices[i]];
         cumulants(0) += point(0);
         cumulants(1) += point(1);
@@ -238,7 +238,7 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
         cumulants(7) += point(1) * point(2);
         cumulants(8) += point(2) * point(2);
     }
-    cumulants /= (double)indices.size();
+    cumulants /= (double)count;
     covariance(0, 0) = cumulants(3) - cumulants(0) * cumulants(0);
     covariance(1, 1) = cumulants(6) - cumulants(1) * cumulants(1);
     covariance(2, 2) = cumulants(8) - cumulants(2) * cumulants(2);
@@ -248,6 +248,21 @@ Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
     covariance(2, 0) = covariance(0, 2);
     covariance(1, 2) = cumulants(7) - cumulants(1) * cumulants(2);
     covariance(2, 1) = covariance(1, 2);
+    return covariance;
+}
+
+Eigen::Matrix3d ComputeCovariance(const PointCloud &cloud,
+                                  const std::vector<int> &indices) {
+    return ComputeCovariance(cloud, indices.data(), indices.size());
+}
+
+Eigen::Vector3d ComputeNormal(const PointCloud &cloud,
+                              const std::vector<int> &indices,
+                              bool fast_normal_computation) {
+    if (indices.size() == 0) {
+        return Eigen::Vector3d::Zero();
+    }
+    Eigen::Matrix3d covariance = ComputeCovariance(cloud, indices);
 
     if (fast_normal_computation) {
         return FastEigen3x3(covariance);
@@ -264,12 +279,14 @@ namespace geometry {
 
 bool PointCloud::EstimateNormals(
         const KDTreeSearchParam &search_param /* = KDTreeSearchParamKNN()*/,
-        bool fast_normal_computation /* = true */) {
+        bool fast_normal_computation /* = true */,
+        KDTreeFlann::Precision precision
+        /* = KDTreeFlann::Precision::Float64*/) {
     bool has_normal = HasNormals();
     if (HasNormals() == false) {
         normals_.resize(points_.size());
     }
-    KDTreeFlann kdtree;
+    KDTreeFlann kdtree(precision);
     kdtree.SetGeometry(*this);
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
@@ -299,6 +316,41 @@ bool PointCloud::EstimateNormals(
     return true;
 }
 
+bool PointCloud::EstimateCovariances(
+        const KDTreeSearchParam &search_param /* = KDTreeSearchParamKNN()*/) {
+    if (!HasPoints()) {
+        covariances_.clear();
+        return false;
+    }
+    KDTreeFlann kdtree;
+    kdtree.SetGeometry(*this);
+    // All neighborhoods are searched in one batch, in CSR layout, instead of
+    // one search with its own result vectors per point.
+    std::vector<int> offsets;
+    std::vector<int> indices;
+    std::vector<double> distance2;
+    if (kdtree.BatchSearch(points_, search_param, offsets, indices,
+                           distance2) < 0) {
+        covariances_.clear();
+        return false;
+    }
+    covariances_.resize(points_.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)points_.size(); i++) {
+        const int count = offsets[i + 1] - offsets[i];
+        if (count >= 3) {
+            covariances_[i] =
+                    ComputeCovariance(*this, indices.data() + offsets[i],
+                                      size_t(count));
+        } else {
+            covariances_[i] = Eigen::Matrix3d::Identity();
+        }
+    }
+    return true;
+}
+
 bool PointCloud::OrientNormalsToAlignWithDirection(
         const Eigen::Vector3d &orientation_reference
         /* = Eigen::Vector3d(0.0, 0.0, 1.0)*/) {
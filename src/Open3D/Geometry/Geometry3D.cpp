@@ -27,8 +27,8 @@
 #include "Open3D/Geometry/Geometry3D.h"
 
 #include <Eigen/Dense>
-#include <numeric>
 
+#include "Open3D/Geometry/PointKernels.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -36,26 +36,16 @@ namespace geometry {
 
 Eigen::Vector3d Geometry3D::ComputeMinBound(
         const std::vector<Eigen::Vector3d>& points) const {
-    if (points.empty()) {
-        return Eigen::Vector3d(0.0, 0.0, 0.0);
-    }
-    return std::accumulate(
-            points.begin(), points.end(), points[0],
-            [](const Eigen::Vector3d& a, const Eigen::Vector3d& b) {
-                return a.array().min(b.array()).matrix();
-            });
+    Eigen::Vector3d min_bound, max_bound;
+    kernel::ComputeBounds(points, min_bound, max_bound);
+    return min_bound;
 }
 
 Eigen::Vector3d Geometry3D::ComputeMaxBound(
         const std::vector<Eigen::Vector3d>& points) const {
-    if (points.empty()) {
-        return Eigen::Vector3d(0.0, 0.0, 0.0);
-    }
-    return std::accumulate(
-            points.begin(), points.end(), points[0],
-            [](const Eigen::Vector3d& a, const Eigen::Vector3d& b) {
-                return a.array().max(b.array()).matrix();
-            });
+    Eigen::Vector3d min_bound, max_bound;
+    kernel::ComputeBounds(points, min_bound, max_bound);
+    return max_bound;
 }
 Eigen::Vector3d Geometry3D::ComputeCenter(
         const std::vector<Eigen::Vector3d>& points) const {
@@ -63,7 +53,7 @@ Eigen::Vector3d Geometry3D::ComputeCenter(
     if (points.empty()) {
         return center;
     }
-    center = std::accumulate(points.begin(), points.end(), center);
+    center = kernel::ComputeSum(points);
     center /= double(points.size());
     return center;
 }
@@ -91,22 +81,18 @@ void Geometry3D::ResizeAndPaintUniformColor(
 
 void Geometry3D::TransformPoints(const Eigen::Matrix4d& transformation,
                                  std::vector<Eigen::Vector3d>& points) const {
-    for (auto& point : points) {
-        Eigen::Vector4d new_point =
-                transformation *
-                Eigen::Vector4d(point(0), point(1), point(2), 1.0);
-        point = new_point.head<3>() / new_point(3);
-    }
+    kernel::HomogeneousTransform(transformation, points);
 }
 
 void Geometry3D::TransformNormals(const Eigen::Matrix4d& transformation,
                                   std::vector<Eigen::Vector3d>& normals) const {
-    for (auto& normal : normals) {
-        Eigen::Vector4d new_normal =
-                transformation *
-                Eigen::Vector4d(normal(0), normal(1), normal(2), 0.0);
-        normal = new_normal.head<3>();
-    }
+    kernel::LinearTransform(transformation.block<3, 3>(0, 0), normals);
+}
+
+void Geometry3D::TransformCovariances(
+        const Eigen::Matrix4d& transformation,
+        std::vector<Eigen::Matrix3d>& covariances) const {
+    RotateCovariances(transformation.block<3, 3>(0, 0), covariances);
 }
 
 void Geometry3D::TranslatePoints(const Eigen::Vector3d& translation,
@@ -116,9 +102,7 @@ void Geometry3D::TranslatePoints(const Eigen::Vector3d& translation,
     if (!relative) {
         transform -= ComputeCenter(points);
     }
-    for (auto& point : points) {
-        point += transform;
-    }
+    kernel::AffineTransform(Eigen::Matrix3d::Identity(), transform, points);
 }
 
 void Geometry3D::ScalePoints(const double scale,
@@ -128,9 +112,9 @@ void Geometry3D::ScalePoints(const double scale,
     if (center && !points.empty()) {
         points_center = ComputeCenter(points);
     }
-    for (auto& point : points) {
-        point = (point - points_center) * scale + points_center;
-    }
+    // (p - c) * s + c, folded into a single affine map.
+    kernel::AffineTransform(scale * Eigen::Matrix3d::Identity(),
+                            points_center - scale * points_center, points);
 }
 
 void Geometry3D::RotatePoints(const Eigen::Matrix3d& R,
@@ -140,17 +124,20 @@ void Geometry3D::RotatePoints(const Eigen::Matrix3d& R,
     if (center && !points.empty()) {
         points_center = ComputeCenter(points);
     }
-    for (auto& point : points) {
-        point = R * (point - points_center) + points_center;
-    }
+    // R * (p - c) + c, folded into a single affine map.
+    kernel::AffineTransform(R, points_center - R * points_center, points);
 }
 
 void Geometry3D::RotateNormals(const Eigen::Matrix3d& R,
                                std::vector<Eigen::Vector3d>& normals,
                                bool center) const {
-    for (auto& normal : normals) {
-        normal = R * normal;
-    }
+    kernel::LinearTransform(R, normals);
+}
+
+void Geometry3D::RotateCovariances(
+        const Eigen::Matrix3d& R,
+        std::vector<Eigen::Matrix3d>& covariances) const {
+    kernel::RotateCovariances(R, covariances);
 }
 
 Eigen::Matrix3d Geometry3D::GetRotationMatrixFromXYZ(
@@ -151,6 +151,14 @@ protected:
     /// \param normals A list of normals to be transformed.
     void TransformNormals(const Eigen::Matrix4d& transformation,
                           std::vector<Eigen::Vector3d>& normals) const;
+    /// \brief Transforms all covariance matrices with the transformation.
+    ///
+    /// Only the rotational part R is applied, as C' = R * C * R^T.
+    ///
+    /// \param transformation 4x4 matrix for transformation.
+    /// \param covariances A list of covariance matrices to be transformed.
+    void TransformCovariances(const Eigen::Matrix4d& transformation,
+                              std::vector<Eigen::Matrix3d>& covariances) const;
     /// \brief Apply translation to the geometry coordinates.
     ///
     /// \param translation A 3D vector to transform the geometry.
@@ -196,6 +204,12 @@ protected:
     void RotateNormals(const Eigen::Matrix3d& R,
                        std::vector<Eigen::Vector3d>& normals,
                        bool center) const;
+    /// \brief Rotate all covariance matrices with the rotation matrix \p R.
+    ///
+    /// \param R A 3x3 rotation matrix.
+    /// \param covariances A list of covariance matrices to be transformed.
+    void RotateCovariances(const Eigen::Matrix3d& R,
+                           std::vector<Eigen::Matrix3d>& covariances) const;
 };
 
 }  // namespace geometry
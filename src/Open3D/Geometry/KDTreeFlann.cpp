@@ -31,46 +31,296 @@
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 
+#include <algorithm>
 #include <flann/flann.hpp>
+#include <limits>
+#include <tuple>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "Open3D/Geometry/HalfEdgeTriangleMesh.h"
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/SoAPointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
+
+namespace {
+
+Eigen::Map<const Eigen::MatrixXd> GetQueryMatrix(
+        const Eigen::MatrixXd &queries) {
+    return Eigen::Map<const Eigen::MatrixXd>(queries.data(), queries.rows(),
+                                             queries.cols());
+}
+
+Eigen::Map<const Eigen::MatrixXd> GetQueryMatrix(
+        const std::vector<Eigen::Vector3d> &queries) {
+    return Eigen::Map<const Eigen::MatrixXd>((const double *)queries.data(), 3,
+                                             queries.size());
+}
+
+/// Returns the contiguous range [begin, end) of queries handled by the calling
+/// thread when num_queries queries are split evenly among the threads of the
+/// enclosing parallel region. Each thread hands its whole range to FLANN at
+/// once, and the output order does not depend on the number of threads.
+std::pair<int, int> GetThreadQueryRange(int num_queries) {
+#ifdef _OPENMP
+    int64_t num_threads = omp_get_num_threads();
+    int64_t thread_id = omp_get_thread_num();
+#else
+    int64_t num_threads = 1;
+    int64_t thread_id = 0;
+#endif
+    int begin = int(num_queries * thread_id / num_threads);
+    int end = int(num_queries * (thread_id + 1) / num_threads);
+    return std::make_pair(begin, end);
+}
+
+/// \class ScratchBuffer
+///
+/// Scratch storage for the single precision conversions. Small requests, such
+/// as a single 3D query and its neighbors, are served from an array on the
+/// stack, so that converting the queries and distances of a per-point search
+/// does not allocate. The result vectors of the caller are still resized, and
+/// radius searches grow them with the number of neighbors found.
+template <typename Scalar>
+class ScratchBuffer {
+public:
+    Scalar *Get(size_t size) {
+        if (size <= kStackSize) {
+            return stack_;
+        }
+        heap_.resize(size);
+        return heap_.data();
+    }
+
+private:
+    static const size_t kStackSize = 64;
+    Scalar stack_[kStackSize] = {};
+    std::vector<Scalar> heap_;
+};
+
+/// The double precision searches use the caller's storage directly.
+template <>
+class ScratchBuffer<double> {};
+
+/// Wraps num_queries contiguous queries into a FLANN matrix. The double
+/// precision version does not copy.
+flann::Matrix<double> GetFlannQuery(const double *queries,
+                                    size_t num_queries,
+                                    size_t dimension,
+                                    ScratchBuffer<double> & /*buffer*/) {
+    return flann::Matrix<double>((double *)queries, num_queries, dimension);
+}
+
+/// Wraps num_queries contiguous queries into a FLANN matrix. The single
+/// precision version converts the queries into buffer.
+flann::Matrix<float> GetFlannQuery(const double *queries,
+                                   size_t num_queries,
+                                   size_t dimension,
+                                   ScratchBuffer<float> &buffer) {
+    float *data = buffer.Get(num_queries * dimension);
+    std::copy(queries, queries + num_queries * dimension, data);
+    return flann::Matrix<float>(data, num_queries, dimension);
+}
+
+/// Wraps the output distances into a FLANN matrix. The double precision
+/// version writes to distance2 directly.
+flann::Matrix<double> GetFlannDistances(double *distance2,
+                                        size_t rows,
+                                        size_t cols,
+                                        ScratchBuffer<double> & /*buffer*/) {
+    return flann::Matrix<double>(distance2, rows, cols);
+}
+
+/// Wraps the output distances into a FLANN matrix. The single precision
+/// version writes to buffer, see CopyFlannDistances().
+flann::Matrix<float> GetFlannDistances(double * /*distance2*/,
+                                       size_t rows,
+                                       size_t cols,
+                                       ScratchBuffer<float> &buffer) {
+    return flann::Matrix<float>(buffer.Get(rows * cols), rows, cols);
+}
+
+/// Converts the distances written by FLANN into distance2. Only the first
+/// filled_cols slots of each row are read, up to the first negative index, so
+/// that the slots FLANN left undefined are not touched. Nothing to do for the
+/// double precision version.
+void CopyFlannDistances(const flann::Matrix<double> & /*dists*/,
+                        const int * /*indices*/,
+                        size_t /*filled_cols*/,
+                        double * /*distance2*/) {}
+
+void CopyFlannDistances(const flann::Matrix<float> &dists,
+                        const int *indices,
+                        size_t filled_cols,
+                        double *distance2) {
+    for (size_t row = 0; row < dists.rows; row++) {
+        const size_t offset = row * dists.cols;
+        for (size_t col = 0; col < filled_cols; col++) {
+            if (indices[offset + col] < 0) {
+                break;
+            }
+            distance2[offset + col] = dists[row][col];
+        }
+    }
+}
+
+/// KNN search of num_queries contiguous queries, writing knn slots per query.
+template <typename Scalar>
+int FlannSearchKNN(const flann::Index<flann::L2<Scalar>> &index,
+                   const double *queries,
+                   size_t num_queries,
+                   size_t dimension,
+                   int knn,
+                   int *indices,
+                   double *distance2) {
+    ScratchBuffer<Scalar> query_buffer;
+    ScratchBuffer<Scalar> dists_buffer;
+    flann::Matrix<Scalar> query_flann =
+            GetFlannQuery(queries, num_queries, dimension, query_buffer);
+    flann::Matrix<int> indices_flann(indices, num_queries, knn);
+    flann::Matrix<Scalar> dists_flann =
+            GetFlannDistances(distance2, num_queries, knn, dists_buffer);
+    int k = index.knnSearch(query_flann, indices_flann, dists_flann, knn,
+                            flann::SearchParams(-1, 0.0));
+    CopyFlannDistances(dists_flann, indices,
+                       (std::min)(size_t(knn), index.size()), distance2);
+    return k;
+}
+
+/// Hybrid search of num_queries contiguous queries, writing max_nn slots per
+/// query. The slot after the last neighbor found is marked with -1, the
+/// following ones are undefined.
+template <typename Scalar>
+int FlannSearchHybrid(const flann::Index<flann::L2<Scalar>> &index,
+                      const double *queries,
+                      size_t num_queries,
+                      size_t dimension,
+                      double radius,
+                      int max_nn,
+                      int *indices,
+                      double *distance2) {
+    ScratchBuffer<Scalar> query_buffer;
+    ScratchBuffer<Scalar> dists_buffer;
+    flann::Matrix<Scalar> query_flann =
+            GetFlannQuery(queries, num_queries, dimension, query_buffer);
+    flann::SearchParams param(-1, 0.0);
+    param.max_neighbors = max_nn;
+    flann::Matrix<int> indices_flann(indices, num_queries, max_nn);
+    flann::Matrix<Scalar> dists_flann =
+            GetFlannDistances(distance2, num_queries, max_nn, dists_buffer);
+    int k = index.radiusSearch(query_flann, indices_flann, dists_flann,
+                               float(radius * radius), param);
+    CopyFlannDistances(dists_flann, indices, size_t(max_nn), distance2);
+    return k;
+}
+
+/// Radius search of the queries [begin, end). The neighbors are appended to
+/// indices and distance2, and the number of neighbors of query i is stored in
+/// counts[i].
+template <typename Scalar>
+void FlannSearchRadius(const flann::Index<flann::L2<Scalar>> &index,
+                       const double *queries,
+                       size_t dimension,
+                       int begin,
+                       int end,
+                       double radius,
+                       int *counts,
+                       std::vector<int> &indices,
+                       std::vector<double> &distance2) {
+    flann::SearchParams param(-1, 0.0);
+    param.max_neighbors = -1;
+    // These buffers keep their capacity between queries, so FLANN does not
+    // allocate once they have grown.
+    ScratchBuffer<Scalar> query_buffer;
+    std::vector<std::vector<size_t>> indices_vec(1);
+    std::vector<std::vector<Scalar>> dists_vec(1);
+    for (int i = begin; i < end; i++) {
+        flann::Matrix<Scalar> query_flann = GetFlannQuery(
+                queries + size_t(i) * dimension, 1, dimension, query_buffer);
+        counts[i] = index.radiusSearch(query_flann, indices_vec, dists_vec,
+                                       float(radius * radius), param);
+        indices.insert(indices.end(), indices_vec[0].begin(),
+                       indices_vec[0].end());
+        distance2.insert(distance2.end(), dists_vec[0].begin(),
+                         dists_vec[0].end());
+    }
+}
+
+/// Returns the data the index is built on: \p data itself if no copy is
+/// requested and it already has the precision of the index, otherwise a copy
+/// of it in \p buffer.
+template <typename T>
+const T *GetIndexData(const T *data,
+                      size_t size,
+                      bool copy,
+                      std::vector<T> &buffer) {
+    if (!copy) {
+        buffer.clear();
+        buffer.shrink_to_fit();
+        return data;
+    }
+    buffer.assign(data, data + size);
+    return buffer.data();
+}
+
+template <typename T, typename S>
+const T *GetIndexData(const S *data,
+                      size_t size,
+                      bool /*copy*/,
+                      std::vector<T> &buffer) {
+    buffer.assign(data, data + size);
+    return buffer.data();
+}
+
+}  // unnamed namespace
+
 namespace geometry {
 
-KDTreeFlann::KDTreeFlann() {}
+KDTreeFlann::KDTreeFlann(Precision precision /* = Precision::Float64 */)
+    : precision_(precision) {}
 
-KDTreeFlann::KDTreeFlann(const Eigen::MatrixXd &data) { SetMatrixData(data); }
+KDTreeFlann::KDTreeFlann(const Eigen::MatrixXd &data,
+                         Precision precision /* = Precision::Float64 */)
+    : precision_(precision) {
+    SetMatrixData(data);
+}
 
-KDTreeFlann::KDTreeFlann(const Geometry &geometry) { SetGeometry(geometry); }
+KDTreeFlann::KDTreeFlann(const Geometry &geometry,
+                         Precision precision /* = Precision::Float64 */)
+    : precision_(precision) {
+    SetGeometry(geometry);
+}
 
-KDTreeFlann::KDTreeFlann(const registration::Feature &feature) {
+KDTreeFlann::KDTreeFlann(const registration::Feature &feature,
+                         Precision precision /* = Precision::Float64 */)
+    : precision_(precision) {
     SetFeature(feature);
 }
 
 KDTreeFlann::~KDTreeFlann() {}
 
 bool KDTreeFlann::SetMatrixData(const Eigen::MatrixXd &data) {
-    return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
-            data.data(), data.rows(), data.cols()));
+    return SetRawData(data.data(), data.rows(), data.cols(), true);
 }
 
 bool KDTreeFlann::SetGeometry(const Geometry &geometry) {
     switch (geometry.GetGeometryType()) {
         case Geometry::GeometryType::PointCloud:
-            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+            return SetRawData(
                     (const double *)((const PointCloud &)geometry)
                             .points_.data(),
-                    3, ((const PointCloud &)geometry).points_.size()));
+                    3, ((const PointCloud &)geometry).points_.size(), true);
         case Geometry::GeometryType::TriangleMesh:
         case Geometry::GeometryType::HalfEdgeTriangleMesh:
-            return SetRawData(Eigen::Map<const Eigen::MatrixXd>(
+            return SetRawData(
                     (const double *)((const TriangleMesh &)geometry)
                             .vertices_.data(),
-                    3, ((const TriangleMesh &)geometry).vertices_.size()));
+                    3, ((const TriangleMesh &)geometry).vertices_.size(),
+                    true);
         case Geometry::GeometryType::Image:
         case Geometry::GeometryType::Unspecified:
         default:
@@ -84,6 +334,11 @@ bool KDTreeFlann::SetFeature(const registration::Feature &feature) {
     return SetMatrixData(feature.data_);
 }
 
+template <typename Scalar>
+bool KDTreeFlann::SetSoAPointCloud(const SoAPointCloud<Scalar> &pointcloud) {
+    return SetRawData(pointcloud.points_.data(), 3, pointcloud.Size(), false);
+}
+
 template <typename T>
 int KDTreeFlann::Search(const T &query,
                         const KDTreeSearchParam &param,
@@ -116,17 +371,19 @@ int KDTreeFlann::SearchKNN(const T &query,
     // This is optimized code for heavily repeated search.
     // Other flann::Index::knnSearch() implementations lose performance due to
     // memory allocation/deallocation.
-    if (data_.empty() || dataset_size_ <= 0 ||
-        size_t(query.rows()) != dimension_ || knn < 0) {
+    if (dataset_size_ <= 0 || size_t(query.rows()) != dimension_ || knn < 0) {
         return -1;
     }
-    flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
     indices.resize(knn);
     distance2.resize(knn);
-    flann::Matrix<int> indices_flann(indices.data(), query_flann.rows, knn);
-    flann::Matrix<double> dists_flann(distance2.data(), query_flann.rows, knn);
-    int k = flann_index_->knnSearch(query_flann, indices_flann, dists_flann,
-                                    knn, flann::SearchParams(-1, 0.0));
+    int k;
+    if (precision_ == Precision::Float32) {
+        k = FlannSearchKNN(*flann_index_float_, query.data(), 1, dimension_,
+                           knn, indices.data(), distance2.data());
+    } else {
+        k = FlannSearchKNN(*flann_index_, query.data(), 1, dimension_, knn,
+                           indices.data(), distance2.data());
+    }
     indices.resize(k);
     distance2.resize(k);
     return k;
@@ -141,19 +398,19 @@ int KDTreeFlann::SearchRadius(const T &query,
     // Since max_nn is not given, we let flann to do its own memory management.
     // Other flann::Index::radiusSearch() implementations lose performance due
     // to memory management and CPU caching.
-    if (data_.empty() || dataset_size_ <= 0 ||
-        size_t(query.rows()) != dimension_) {
+    if (dataset_size_ <= 0 || size_t(query.rows()) != dimension_) {
         return -1;
     }
-    flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
-    flann::SearchParams param(-1, 0.0);
-    param.max_neighbors = -1;
-    std::vector<std::vector<int>> indices_vec(1);
-    std::vector<std::vector<double>> dists_vec(1);
-    int k = flann_index_->radiusSearch(query_flann, indices_vec, dists_vec,
-                                       float(radius * radius), param);
-    indices = indices_vec[0];
-    distance2 = dists_vec[0];
+    indices.clear();
+    distance2.clear();
+    int k;
+    if (precision_ == Precision::Float32) {
+        FlannSearchRadius(*flann_index_float_, query.data(), dimension_, 0, 1,
+                          radius, &k, indices, distance2);
+    } else {
+        FlannSearchRadius(*flann_index_, query.data(), dimension_, 0, 1,
+                          radius, &k, indices, distance2);
+    }
     return k;
 }
 
@@ -167,43 +424,287 @@ int KDTreeFlann::SearchHybrid(const T &query,
     // It is also the recommended setting for search.
     // Other flann::Index::radiusSearch() implementations lose performance due
     // to memory allocation/deallocation.
-    if (data_.empty() || dataset_size_ <= 0 ||
-        size_t(query.rows()) != dimension_ || max_nn < 0) {
+    if (dataset_size_ <= 0 || size_t(query.rows()) != dimension_ ||
+        max_nn < 0) {
         return -1;
     }
-    flann::Matrix<double> query_flann((double *)query.data(), 1, dimension_);
-    flann::SearchParams param(-1, 0.0);
-    param.max_neighbors = max_nn;
     indices.resize(max_nn);
     distance2.resize(max_nn);
-    flann::Matrix<int> indices_flann(indices.data(), query_flann.rows, max_nn);
-    flann::Matrix<double> dists_flann(distance2.data(), query_flann.rows,
-                                      max_nn);
-    int k = flann_index_->radiusSearch(query_flann, indices_flann, dists_flann,
-                                       float(radius * radius), param);
+    int k;
+    if (precision_ == Precision::Float32) {
+        k = FlannSearchHybrid(*flann_index_float_, query.data(), 1,
+                              dimension_, radius, max_nn, indices.data(),
+                              distance2.data());
+    } else {
+        k = FlannSearchHybrid(*flann_index_, query.data(), 1, dimension_,
+                              radius, max_nn, indices.data(),
+                              distance2.data());
+    }
     indices.resize(k);
     distance2.resize(k);
     return k;
 }
 
-bool KDTreeFlann::SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data) {
-    dimension_ = data.rows();
-    dataset_size_ = data.cols();
+template <typename T>
+int KDTreeFlann::BatchSearch(const T &queries,
+                             const KDTreeSearchParam &param,
+                             std::vector<int> &offsets,
+                             std::vector<int> &indices,
+                             std::vector<double> &distance2) const {
+    int stride;
+    std::vector<int> counts;
+    int k;
+    switch (param.GetSearchType()) {
+        case KDTreeSearchParam::SearchType::Knn:
+            stride = ((const KDTreeSearchParamKNN &)param).knn_;
+            k = BatchSearchKNN(queries, stride, indices, distance2);
+            break;
+        case KDTreeSearchParam::SearchType::Radius:
+            return BatchSearchRadius(
+                    queries, ((const KDTreeSearchParamRadius &)param).radius_,
+                    offsets, indices, distance2);
+        case KDTreeSearchParam::SearchType::Hybrid:
+            stride = ((const KDTreeSearchParamHybrid &)param).max_nn_;
+            k = BatchSearchHybrid(
+                    queries, ((const KDTreeSearchParamHybrid &)param).radius_,
+                    stride, indices, distance2, counts);
+            break;
+        default:
+            return -1;
+    }
+    if (k < 0) {
+        return k;
+    }
+
+    // Compact the fixed stride output into CSR. The slots of query i start at
+    // i * stride >= offsets[i], so the copy can be done in place.
+    int num_queries = int(GetQueryMatrix(queries).cols());
+    if (counts.empty()) {
+        counts.assign(num_queries, (std::min)(stride, int(dataset_size_)));
+    }
+    offsets.resize(num_queries + 1);
+    offsets[0] = 0;
+    for (int i = 0; i < num_queries; i++) {
+        offsets[i + 1] = offsets[i] + counts[i];
+    }
+    for (int i = 0; i < num_queries; i++) {
+        if (offsets[i] == i * stride) continue;
+        std::copy(indices.begin() + size_t(i) * stride,
+                  indices.begin() + size_t(i) * stride + counts[i],
+                  indices.begin() + offsets[i]);
+        std::copy(distance2.begin() + size_t(i) * stride,
+                  distance2.begin() + size_t(i) * stride + counts[i],
+                  distance2.begin() + offsets[i]);
+    }
+    indices.resize(offsets[num_queries]);
+    distance2.resize(offsets[num_queries]);
+    return k;
+}
+
+template <typename T>
+int KDTreeFlann::BatchSearchKNN(const T &queries,
+                                int knn,
+                                std::vector<int> &indices,
+                                std::vector<double> &distance2) const {
+    Eigen::Map<const Eigen::MatrixXd> query_matrix = GetQueryMatrix(queries);
+    if (dataset_size_ <= 0 || size_t(query_matrix.rows()) != dimension_ ||
+        knn < 0) {
+        return -1;
+    }
+    int num_queries = int(query_matrix.cols());
+    indices.resize(size_t(num_queries) * knn);
+    distance2.resize(size_t(num_queries) * knn);
+    if (knn == 0 || num_queries == 0) {
+        return 0;
+    }
+    int total = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+ : total)
+#endif
+    {
+        int begin, end;
+        std::tie(begin, end) = GetThreadQueryRange(num_queries);
+        if (begin < end) {
+            const double *queries_begin =
+                    query_matrix.data() + size_t(begin) * dimension_;
+            int *indices_begin = indices.data() + size_t(begin) * knn;
+            double *distance2_begin = distance2.data() + size_t(begin) * knn;
+            if (precision_ == Precision::Float32) {
+                total += FlannSearchKNN(*flann_index_float_, queries_begin,
+                                        end - begin, dimension_, knn,
+                                        indices_begin, distance2_begin);
+            } else {
+                total += FlannSearchKNN(*flann_index_, queries_begin,
+                                        end - begin, dimension_, knn,
+                                        indices_begin, distance2_begin);
+            }
+            // The slots FLANN could not fill are undefined.
+            for (int i = begin; i < end && size_t(knn) > dataset_size_; i++) {
+                size_t first_unused = size_t(i) * knn + dataset_size_;
+                std::fill(indices.begin() + first_unused,
+                          indices.begin() + size_t(i + 1) * knn, -1);
+                std::fill(distance2.begin() + first_unused,
+                          distance2.begin() + size_t(i + 1) * knn,
+                          std::numeric_limits<double>::infinity());
+            }
+        }
+    }
+    return total;
+}
+
+template <typename T>
+int KDTreeFlann::BatchSearchRadius(const T &queries,
+                                   double radius,
+                                   std::vector<int> &offsets,
+                                   std::vector<int> &indices,
+                                   std::vector<double> &distance2) const {
+    Eigen::Map<const Eigen::MatrixXd> query_matrix = GetQueryMatrix(queries);
+    if (dataset_size_ <= 0 || size_t(query_matrix.rows()) != dimension_) {
+        return -1;
+    }
+    int num_queries = int(query_matrix.cols());
+    offsets.assign(num_queries + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        int begin, end;
+        std::tie(begin, end) = GetThreadQueryRange(num_queries);
+        std::vector<int> indices_private;
+        std::vector<double> distance2_private;
+        if (precision_ == Precision::Float32) {
+            FlannSearchRadius(*flann_index_float_, query_matrix.data(),
+                              dimension_, begin, end, radius,
+                              offsets.data() + 1, indices_private,
+                              distance2_private);
+        } else {
+            FlannSearchRadius(*flann_index_, query_matrix.data(), dimension_,
+                              begin, end, radius, offsets.data() + 1,
+                              indices_private, distance2_private);
+        }
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+        {
+            for (int i = 0; i < num_queries; i++) {
+                offsets[i + 1] += offsets[i];
+            }
+            indices.resize(offsets[num_queries]);
+            distance2.resize(offsets[num_queries]);
+        }
+        if (begin < end) {
+            std::copy(indices_private.begin(), indices_private.end(),
+                      indices.begin() + offsets[begin]);
+            std::copy(distance2_private.begin(), distance2_private.end(),
+                      distance2.begin() + offsets[begin]);
+        }
+    }
+    return offsets[num_queries];
+}
+
+template <typename T>
+int KDTreeFlann::BatchSearchHybrid(const T &queries,
+                                   double radius,
+                                   int max_nn,
+                                   std::vector<int> &indices,
+                                   std::vector<double> &distance2,
+                                   std::vector<int> &counts) const {
+    Eigen::Map<const Eigen::MatrixXd> query_matrix = GetQueryMatrix(queries);
+    if (dataset_size_ <= 0 || size_t(query_matrix.rows()) != dimension_ ||
+        max_nn < 0) {
+        return -1;
+    }
+    int num_queries = int(query_matrix.cols());
+    indices.resize(size_t(num_queries) * max_nn);
+    distance2.resize(size_t(num_queries) * max_nn);
+    counts.assign(num_queries, 0);
+    if (max_nn == 0 || num_queries == 0) {
+        return 0;
+    }
+    int total = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction(+ : total)
+#endif
+    {
+        int begin, end;
+        std::tie(begin, end) = GetThreadQueryRange(num_queries);
+        if (begin < end) {
+            const double *queries_begin =
+                    query_matrix.data() + size_t(begin) * dimension_;
+            int *indices_begin = indices.data() + size_t(begin) * max_nn;
+            double *distance2_begin = distance2.data() + size_t(begin) * max_nn;
+            if (precision_ == Precision::Float32) {
+                FlannSearchHybrid(*flann_index_float_, queries_begin,
+                                  end - begin, dimension_, radius, max_nn,
+                                  indices_begin, distance2_begin);
+            } else {
+                FlannSearchHybrid(*flann_index_, queries_begin, end - begin,
+                                  dimension_, radius, max_nn, indices_begin,
+                                  distance2_begin);
+            }
+            // FLANN marks the slot after the last neighbor found with -1, and
+            // leaves the following ones undefined.
+            for (int i = begin; i < end; i++) {
+                int *indices_i = indices.data() + size_t(i) * max_nn;
+                double *distance2_i = distance2.data() + size_t(i) * max_nn;
+                int k = 0;
+                while (k < max_nn && indices_i[k] >= 0) k++;
+                std::fill(indices_i + k, indices_i + max_nn, -1);
+                std::fill(distance2_i + k, distance2_i + max_nn,
+                          std::numeric_limits<double>::infinity());
+                counts[i] = k;
+                total += k;
+            }
+        }
+    }
+    return total;
+}
+
+template <typename T>
+bool KDTreeFlann::SetRawData(const T *data,
+                             size_t dimension,
+                             size_t size,
+                             bool copy) {
+    dimension_ = dimension;
+    dataset_size_ = size;
     if (dimension_ == 0 || dataset_size_ == 0) {
         utility::LogWarning("[KDTreeFlann::SetRawData] Failed due to no data.");
         return false;
     }
-    data_.resize(dataset_size_ * dimension_);
-    memcpy(data_.data(), data.data(),
-           dataset_size_ * dimension_ * sizeof(double));
-    flann_dataset_.reset(new flann::Matrix<double>((double *)data_.data(),
-                                                   dataset_size_, dimension_));
-    flann_index_.reset(new flann::Index<flann::L2<double>>(
-            *flann_dataset_, flann::KDTreeSingleIndexParams(15)));
-    flann_index_->buildIndex();
+    if (precision_ == Precision::Float32) {
+        data_.clear();
+        data_.shrink_to_fit();
+        flann_dataset_.reset();
+        flann_index_.reset();
+        const float *index_data = GetIndexData(
+                data, dataset_size_ * dimension_, copy, data_float_);
+        flann_dataset_float_.reset(new flann::Matrix<float>(
+                (float *)index_data, dataset_size_, dimension_));
+        flann_index_float_.reset(new flann::Index<flann::L2<float>>(
+                *flann_dataset_float_, flann::KDTreeSingleIndexParams(15)));
+        flann_index_float_->buildIndex();
+    } else {
+        data_float_.clear();
+        data_float_.shrink_to_fit();
+        flann_dataset_float_.reset();
+        flann_index_float_.reset();
+        const double *index_data =
+                GetIndexData(data, dataset_size_ * dimension_, copy, data_);
+        flann_dataset_.reset(new flann::Matrix<double>(
+                (double *)index_data, dataset_size_, dimension_));
+        flann_index_.reset(new flann::Index<flann::L2<double>>(
+                *flann_dataset_, flann::KDTreeSingleIndexParams(15)));
+        flann_index_->buildIndex();
+    }
     return true;
 }
 
+template bool KDTreeFlann::SetSoAPointCloud<float>(
+        const SoAPointCloud<float> &pointcloud);
+template bool KDTreeFlann::SetSoAPointCloud<double>(
+        const SoAPointCloud<double> &pointcloud);
+
 template int KDTreeFlann::Search<Eigen::Vector3d>(
         const Eigen::Vector3d &query,
         const KDTreeSearchParam &param,
@@ -248,6 +749,56 @@ template int KDTreeFlann::SearchHybrid<Eigen::VectorXd>(
         std::vector<int> &indices,
         std::vector<double> &distance2) const;
 
+template int KDTreeFlann::BatchSearch<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        const KDTreeSearchParam &param,
+        std::vector<int> &offsets,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int KDTreeFlann::BatchSearchKNN<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        int knn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int KDTreeFlann::BatchSearchRadius<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        double radius,
+        std::vector<int> &offsets,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int KDTreeFlann::BatchSearchHybrid<Eigen::MatrixXd>(
+        const Eigen::MatrixXd &queries,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2,
+        std::vector<int> &counts) const;
+
+template int KDTreeFlann::BatchSearch<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        const KDTreeSearchParam &param,
+        std::vector<int> &offsets,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int KDTreeFlann::BatchSearchKNN<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        int knn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int KDTreeFlann::BatchSearchRadius<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        double radius,
+        std::vector<int> &offsets,
+        std::vector<int> &indices,
+        std::vector<double> &distance2) const;
+template int KDTreeFlann::BatchSearchHybrid<std::vector<Eigen::Vector3d>>(
+        const std::vector<Eigen::Vector3d> &queries,
+        double radius,
+        int max_nn,
+        std::vector<int> &indices,
+        std::vector<double> &distance2,
+        std::vector<int> &counts) const;
+
 }  // namespace geometry
 }  // namespace open3d
 
@@ -46,31 +46,61 @@ class Index;
 namespace open3d {
 namespace geometry {
 
+template <typename Scalar>
+class SoAPointCloud;
+
 /// \class KDTreeFlann
 ///
 /// \brief KDTree with FLANN for nearest neighbor search.
 class KDTreeFlann {
+public:
+    /// \enum Precision
+    ///
+    /// \brief Floating point precision of the points stored in the index.
+    ///
+    /// Queries and output distances are always double; a Float32 index
+    /// converts them on the fly.
+    enum class Precision {
+        /// Keeps a double copy of the data. Default.
+        Float64 = 0,
+        /// Keeps a float copy of the data. Halves the memory footprint and
+        /// improves cache behavior of the search at the cost of precision,
+        /// which is usually sufficient for 3D point clouds.
+        Float32 = 1,
+    };
+
 public:
     /// \brief Default Constructor.
-    KDTreeFlann();
+    ///
+    /// \param precision Precision of the index built by the Set*() methods.
+    explicit KDTreeFlann(Precision precision = Precision::Float64);
     /// \brief Parameterized Constructor.
     ///
     /// \param data Provides set of data points for KDTree construction.
-    KDTreeFlann(const Eigen::MatrixXd &data);
+    /// \param precision Precision of the index.
+    KDTreeFlann(const Eigen::MatrixXd &data,
+                Precision precision = Precision::Float64);
     /// \brief Parameterized Constructor.
     ///
     /// \param geometry Provides geometry from which KDTree is constructed.
-    KDTreeFlann(const Geometry &geometry);
+    /// \param precision Precision of the index.
+    KDTreeFlann(const Geometry &geometry,
+                Precision precision = Precision::Float64);
     /// \brief Parameterized Constructor.
     ///
     /// \param feature Provides a set of features from which the KDTree is
     /// constructed.
-    KDTreeFlann(const registration::Feature &feature);
+    /// \param precision Precision of the index.
+    KDTreeFlann(const registration::Feature &feature,
+                Precision precision = Precision::Float64);
     ~KDTreeFlann();
     KDTreeFlann(const KDTreeFlann &) = delete;
     KDTreeFlann &operator=(const KDTreeFlann &) = delete;
 
 public:
+    /// Returns the precision of the index.
+    Precision GetPrecision() const { return precision_; }
+
     /// Sets the data for the KDTree from a matrix.
     ///
     /// \param data Data points for KDTree Construction.
@@ -83,6 +113,15 @@ public:
     ///
     /// \param feature Set of features for KDTree construction.
     bool SetFeature(const registration::Feature &feature);
+    /// \brief Sets the data for the KDTree from the points of a SoAPointCloud.
+    ///
+    /// If the precision of the KDTree matches \p Scalar, the index is built
+    /// directly on the point buffer, without a copy. The points must then
+    /// stay alive and unchanged until the KDTree is destroyed or set again.
+    ///
+    /// \param pointcloud Point cloud for KDTree construction.
+    template <typename Scalar>
+    bool SetSoAPointCloud(const SoAPointCloud<Scalar> &pointcloud);
 
     template <typename T>
     int Search(const T &query,
@@ -109,17 +148,109 @@ public:
                      std::vector<int> &indices,
                      std::vector<double> &distance2) const;
 
+    /// \brief Batch search with compressed sparse row (CSR) output.
+    ///
+    /// Searches the neighbors of all queries in parallel. The neighbors of
+    /// query i are stored in indices[offsets[i], offsets[i + 1]) and
+    /// distance2[offsets[i], offsets[i + 1]).
+    ///
+    /// \param queries The queries, either an Eigen::MatrixXd holding one query
+    /// per column or a std::vector<Eigen::Vector3d>.
+    /// \param param The search parameter.
+    /// \param offsets Output offsets, of size number of queries + 1.
+    /// \param indices Output neighbor indices.
+    /// \param distance2 Output squared distances.
+    /// \return The total number of neighbors found, or -1 on failure.
+    template <typename T>
+    int BatchSearch(const T &queries,
+                    const KDTreeSearchParam &param,
+                    std::vector<int> &offsets,
+                    std::vector<int> &indices,
+                    std::vector<double> &distance2) const;
+
+    /// \brief Batch KNN search with fixed stride output.
+    ///
+    /// Searches the knn nearest neighbors of all queries in parallel. The
+    /// neighbors of query i are stored in indices[i * knn, (i + 1) * knn) and
+    /// distance2[i * knn, (i + 1) * knn), sorted by distance. If the KDTree
+    /// holds fewer than knn points, the unused slots have index -1.
+    ///
+    /// \param queries The queries, either an Eigen::MatrixXd holding one query
+    /// per column or a std::vector<Eigen::Vector3d>.
+    /// \param knn Number of neighbors searched per query.
+    /// \param indices Output neighbor indices.
+    /// \param distance2 Output squared distances.
+    /// \return The total number of neighbors found, or -1 on failure.
+    template <typename T>
+    int BatchSearchKNN(const T &queries,
+                       int knn,
+                       std::vector<int> &indices,
+                       std::vector<double> &distance2) const;
+
+    /// \brief Batch radius search with compressed sparse row (CSR) output.
+    ///
+    /// Searches the neighbors within radius of all queries in parallel. The
+    /// neighbors of query i are stored in indices[offsets[i], offsets[i + 1])
+    /// and distance2[offsets[i], offsets[i + 1]), sorted by distance.
+    ///
+    /// \param queries The queries, either an Eigen::MatrixXd holding one query
+    /// per column or a std::vector<Eigen::Vector3d>.
+    /// \param radius Search radius.
+    /// \param offsets Output offsets, of size number of queries + 1.
+    /// \param indices Output neighbor indices.
+    /// \param distance2 Output squared distances.
+    /// \return The total number of neighbors found, or -1 on failure.
+    template <typename T>
+    int BatchSearchRadius(const T &queries,
+                          double radius,
+                          std::vector<int> &offsets,
+                          std::vector<int> &indices,
+                          std::vector<double> &distance2) const;
+
+    /// \brief Batch hybrid search with fixed stride output.
+    ///
+    /// Searches at most max_nn neighbors within radius of all queries in
+    /// parallel. The neighbors of query i are stored in
+    /// indices[i * max_nn, i * max_nn + counts[i]) and the corresponding
+    /// range of distance2, sorted by distance. The unused slots have index -1.
+    ///
+    /// \param queries The queries, either an Eigen::MatrixXd holding one query
+    /// per column or a std::vector<Eigen::Vector3d>.
+    /// \param radius Search radius.
+    /// \param max_nn At maximum, max_nn neighbors are searched per query.
+    /// \param indices Output neighbor indices.
+    /// \param distance2 Output squared distances.
+    /// \param counts Output number of neighbors found per query.
+    /// \return The total number of neighbors found, or -1 on failure.
+    template <typename T>
+    int BatchSearchHybrid(const T &queries,
+                          double radius,
+                          int max_nn,
+                          std::vector<int> &indices,
+                          std::vector<double> &distance2,
+                          std::vector<int> &counts) const;
+
 private:
     /// \brief Sets the KDTree data from the data provided by the other methods.
     ///
     /// Internal method that sets all the members of KDTree by data provided by
     /// features, geometry, etc.
-    bool SetRawData(const Eigen::Map<const Eigen::MatrixXd> &data);
+    ///
+    /// \param data \p size points of \p dimension values each, one after the
+    /// other.
+    /// \param copy If `false` and \p T matches the precision of the KDTree,
+    /// the index refers to \p data instead of a copy.
+    template <typename T>
+    bool SetRawData(const T *data, size_t dimension, size_t size, bool copy);
 
 protected:
     std::vector<double> data_;
     std::unique_ptr<flann::Matrix<double>> flann_dataset_;
     std::unique_ptr<flann::Index<flann::L2<double>>> flann_index_;
+    std::vector<float> data_float_;
+    std::unique_ptr<flann::Matrix<float>> flann_dataset_float_;
+    std::unique_ptr<flann::Index<flann::L2<float>>> flann_index_float_;
+    Precision precision_ = Precision::Float64;
     size_t dimension_ = 0;
     size_t dataset_size_ = 0;
 };
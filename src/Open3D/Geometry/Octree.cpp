@@ -397,8 +397,9 @@ void Octree::ConvertFromPointCloud(const geometry::PointCloud& point_cloud,
 
     // Set bounds
     Clear();
-    Eigen::Array3d min_bound = point_cloud.GetMinBound();
-    Eigen::Array3d max_bound = point_cloud.GetMaxBound();
+    const AxisAlignedBoundingBox box = point_cloud.GetAxisAlignedBoundingBox();
+    Eigen::Array3d min_bound = box.min_bound_;
+    Eigen::Array3d max_bound = box.max_bound_;
     Eigen::Array3d center = (min_bound + max_bound) / 2;
     Eigen::Array3d half_sizes = center - min_bound;
     double max_half_size = half_sizes.maxCoeff();
@@ -29,11 +29,17 @@
 #include "Open3D/Geometry/TriangleMesh.h"
 
 #include <Eigen/Dense>
+#include <algorithm>
+#include <limits>
 #include <numeric>
+#include <random>
+#include <unordered_map>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointKernels.h"
 #include "Open3D/Geometry/Qhull.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Parallel.h"
 
 namespace open3d {
 namespace geometry {
@@ -42,6 +48,7 @@ PointCloud &PointCloud::Clear() {
     points_.clear();
     normals_.clear();
     colors_.clear();
+    covariances_.clear();
     return *this;
 }
 
@@ -65,9 +72,15 @@ OrientedBoundingBox PointCloud::GetOrientedBoundingBox() const {
     return OrientedBoundingBox::CreateFromPoints(points_);
 }
 
+PointCloud &PointCloud::NormalizeNormals() {
+    kernel::Normalize(normals_);
+    return *this;
+}
+
 PointCloud &PointCloud::Transform(const Eigen::Matrix4d &transformation) {
     TransformPoints(transformation, points_);
     TransformNormals(transformation, normals_);
+    TransformCovariances(transformation, covariances_);
     return *this;
 }
 
@@ -79,12 +92,16 @@ PointCloud &PointCloud::Translate(const Eigen::Vector3d &translation,
 
 PointCloud &PointCloud::Scale(const double scale, bool center) {
     ScalePoints(scale, points_, center);
+    for (auto &covariance : covariances_) {
+        covariance *= scale * scale;
+    }
     return *this;
 }
 
 PointCloud &PointCloud::Rotate(const Eigen::Matrix3d &R, bool center) {
     RotatePoints(R, points_, center);
     RotateNormals(R, normals_, center);
+    RotateCovariances(R, covariances_);
     return *this;
 }
 
@@ -109,6 +126,13 @@ PointCloud &PointCloud::operator+=(const PointCloud &cloud) {
     } else {
         colors_.clear();
     }
+    if ((!HasPoints() || HasCovariances()) && cloud.HasCovariances()) {
+        covariances_.resize(new_vert_num);
+        for (size_t i = 0; i < add_vert_num; i++)
+            covariances_[old_vert_num + i] = cloud.covariances_[i];
+    } else {
+        covariances_.clear();
+    }
     points_.resize(new_vert_num);
     for (size_t i = 0; i < add_vert_num; i++)
         points_[old_vert_num + i] = cloud.points_[i];
@@ -121,22 +145,25 @@ PointCloud PointCloud::operator+(const PointCloud &cloud) const {
 
 std::vector<double> PointCloud::ComputePointCloudDistance(
         const PointCloud &target) {
-    std::vector<double> distances(points_.size());
+    std::vector<double> distances(points_.size(), 0.0);
     KDTreeFlann kdtree;
     kdtree.SetGeometry(target);
+    std::vector<int> indices;
+    std::vector<double> dists;
+    if (kdtree.BatchSearchKNN(points_, 1, indices, dists) < 0) {
+        return distances;
+    }
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)points_.size(); i++) {
-        std::vector<int> indices(1);
-        std::vector<double> dists(1);
-        if (kdtree.SearchKNN(points_[i], 1, indices, dists) == 0) {
+        if (indices[i] < 0) {
             utility::LogDebug(
                     "[ComputePointCloudToPointCloudDistance] Found a point "
                     "without neighbors.");
             distances[i] = 0.0;
         } else {
-            distances[i] = std::sqrt(dists[0]);
+            distances[i] = std::sqrt(dists[i]);
         }
     }
     return distances;
@@ -146,6 +173,7 @@ PointCloud &PointCloud::RemoveNonFinitePoints(bool remove_nan,
                                               bool remove_infinite) {
     bool has_normal = HasNormals();
     bool has_color = HasColors();
+    bool has_covariance = HasCovariances();
     size_t old_point_num = points_.size();
     size_t k = 0;                                 // new index
     for (size_t i = 0; i < old_point_num; i++) {  // old index
@@ -159,36 +187,98 @@ PointCloud &PointCloud::RemoveNonFinitePoints(bool remove_nan,
             points_[k] = points_[i];
             if (has_normal) normals_[k] = normals_[i];
             if (has_color) colors_[k] = colors_[i];
+            if (has_covariance) covariances_[k] = covariances_[i];
             k++;
         }
     }
     points_.resize(k);
     if (has_normal) normals_.resize(k);
     if (has_color) colors_.resize(k);
+    if (has_covariance) covariances_.resize(k);
     utility::LogDebug(
             "[RemoveNonFinitePoints] {:d} nan points have been removed.",
             (int)(old_point_num - k));
     return *this;
 }
 
-std::shared_ptr<PointCloud> PointCloud::SelectByIndex(
-        const std::vector<size_t> &indices, bool invert /* = false */) const {
+namespace {
+
+/// Copies the points of \p cloud with a set \p mask entry, together with
+/// their attributes, into a new pointcloud. If \p transformation is given, it
+/// is applied to the copies the same way PointCloud::Transform() would.
+std::shared_ptr<PointCloud> SelectByMask(
+        const PointCloud &cloud,
+        const std::vector<char> &mask,
+        const Eigen::Matrix4d *transformation) {
     auto output = std::make_shared<PointCloud>();
-    bool has_normals = HasNormals();
-    bool has_colors = HasColors();
+    const bool has_normals = cloud.HasNormals();
+    const bool has_colors = cloud.HasColors();
+    const bool has_covariances = cloud.HasCovariances();
 
-    std::vector<bool> mask = std::vector<bool>(points_.size(), invert);
-    for (size_t i : indices) {
-        mask[i] = !invert;
-    }
+    std::vector<size_t> block_offsets;
+    const size_t num_selected =
+            kernel::ComputeBlockOffsets(mask, block_offsets);
+    output->points_.resize(num_selected);
+    if (has_normals) output->normals_.resize(num_selected);
+    if (has_colors) output->colors_.resize(num_selected);
+    if (has_covariances) output->covariances_.resize(num_selected);
 
-    for (size_t i = 0; i < points_.size(); i++) {
-        if (mask[i]) {
-            output->points_.push_back(points_[i]);
-            if (has_normals) output->normals_.push_back(normals_[i]);
-            if (has_colors) output->colors_.push_back(colors_[i]);
+    const bool transform = transformation != nullptr;
+    const Eigen::Matrix4d T =
+            transform ? *transformation : Eigen::Matrix4d::Identity();
+    const bool affine = kernel::IsAffine(T);
+    const Eigen::Matrix3d R = T.block<3, 3>(0, 0);
+    const Eigen::Vector3d t = T.block<3, 1>(0, 3);
+    const int64_t num_points = int64_t(mask.size());
+    const int64_t num_blocks = int64_t(block_offsets.size()) - 1;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t b = 0; b < num_blocks; b++) {
+        const int64_t begin = b * kernel::kPointBlockSize;
+        const int64_t end =
+                (std::min)(begin + kernel::kPointBlockSize, num_points);
+        size_t j = block_offsets[b];
+        for (int64_t i = begin; i < end; i++) {
+            if (!mask[i]) {
+                continue;
+            }
+            const Eigen::Vector3d &point = cloud.points_[i];
+            if (!transform) {
+                output->points_[j] = point;
+            } else if (affine) {
+                output->points_[j] = R * point + t;
+            } else {
+                const Eigen::Vector4d p = T * point.homogeneous();
+                output->points_[j] = p.head<3>() / p(3);
+            }
+            if (has_normals) {
+                output->normals_[j] =
+                        transform ? R * cloud.normals_[i] : cloud.normals_[i];
+            }
+            if (has_colors) {
+                output->colors_[j] = cloud.colors_[i];
+            }
+            if (has_covariances) {
+                output->covariances_[j] =
+                        transform ? R * cloud.covariances_[i] * R.transpose()
+                                  : cloud.covariances_[i];
+            }
+            j++;
         }
     }
+    return output;
+}
+
+}  // unnamed namespace
+
+std::shared_ptr<PointCloud> PointCloud::SelectByIndex(
+        const std::vector<size_t> &indices, bool invert /* = false */) const {
+    std::vector<char> mask(points_.size(), char(invert));
+    for (size_t i : indices) {
+        mask[i] = char(!invert);
+    }
+    auto output = SelectByMask(*this, mask, nullptr);
     utility::LogDebug(
             "Pointcloud down sampled from {:d} points to {:d} points.",
             (int)points_.size(), (int)output->points_.size());
@@ -238,63 +328,110 @@ public:
     Eigen::Vector3d color_;
 };
 
-class point_cubic_id {
-public:
-    size_t point_id;
-    int cubic_id;
-};
-
-class AccumulatedPointForTrace : public AccumulatedPoint {
-public:
-    void AddPoint(const PointCloud &cloud,
-                  size_t index,
-                  int cubic_index,
-                  bool approximate_class) {
-        point_ += cloud.points_[index];
-        if (cloud.HasNormals()) {
-            if (!std::isnan(cloud.normals_[index](0)) &&
-                !std::isnan(cloud.normals_[index](1)) &&
-                !std::isnan(cloud.normals_[index](2))) {
-                normal_ += cloud.normals_[index];
-            }
+// Groups the points by voxel, with voxel (0, 0, 0) starting at
+// voxel_min_bound. On return the points of voxel v are order[voxel_begins[v]],
+// ..., order[voxel_begins[v + 1] - 1] in ascending order, and the voxels are
+// sorted by index. The voxel indices are packed into 64-bit keys that are
+// sorted together with the point indices, which takes all threads and gives
+// the same grouping for any number of threads.
+void GroupPointsByVoxel(const std::vector<Eigen::Vector3d> &points,
+                        const Eigen::Vector3d &voxel_min_bound,
+                        double voxel_size,
+                        std::vector<int> &order,
+                        std::vector<int> &voxel_begins) {
+    const int num_points = (int)points.size();
+    order.resize(num_points);
+    voxel_begins.assign(1, 0);
+    if (num_points == 0) {
+        return;
+    }
+    std::vector<Eigen::Vector3i> voxel_indices(num_points);
+    Eigen::Vector3i min_index =
+            Eigen::Vector3i::Constant(std::numeric_limits<int>::max());
+    Eigen::Vector3i max_index =
+            Eigen::Vector3i::Constant(std::numeric_limits<int>::min());
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        Eigen::Vector3i local_min_index = min_index;
+        Eigen::Vector3i local_max_index = max_index;
+#ifdef _OPENMP
+#pragma omp for nowait
+#endif
+        for (int i = 0; i < num_points; i++) {
+            const Eigen::Vector3d ref_coord =
+                    (points[i] - voxel_min_bound) / voxel_size;
+            voxel_indices[i] << int(floor(ref_coord(0))),
+                    int(floor(ref_coord(1))), int(floor(ref_coord(2)));
+            local_min_index = local_min_index.cwiseMin(voxel_indices[i]);
+            local_max_index = local_max_index.cwiseMax(voxel_indices[i]);
         }
-        if (cloud.HasColors()) {
-            if (approximate_class) {
-                auto got = classes.find(int(cloud.colors_[index][0]));
-                if (got == classes.end())
-                    classes[int(cloud.colors_[index][0])] = 1;
-                else
-                    classes[int(cloud.colors_[index][0])] += 1;
-            } else {
-                color_ += cloud.colors_[index];
-            }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        {
+            min_index = min_index.cwiseMin(local_min_index);
+            max_index = max_index.cwiseMax(local_max_index);
         }
-        point_cubic_id new_id;
-        new_id.point_id = index;
-        new_id.cubic_id = cubic_index;
-        original_id.push_back(new_id);
-        num_of_points_++;
     }
 
-    Eigen::Vector3d GetMaxClass() {
-        int max_class = -1;
-        int max_count = -1;
-        for (auto it = classes.begin(); it != classes.end(); it++) {
-            if (it->second > max_count) {
-                max_count = it->second;
-                max_class = it->first;
+    // Key of voxel (x, y, z) is (x * dims(1) + y) * dims(2) + z, relative to
+    // min_index. Voxel grids too large for 64-bit keys, with more than about
+    // 2.6M voxels along every axis, compare the indices instead.
+    uint64_t dims[3];
+    for (int c = 0; c < 3; c++) {
+        dims[c] = uint64_t(int64_t(max_index(c)) - min_index(c)) + 1;
+    }
+    const uint64_t max_key = std::numeric_limits<uint64_t>::max();
+    const bool use_keys = dims[1] <= max_key / dims[2] &&
+                          dims[0] <= max_key / (dims[1] * dims[2]);
+    std::vector<std::pair<uint64_t, int>> keyed_points(num_points);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_points; i++) {
+        uint64_t key = 0;
+        if (use_keys) {
+            for (int c = 0; c < 3; c++) {
+                key = key * dims[c] +
+                      uint64_t(int64_t(voxel_indices[i](c)) - min_index(c));
             }
         }
-        return Eigen::Vector3d(max_class, max_class, max_class);
+        keyed_points[i] = std::make_pair(key, i);
+    }
+    if (use_keys) {
+        utility::ParallelSort(keyed_points.begin(), keyed_points.end());
+    } else {
+        utility::ParallelSort(
+                keyed_points.begin(), keyed_points.end(),
+                [&](const std::pair<uint64_t, int> &a,
+                    const std::pair<uint64_t, int> &b) {
+                    const Eigen::Vector3i &index_a = voxel_indices[a.second];
+                    const Eigen::Vector3i &index_b = voxel_indices[b.second];
+                    if (index_a != index_b) {
+                        return std::lexicographical_compare(
+                                index_a.data(), index_a.data() + 3,
+                                index_b.data(), index_b.data() + 3);
+                    }
+                    return a.second < b.second;
+                });
     }
 
-    std::vector<point_cubic_id> GetOriginalID() { return original_id; }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_points; i++) {
+        order[i] = keyed_points[i].second;
+    }
+    for (int i = 1; i < num_points; i++) {
+        if (voxel_indices[order[i]] != voxel_indices[order[i - 1]]) {
+            voxel_begins.push_back(i);
+        }
+    }
+    voxel_begins.push_back(num_points);
+}
 
-private:
-    // original point cloud id in higher resolution + its cubic id
-    std::vector<point_cubic_id> original_id;
-    std::unordered_map<int, int> classes;
-};
 }  // namespace
 
 std::shared_ptr<PointCloud> PointCloud::VoxelDownSample(
@@ -305,33 +442,42 @@ std::shared_ptr<PointCloud> PointCloud::VoxelDownSample(
     }
     Eigen::Vector3d voxel_size3 =
             Eigen::Vector3d(voxel_size, voxel_size, voxel_size);
-    Eigen::Vector3d voxel_min_bound = GetMinBound() - voxel_size3 * 0.5;
-    Eigen::Vector3d voxel_max_bound = GetMaxBound() + voxel_size3 * 0.5;
+    const AxisAlignedBoundingBox box = GetAxisAlignedBoundingBox();
+    Eigen::Vector3d voxel_min_bound = box.min_bound_ - voxel_size3 * 0.5;
+    Eigen::Vector3d voxel_max_bound = box.max_bound_ + voxel_size3 * 0.5;
     if (voxel_size * std::numeric_limits<int>::max() <
         (voxel_max_bound - voxel_min_bound).maxCoeff()) {
         utility::LogError("[VoxelDownSample] voxel_size is too small.");
     }
-    std::unordered_map<Eigen::Vector3i, AccumulatedPoint,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxelindex_to_accpoint;
+    std::vector<int> order;
+    std::vector<int> voxel_begins;
+    GroupPointsByVoxel(points_, voxel_min_bound, voxel_size, order,
+                       voxel_begins);
 
-    Eigen::Vector3d ref_coord;
-    Eigen::Vector3i voxel_index;
-    for (int i = 0; i < (int)points_.size(); i++) {
-        ref_coord = (points_[i] - voxel_min_bound) / voxel_size;
-        voxel_index << int(floor(ref_coord(0))), int(floor(ref_coord(1))),
-                int(floor(ref_coord(2)));
-        voxelindex_to_accpoint[voxel_index].AddPoint(*this, i);
-    }
+    const int num_voxels = (int)voxel_begins.size() - 1;
     bool has_normals = HasNormals();
     bool has_colors = HasColors();
-    for (auto accpoint : voxelindex_to_accpoint) {
-        output->points_.push_back(accpoint.second.GetAveragePoint());
+    output->points_.resize(num_voxels);
+    if (has_normals) {
+        output->normals_.resize(num_voxels);
+    }
+    if (has_colors) {
+        output->colors_.resize(num_voxels);
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < num_voxels; v++) {
+        AccumulatedPoint accpoint;
+        for (int j = voxel_begins[v]; j < voxel_begins[v + 1]; j++) {
+            accpoint.AddPoint(*this, order[j]);
+        }
+        output->points_[v] = accpoint.GetAveragePoint();
         if (has_normals) {
-            output->normals_.push_back(accpoint.second.GetAverageNormal());
+            output->normals_[v] = accpoint.GetAverageNormal();
         }
         if (has_colors) {
-            output->colors_.push_back(accpoint.second.GetAverageColor());
+            output->colors_[v] = accpoint.GetAverageColor();
         }
     }
     utility::LogDebug(
@@ -360,51 +506,73 @@ PointCloud::VoxelDownSampleAndTrace(double voxel_size,
         (voxel_max_bound - voxel_min_bound).maxCoeff()) {
         utility::LogError("[VoxelDownSample] voxel_size is too small.");
     }
-    std::unordered_map<Eigen::Vector3i, AccumulatedPointForTrace,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            voxelindex_to_accpoint;
-    int cid_temp[3] = {1, 2, 4};
-    for (size_t i = 0; i < points_.size(); i++) {
-        auto ref_coord = (points_[i] - voxel_min_bound) / voxel_size;
-        auto voxel_index = Eigen::Vector3i(int(floor(ref_coord(0))),
-                                           int(floor(ref_coord(1))),
-                                           int(floor(ref_coord(2))));
-        int cid = 0;
-        for (int c = 0; c < 3; c++) {
-            if ((ref_coord(c) - voxel_index(c)) >= 0.5) {
-                cid += cid_temp[c];
-            }
-        }
-        voxelindex_to_accpoint[voxel_index].AddPoint(*this, i, cid,
-                                                     approximate_class);
-    }
+    std::vector<int> order;
+    std::vector<int> voxel_begins;
+    GroupPointsByVoxel(points_, voxel_min_bound, voxel_size, order,
+                       voxel_begins);
+
+    const int num_voxels = (int)voxel_begins.size() - 1;
     bool has_normals = HasNormals();
     bool has_colors = HasColors();
-    int cnt = 0;
-    cubic_id.resize(voxelindex_to_accpoint.size(), 8);
+    output->points_.resize(num_voxels);
+    if (has_normals) {
+        output->normals_.resize(num_voxels);
+    }
+    if (has_colors) {
+        output->colors_.resize(num_voxels);
+    }
+    cubic_id.resize(num_voxels, 8);
     cubic_id.setConstant(-1);
-    std::vector<std::vector<int>> original_indices(
-            voxelindex_to_accpoint.size());
-    for (auto accpoint : voxelindex_to_accpoint) {
-        output->points_.push_back(accpoint.second.GetAveragePoint());
+    std::vector<std::vector<int>> original_indices(num_voxels);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int v = 0; v < num_voxels; v++) {
+        AccumulatedPoint accpoint;
+        // Number of points of each class, the class is the first color
+        // channel.
+        std::unordered_map<int, int> classes;
+        original_indices[v].reserve(voxel_begins[v + 1] - voxel_begins[v]);
+        for (int j = voxel_begins[v]; j < voxel_begins[v + 1]; j++) {
+            const int i = order[j];
+            accpoint.AddPoint(*this, i);
+            if (has_colors && approximate_class) {
+                classes[int(colors_[i](0))]++;
+            }
+            // The sub-voxel octant of the point.
+            const Eigen::Vector3d ref_coord =
+                    (points_[i] - voxel_min_bound) / voxel_size;
+            int cid = 0;
+            for (int c = 0; c < 3; c++) {
+                if (ref_coord(c) - floor(ref_coord(c)) >= 0.5) {
+                    cid += 1 << c;
+                }
+            }
+            cubic_id(v, cid) = i;
+            original_indices[v].push_back(i);
+        }
+        output->points_[v] = accpoint.GetAveragePoint();
         if (has_normals) {
-            output->normals_.push_back(accpoint.second.GetAverageNormal());
+            output->normals_[v] = accpoint.GetAverageNormal();
         }
         if (has_colors) {
             if (approximate_class) {
-                output->colors_.push_back(accpoint.second.GetMaxClass());
+                // The most frequent class, the smallest one on ties.
+                int max_class = -1;
+                int max_count = -1;
+                for (const auto &cls : classes) {
+                    if (cls.second > max_count ||
+                        (cls.second == max_count && cls.first < max_class)) {
+                        max_count = cls.second;
+                        max_class = cls.first;
+                    }
+                }
+                output->colors_[v] =
+                        Eigen::Vector3d(max_class, max_class, max_class);
             } else {
-                output->colors_.push_back(accpoint.second.GetAverageColor());
+                output->colors_[v] = accpoint.GetAverageColor();
             }
         }
-        auto original_id = accpoint.second.GetOriginalID();
-        for (int i = 0; i < (int)original_id.size(); i++) {
-            size_t pid = original_id[i].point_id;
-            int cid = original_id[i].cubic_id;
-            cubic_id(cnt, cid) = int(pid);
-            original_indices[cnt].push_back(int(pid));
-        }
-        cnt++;
     }
     utility::LogDebug(
             "Pointcloud down sampled from {:d} points to {:d} points.",
@@ -424,6 +592,307 @@ std::shared_ptr<PointCloud> PointCloud::UniformDownSample(
     return SelectByIndex(indices);
 }
 
+std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
+PointCloud::RandomDownSample(size_t num_samples,
+                             unsigned int seed /* = 0 */) const {
+    if (num_samples > points_.size()) {
+        utility::LogError(
+                "[RandomDownSample] num_samples {:d} exceeds the number of "
+                "points {:d}.",
+                num_samples, points_.size());
+    }
+    // Floyd's algorithm draws a uniform subset with exactly num_samples
+    // random numbers, and the mask keeps the selection in point order.
+    std::mt19937 random_engine(seed);
+    std::vector<char> mask(points_.size(), 0);
+    for (size_t j = points_.size() - num_samples; j < points_.size(); j++) {
+        std::uniform_int_distribution<size_t> distribution(0, j);
+        const size_t t = distribution(random_engine);
+        mask[mask[t] ? j : t] = 1;
+    }
+    auto output = SelectByMask(*this, mask, nullptr);
+    utility::LogDebug(
+            "Pointcloud down sampled from {:d} points to {:d} points.",
+            (int)points_.size(), (int)output->points_.size());
+    return std::make_tuple(output, kernel::MaskToIndices(mask));
+}
+
+namespace {
+
+/// Number of points per bucket of FarthestPointDownSample.
+constexpr int64_t kFarthestPointBucketSize = 256;
+/// Number of buckets per group of FarthestPointDownSample.
+constexpr int64_t kFarthestPointGroupSize = 64;
+/// Bits per axis of the voxel grid of FarthestPointDownSample.
+constexpr int kMortonBits = 11;
+
+/// Bounding box of a range of points and its point farthest from the
+/// samples of FarthestPointDownSample.
+struct FarthestPointRange {
+    /// Whether \p sample is closer to the box than the farthest point, in
+    /// which case it may lower the distances of the range.
+    bool IsCloser(const Eigen::Vector3d &sample) const {
+        const double box_distance2 = (min_bound_ - sample)
+                                             .cwiseMax(sample - max_bound_)
+                                             .cwiseMax(Eigen::Vector3d::Zero())
+                                             .squaredNorm();
+        return box_distance2 < max_distance2_;
+    }
+
+    Eigen::Vector3d min_bound_;
+    Eigen::Vector3d max_bound_;
+    double max_distance2_;
+    int64_t farthest_;
+};
+
+/// Makes point \p i at squared distance \p distance2 the \p farthest one
+/// if it is farther away, ties going to the smaller index in \p order.
+void UpdateFarthest(double distance2,
+                    int64_t i,
+                    const std::vector<int64_t> &order,
+                    double &max_distance2,
+                    int64_t &farthest) {
+    if (distance2 > max_distance2 ||
+        (distance2 == max_distance2 && order[i] < order[farthest])) {
+        max_distance2 = distance2;
+        farthest = i;
+    }
+}
+
+/// Copies the points of \p cloud at \p indices, in the order of \p indices,
+/// together with their attributes into a new pointcloud.
+std::shared_ptr<PointCloud> SelectInOrder(const PointCloud &cloud,
+                                          const std::vector<size_t> &indices) {
+    auto output = std::make_shared<PointCloud>();
+    const bool has_normals = cloud.HasNormals();
+    const bool has_colors = cloud.HasColors();
+    const bool has_covariances = cloud.HasCovariances();
+    output->points_.resize(indices.size());
+    if (has_normals) output->normals_.resize(indices.size());
+    if (has_colors) output->colors_.resize(indices.size());
+    if (has_covariances) output->covariances_.resize(indices.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t j = 0; j < int64_t(indices.size()); j++) {
+        const size_t i = indices[j];
+        output->points_[j] = cloud.points_[i];
+        if (has_normals) output->normals_[j] = cloud.normals_[i];
+        if (has_colors) output->colors_[j] = cloud.colors_[i];
+        if (has_covariances) output->covariances_[j] = cloud.covariances_[i];
+    }
+    return output;
+}
+
+/// Spreads the lowest 21 bits of \p v apart by two zero bits each, so that
+/// three spread coordinates interleave into a Morton code.
+uint64_t SpreadBits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffff;
+    v = (v | v << 16) & 0x1f0000ff0000ff;
+    v = (v | v << 8) & 0x100f00f00f00f00f;
+    v = (v | v << 4) & 0x10c30c30c30c30c3;
+    v = (v | v << 2) & 0x1249249249249249;
+    return v;
+}
+
+/// Sorts \p keyed_points by the lowest \p num_bits bits of their keys with
+/// a least significant digit radix sort. The sort is stable, so points with
+/// equal keys keep their order.
+void RadixSort(std::vector<std::pair<uint64_t, int64_t>> &keyed_points,
+               int num_bits) {
+    const int digit_bits = 11;
+    const uint64_t digit_mask = (uint64_t(1) << digit_bits) - 1;
+    std::vector<std::pair<uint64_t, int64_t>> buffer(keyed_points.size());
+    std::vector<size_t> offsets(size_t(1) << digit_bits);
+    for (int shift = 0; shift < num_bits; shift += digit_bits) {
+        std::fill(offsets.begin(), offsets.end(), 0);
+        for (const auto &keyed_point : keyed_points) {
+            offsets[(keyed_point.first >> shift) & digit_mask]++;
+        }
+        size_t offset = 0;
+        for (size_t &count : offsets) {
+            const size_t begin = offset;
+            offset += count;
+            count = begin;
+        }
+        for (const auto &keyed_point : keyed_points) {
+            buffer[offsets[(keyed_point.first >> shift) & digit_mask]++] =
+                    keyed_point;
+        }
+        keyed_points.swap(buffer);
+    }
+}
+
+}  // unnamed namespace
+
+std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
+PointCloud::FarthestPointDownSample(size_t num_samples,
+                                    size_t start_index /* = 0 */) const {
+    if (num_samples > points_.size()) {
+        utility::LogError(
+                "[FarthestPointDownSample] num_samples {:d} exceeds the "
+                "number of points {:d}.",
+                num_samples, points_.size());
+    }
+    std::vector<size_t> indices;
+    if (num_samples == 0) {
+        return std::make_tuple(std::make_shared<PointCloud>(), indices);
+    }
+    if (start_index >= points_.size()) {
+        utility::LogError(
+                "[FarthestPointDownSample] start_index {:d} is out of range.",
+                start_index);
+    }
+
+    // Group the points into compact buckets with bounding boxes. A new
+    // sample can only lower the distances in a bucket if its box is closer
+    // than the farthest point of the bucket, so most buckets are skipped once
+    // the samples cover the cloud.
+    const int64_t num_points = int64_t(points_.size());
+    Eigen::Vector3d min_bound, max_bound;
+    kernel::ComputeBounds(points_, min_bound, max_bound);
+    const double num_cells = double((1 << kMortonBits) - 1);
+    Eigen::Vector3d cell_scale;
+    for (int k = 0; k < 3; k++) {
+        const double extent = max_bound(k) - min_bound(k);
+        cell_scale(k) = extent > 0.0 ? num_cells / extent : 0.0;
+    }
+    // Order the points along a Morton curve over a voxel grid and cut the
+    // curve into buckets of equal size, which adapts the buckets to the
+    // density of the points.
+    std::vector<std::pair<uint64_t, int64_t>> keyed_points(num_points);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_points; i++) {
+        const Eigen::Vector3d cell =
+                (points_[i] - min_bound).cwiseProduct(cell_scale);
+        keyed_points[i].first = SpreadBits(uint64_t(cell(0))) |
+                                SpreadBits(uint64_t(cell(1))) << 1 |
+                                SpreadBits(uint64_t(cell(2))) << 2;
+        keyed_points[i].second = i;
+    }
+    RadixSort(keyed_points, 3 * kMortonBits);
+
+    // Every group of buckets gets a bounding box as well, so that far away
+    // groups are skipped with a single test.
+    const int64_t bucket_size = kFarthestPointBucketSize;
+    const int64_t group_size = kFarthestPointGroupSize;
+    const int64_t num_buckets = (num_points + bucket_size - 1) / bucket_size;
+    const int64_t num_groups = (num_buckets + group_size - 1) / group_size;
+    const double inf = std::numeric_limits<double>::infinity();
+    std::vector<Eigen::Vector3d> sorted_points(num_points);
+    std::vector<int64_t> order(num_points);
+    std::vector<FarthestPointRange> buckets(num_buckets);
+    std::vector<FarthestPointRange> groups(num_groups);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t b = 0; b < num_buckets; b++) {
+        const int64_t begin = b * bucket_size;
+        const int64_t end = (std::min)(begin + bucket_size, num_points);
+        FarthestPointRange &bucket = buckets[b];
+        bucket.min_bound_ = points_[keyed_points[begin].second];
+        bucket.max_bound_ = bucket.min_bound_;
+        for (int64_t i = begin; i < end; i++) {
+            order[i] = keyed_points[i].second;
+            sorted_points[i] = points_[order[i]];
+            bucket.min_bound_ = bucket.min_bound_.cwiseMin(sorted_points[i]);
+            bucket.max_bound_ = bucket.max_bound_.cwiseMax(sorted_points[i]);
+        }
+        bucket.max_distance2_ = inf;
+        bucket.farthest_ = begin;
+    }
+    std::vector<std::pair<uint64_t, int64_t>>().swap(keyed_points);
+    for (int64_t g = 0; g < num_groups; g++) {
+        const int64_t begin = g * group_size;
+        const int64_t end = (std::min)(begin + group_size, num_buckets);
+        FarthestPointRange &group = groups[g];
+        group = buckets[begin];
+        for (int64_t b = begin + 1; b < end; b++) {
+            group.min_bound_ = group.min_bound_.cwiseMin(buckets[b].min_bound_);
+            group.max_bound_ = group.max_bound_.cwiseMax(buckets[b].max_bound_);
+        }
+    }
+
+    // Squared distance of every point to the selected samples, -1 once the
+    // point itself is selected.
+    std::vector<double> distance2(num_points, inf);
+    indices.reserve(num_samples);
+    int64_t sample =
+            std::find(order.begin(), order.end(), int64_t(start_index)) -
+            order.begin();
+    while (true) {
+        indices.push_back(size_t(order[sample]));
+        distance2[sample] = -1.0;
+        if (indices.size() == num_samples) {
+            break;
+        }
+        const Eigen::Vector3d s = sorted_points[sample];
+        const int64_t sample_bucket = sample / bucket_size;
+        const int64_t sample_group = sample_bucket / group_size;
+        double best_distance2 = -inf;
+        int64_t best_sample = -1;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+        {
+            double local_distance2 = -inf;
+            int64_t local_sample = -1;
+#ifdef _OPENMP
+#pragma omp for schedule(static) nowait
+#endif
+            for (int64_t g = 0; g < num_groups; g++) {
+                FarthestPointRange &group = groups[g];
+                if (g == sample_group || group.IsCloser(s)) {
+                    group.max_distance2_ = -inf;
+                    const int64_t bucket_end =
+                            (std::min)((g + 1) * group_size, num_buckets);
+                    for (int64_t b = g * group_size; b < bucket_end; b++) {
+                        FarthestPointRange &bucket = buckets[b];
+                        if (b == sample_bucket || bucket.IsCloser(s)) {
+                            bucket.max_distance2_ = -inf;
+                            const int64_t end = (std::min)(
+                                    (b + 1) * bucket_size, num_points);
+                            for (int64_t i = b * bucket_size; i < end; i++) {
+                                const double d = (std::min)(
+                                        distance2[i],
+                                        (sorted_points[i] - s).squaredNorm());
+                                distance2[i] = d;
+                                UpdateFarthest(d, i, order,
+                                               bucket.max_distance2_,
+                                               bucket.farthest_);
+                            }
+                        }
+                        UpdateFarthest(bucket.max_distance2_, bucket.farthest_,
+                                       order, group.max_distance2_,
+                                       group.farthest_);
+                    }
+                }
+                UpdateFarthest(group.max_distance2_, group.farthest_, order,
+                               local_distance2, local_sample);
+            }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+            {
+                if (local_sample >= 0) {
+                    UpdateFarthest(local_distance2, local_sample, order,
+                                   best_distance2, best_sample);
+                }
+            }
+        }
+        sample = best_sample;
+    }
+
+    auto output = SelectInOrder(*this, indices);
+    utility::LogDebug(
+            "Pointcloud down sampled from {:d} points to {:d} points.",
+            (int)points_.size(), (int)output->points_.size());
+    return std::make_tuple(output, indices);
+}
+
 std::shared_ptr<PointCloud> PointCloud::Crop(
         const AxisAlignedBoundingBox &bbox) const {
     if (bbox.IsEmpty()) {
@@ -431,7 +900,10 @@ std::shared_ptr<PointCloud> PointCloud::Crop(
                 "[CropPointCloud] AxisAlignedBoundingBox either has zeros "
                 "size, or has wrong bounds.");
     }
-    return SelectByIndex(bbox.GetPointIndicesWithinBoundingBox(points_));
+    std::vector<char> mask;
+    kernel::ComputeMaskInAxisAlignedBox(points_, bbox.min_bound_,
+                                        bbox.max_bound_, mask);
+    return SelectByMask(*this, mask, nullptr);
 }
 std::shared_ptr<PointCloud> PointCloud::Crop(
         const OrientedBoundingBox &bbox) const {
@@ -440,7 +912,38 @@ std::shared_ptr<PointCloud> PointCloud::Crop(
                 "[CropPointCloud] AxisAlignedBoundingBox either has zeros "
                 "size, or has wrong bounds.");
     }
-    return SelectByIndex(bbox.GetPointIndicesWithinBoundingBox(points_));
+    std::vector<char> mask;
+    kernel::ComputeMaskInOrientedBox(points_, bbox.center_, bbox.R_,
+                                     bbox.extent_, mask);
+    return SelectByMask(*this, mask, nullptr);
+}
+
+std::shared_ptr<PointCloud> PointCloud::CropAndTransform(
+        const AxisAlignedBoundingBox &bbox,
+        const Eigen::Matrix4d &transformation) const {
+    if (bbox.IsEmpty()) {
+        utility::LogError(
+                "[CropAndTransform] AxisAlignedBoundingBox either has zeros "
+                "size, or has wrong bounds.");
+    }
+    std::vector<char> mask;
+    kernel::ComputeMaskInAxisAlignedBox(points_, bbox.min_bound_,
+                                        bbox.max_bound_, mask);
+    return SelectByMask(*this, mask, &transformation);
+}
+
+std::shared_ptr<PointCloud> PointCloud::CropAndTransform(
+        const OrientedBoundingBox &bbox,
+        const Eigen::Matrix4d &transformation) const {
+    if (bbox.IsEmpty()) {
+        utility::LogError(
+                "[CropAndTransform] OrientedBoundingBox either has zeros "
+                "size, or has wrong bounds.");
+    }
+    std::vector<char> mask;
+    kernel::ComputeMaskInOrientedBox(points_, bbox.center_, bbox.R_,
+                                     bbox.extent_, mask);
+    return SelectByMask(*this, mask, &transformation);
 }
 
 std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
@@ -452,20 +955,18 @@ PointCloud::RemoveRadiusOutliers(size_t nb_points, double search_radius) const {
     }
     KDTreeFlann kdtree;
     kdtree.SetGeometry(*this);
-    std::vector<bool> mask = std::vector<bool>(points_.size());
-#ifdef _OPENMP
-#pragma omp parallel for schedule(static)
-#endif
-    for (int i = 0; i < int(points_.size()); i++) {
-        std::vector<int> tmp_indices;
-        std::vector<double> dist;
-        size_t nb_neighbors = kdtree.SearchRadius(points_[i], search_radius,
-                                                  tmp_indices, dist);
-        mask[i] = (nb_neighbors > nb_points);
-    }
+    // Only whether a point has more than nb_points neighbors matters, so the
+    // search stops after nb_points + 1 neighbors.
+    std::vector<int> tmp_indices;
+    std::vector<double> dist;
+    std::vector<int> nb_neighbors;
     std::vector<size_t> indices;
-    for (size_t i = 0; i < mask.size(); i++) {
-        if (mask[i]) {
+    if (kdtree.BatchSearchHybrid(points_, search_radius, int(nb_points) + 1,
+                                 tmp_indices, dist, nb_neighbors) < 0) {
+        return std::make_tuple(SelectByIndex(indices), indices);
+    }
+    for (size_t i = 0; i < nb_neighbors.size(); i++) {
+        if (size_t(nb_neighbors[i]) > nb_points) {
             indices.push_back(i);
         }
     }
@@ -488,23 +989,31 @@ PointCloud::RemoveStatisticalOutliers(size_t nb_neighbors,
     kdtree.SetGeometry(*this);
     std::vector<double> avg_distances = std::vector<double>(points_.size());
     std::vector<size_t> indices;
-    size_t valid_distances = 0;
+    std::vector<int> tmp_indices;
+    std::vector<double> dist;
+    if (kdtree.BatchSearchKNN(points_, int(nb_neighbors), tmp_indices,
+                              dist) < 0) {
+        utility::LogWarning(
+                "[RemoveStatisticalOutliers] Neighbor search failed.");
+        return std::make_tuple(std::make_shared<PointCloud>(),
+                               std::vector<size_t>());
+    }
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < int(points_.size()); i++) {
-        std::vector<int> tmp_indices;
-        std::vector<double> dist;
-        kdtree.SearchKNN(points_[i], int(nb_neighbors), tmp_indices, dist);
-        double mean = -1.0;
-        if (dist.size() > 0u) {
-            valid_distances++;
-            std::for_each(dist.begin(), dist.end(),
-                          [](double &d) { d = std::sqrt(d); });
-            mean = std::accumulate(dist.begin(), dist.end(), 0.0) / dist.size();
+        double sum = 0.0;
+        size_t count = 0;
+        for (size_t k = i * nb_neighbors; k < (i + 1) * nb_neighbors; k++) {
+            if (tmp_indices[k] < 0) break;
+            sum += std::sqrt(dist[k]);
+            count++;
         }
-        avg_distances[i] = mean;
+        avg_distances[i] = count > 0 ? sum / count : -1.0;
     }
+    size_t valid_distances = std::count_if(
+            avg_distances.begin(), avg_distances.end(),
+            [](double const &x) { return x >= 0.0; });
     if (valid_distances == 0) {
         return std::make_tuple(std::make_shared<PointCloud>(),
                                std::vector<size_t>());
@@ -584,21 +1093,24 @@ std::vector<double> PointCloud::ComputeMahalanobisDistance() const {
 }
 
 std::vector<double> PointCloud::ComputeNearestNeighborDistance() const {
-    std::vector<double> nn_dis(points_.size());
+    std::vector<double> nn_dis(points_.size(), 0.0);
     KDTreeFlann kdtree(*this);
+    std::vector<int> indices;
+    std::vector<double> dists;
+    if (kdtree.BatchSearchKNN(points_, 2, indices, dists) < 0) {
+        return nn_dis;
+    }
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)points_.size(); i++) {
-        std::vector<int> indices(2);
-        std::vector<double> dists(2);
-        if (kdtree.SearchKNN(points_[i], 2, indices, dists) <= 1) {
+        if (indices[2 * i + 1] < 0) {
             utility::LogDebug(
                     "[ComputePointCloudNearestNeighborDistance] Found a point "
                     "without neighbors.");
             nn_dis[i] = 0.0;
         } else {
-            nn_dis[i] = std::sqrt(dists[1]);
+            nn_dis[i] = std::sqrt(dists[2 * i + 1]);
         }
     }
     return nn_dis;
@@ -32,6 +32,7 @@
 #include <vector>
 
 #include "Open3D/Geometry/Geometry3D.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/KDTreeSearchParam.h"
 
 namespace open3d {
@@ -50,7 +51,7 @@ class VoxelGrid;
 /// \class PointCloud
 ///
 /// \brief A point cloud consists of point coordinates, and optionally point
-/// colors and point normals.
+/// colors, point normals and point covariances.
 class PointCloud : public Geometry3D {
 public:
     /// \brief Default Constructor.
@@ -92,14 +93,14 @@ public:
         return points_.size() > 0 && colors_.size() == points_.size();
     }
 
-    /// Normalize point normals to length 1.
-    PointCloud &NormalizeNormals() {
-        for (size_t i = 0; i < normals_.size(); i++) {
-            normals_[i].normalize();
-        }
-        return *this;
+    /// Returns `true` if the point cloud contains point covariances.
+    bool HasCovariances() const {
+        return points_.size() > 0 && covariances_.size() == points_.size();
     }
 
+    /// Normalize point normals to length 1.
+    PointCloud &NormalizeNormals();
+
     /// Assigns each point in the PointCloud the same color.
     ///
     /// \param color  RGB colors of points.
@@ -111,7 +112,7 @@ public:
     /// \brief Remove all points fromt he point cloud that have a nan entry, or
     /// infinite entries.
     ///
-    /// Also removes the corresponding normals and color entries.
+    /// Also removes the corresponding normals, color and covariance entries.
     ///
     /// \param remove_nan Remove NaN values from the PointCloud.
     /// \param remove_infinite Remove infinite values from the PointCloud.
@@ -163,6 +164,35 @@ public:
     /// 2k, …].
     std::shared_ptr<PointCloud> UniformDownSample(size_t every_k_points) const;
 
+    /// \brief Function to downsample input pointcloud into output pointcloud
+    /// with a random subset of points.
+    ///
+    /// The same \p seed always selects the same points. The selected points
+    /// keep their original order.
+    ///
+    /// \param num_samples Number of points to select, at most the number of
+    /// points.
+    /// \param seed Seed of the random number generator.
+    /// \return Tuple of the downsampled pointcloud and the indices of the
+    /// selected points.
+    std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
+    RandomDownSample(size_t num_samples, unsigned int seed = 0) const;
+
+    /// \brief Function to downsample input pointcloud into output pointcloud
+    /// with farthest point sampling.
+    ///
+    /// Starting from \p start_index, each selected point is the one farthest
+    /// from all the points selected before it, ties going to the smallest
+    /// index. This covers the pointcloud evenly with a fixed number of points.
+    ///
+    /// \param num_samples Number of points to select, at most the number of
+    /// points.
+    /// \param start_index Index of the first selected point.
+    /// \return Tuple of the downsampled pointcloud and the indices of the
+    /// selected points, both in the order of selection.
+    std::tuple<std::shared_ptr<PointCloud>, std::vector<size_t>>
+    FarthestPointDownSample(size_t num_samples, size_t start_index = 0) const;
+
     /// \brief Function to crop pointcloud into output pointcloud
     ///
     /// All points with coordinates outside the bounding box \p bbox are
@@ -179,6 +209,30 @@ public:
     /// \param bbox OrientedBoundingBox to crop points.
     std::shared_ptr<PointCloud> Crop(const OrientedBoundingBox &bbox) const;
 
+    /// \brief Function to crop pointcloud and transform the remaining points.
+    ///
+    /// Equivalent to Crop(\p bbox) followed by Transform(\p transformation)
+    /// on the result, but done in a single pass over the selected points.
+    ///
+    /// \param bbox AxisAlignedBoundingBox to crop points, in the coordinates
+    /// before the transformation.
+    /// \param transformation 4x4 matrix applied to the cropped pointcloud.
+    std::shared_ptr<PointCloud> CropAndTransform(
+            const AxisAlignedBoundingBox &bbox,
+            const Eigen::Matrix4d &transformation) const;
+
+    /// \brief Function to crop pointcloud and transform the remaining points.
+    ///
+    /// Equivalent to Crop(\p bbox) followed by Transform(\p transformation)
+    /// on the result, but done in a single pass over the selected points.
+    ///
+    /// \param bbox OrientedBoundingBox to crop points, in the coordinates
+    /// before the transformation.
+    /// \param transformation 4x4 matrix applied to the cropped pointcloud.
+    std::shared_ptr<PointCloud> CropAndTransform(
+            const OrientedBoundingBox &bbox,
+            const Eigen::Matrix4d &transformation) const;
+
     /// \brief Function to remove points that have less than \p nb_points in a
     /// sphere of a given radius.
     ///
@@ -204,9 +258,26 @@ public:
     /// search. \param fast_normal_computation If true, the normal estiamtion
     /// uses a non-iterative method to extract the eigenvector from the
     /// covariance matrix. This is faster, but is not as numerical stable.
+    /// \param precision Precision of the KDTree used for the neighborhood
+    /// search. Float32 is faster and usually accurate enough for normals.
     bool EstimateNormals(
             const KDTreeSearchParam &search_param = KDTreeSearchParamKNN(),
-            bool fast_normal_computation = true);
+            bool fast_normal_computation = true,
+            KDTreeFlann::Precision precision = KDTreeFlann::Precision::Float64);
+
+    /// \brief Function to compute the covariance matrix of each point from its
+    /// neighborhood.
+    ///
+    /// The neighborhoods are gathered exactly as in EstimateNormals(), so both
+    /// functions called with the same \p search_param describe the same local
+    /// surface. Points with fewer than 3 neighbors get an identity covariance.
+    /// The result is stored in covariances_ and follows the points through
+    /// Transform(), Rotate(), SelectByIndex() and operator+=().
+    ///
+    /// \param search_param The KDTree search parameters for neighborhood
+    /// search.
+    bool EstimateCovariances(
+            const KDTreeSearchParam &search_param = KDTreeSearchParamKNN());
 
     /// \brief Function to orient the normals of a point cloud.
     ///
@@ -285,13 +356,45 @@ public:
     /// model, and still be considered an inlier.
     /// \param ransac_n Number of initial points to be considered inliers in
     /// each iteration.
-    /// \param num_iterations Number of iterations.
+    /// \param num_iterations Maximum number of iterations.
+    /// \param probability Stop once a sample of inliers only has been drawn
+    /// with this probability, given the fitness of the best plane so far.
+    /// \param seed Seed of the random number generator. The same seed gives
+    /// the same plane for any number of threads.
     /// \return Returns the plane model ax + by + cz + d = 0 and the indices of
     /// the plane inliers.
     std::tuple<Eigen::Vector4d, std::vector<size_t>> SegmentPlane(
             const double distance_threshold = 0.01,
             const int ransac_n = 3,
-            const int num_iterations = 100) const;
+            const int num_iterations = 100,
+            const double probability = 0.99999999,
+            unsigned int seed = 0) const;
+
+    /// \brief Segment up to \p num_planes planes, by running RANSAC on the
+    /// points that do not belong to the planes found so far.
+    ///
+    /// \param num_planes Maximum number of planes.
+    /// \param distance_threshold Max distance a point can be from the plane
+    /// model, and still be considered an inlier.
+    /// \param ransac_n Number of initial points to be considered inliers in
+    /// each iteration.
+    /// \param num_iterations Maximum number of iterations per plane.
+    /// \param min_num_inliers The segmentation stops at the first plane with
+    /// fewer inliers.
+    /// \param probability Stop once a sample of inliers only has been drawn
+    /// with this probability, given the fitness of the best plane so far.
+    /// \param seed Seed of the random number generator. The same seed gives
+    /// the same planes for any number of threads.
+    /// \return Returns the plane models ax + by + cz + d = 0, in the order
+    /// they were found, and the indices of the inliers of each plane.
+    std::tuple<std::vector<Eigen::Vector4d>, std::vector<std::vector<size_t>>>
+    SegmentPlanes(const int num_planes,
+                  const double distance_threshold = 0.01,
+                  const int ransac_n = 3,
+                  const int num_iterations = 100,
+                  const size_t min_num_inliers = 3,
+                  const double probability = 0.99999999,
+                  unsigned int seed = 0) const;
 
     /// \brief Factory function to create a pointcloud from a depth image and a
     /// camera model.
@@ -359,6 +462,8 @@ public:
     std::vector<Eigen::Vector3d> normals_;
     /// Points coordinates.
     std::vector<Eigen::Vector3d> colors_;
+    /// Points covariances.
+    std::vector<Eigen::Matrix3d> covariances_;
 };
 
 }  // namespace geometry
@@ -27,7 +27,10 @@
 #include "Open3D/Geometry/PointCloud.h"
 
 #include <Eigen/Dense>
-#include <unordered_set>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Utility/Console.h"
@@ -39,78 +42,174 @@
 namespace open3d {
 namespace geometry {
 
+namespace {
+
+/// \class ConcurrentUnionFind
+///
+/// \brief Disjoint sets over 0, ..., size - 1, whose Find() and Union() may
+/// run concurrently.
+///
+/// Roots are only ever linked below smaller roots with a compare-and-swap, so
+/// the root of a set is its smallest element and parents never increase.
+class ConcurrentUnionFind {
+public:
+    explicit ConcurrentUnionFind(int size)
+        : parents_(new std::atomic<int>[size]) {
+        for (int i = 0; i < size; i++) {
+            parents_[i].store(i, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    /// Returns the root of the set of \p x, halving the path to it.
+    int Find(int x) {
+        while (true) {
+            int parent = parents_[x].load();
+            if (parent == x) {
+                return x;
+            }
+            const int grandparent = parents_[parent].load();
+            if (grandparent != parent) {
+                // Losing the race only skips the shortcut.
+                parents_[x].compare_exchange_weak(parent, grandparent);
+            }
+            x = grandparent;
+        }
+    }
+
+    /// Merges the sets of \p a and \p b.
+    void Union(int a, int b) {
+        while (true) {
+            a = Find(a);
+            b = Find(b);
+            if (a == b) {
+                return;
+            }
+            if (a > b) {
+                std::swap(a, b);
+            }
+            // Retry if another thread linked b meanwhile.
+            int expected = b;
+            if (parents_[b].compare_exchange_strong(expected, a)) {
+                return;
+            }
+        }
+    }
+
+private:
+    std::unique_ptr<std::atomic<int>[]> parents_;
+};
+
+// Calls func(idx) for idx = 0, ..., size - 1 on all threads. The indices are
+// processed in batches, between which the progress bar is advanced on one
+// thread.
+template <typename Func>
+void ParallelForWithProgress(int size,
+                             utility::ConsoleProgressBar &progress_bar,
+                             const Func &func) {
+    const int kBatchSize = 4096;
+    for (int begin = 0; begin < size; begin += kBatchSize) {
+        const int end = (std::min)(begin + kBatchSize, size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+        for (int idx = begin; idx < end; ++idx) {
+            func(idx);
+        }
+        for (int idx = begin; idx < end; ++idx) {
+            ++progress_bar;
+        }
+    }
+}
+
+}  // unnamed namespace
+
 std::vector<int> PointCloud::ClusterDBSCAN(double eps,
                                            size_t min_points,
                                            bool print_progress) const {
     KDTreeFlann kdtree(*this);
+    const int num_points = int(points_.size());
+
+    // The neighbourhood of every point is searched once, in one batch, and
+    // reused by the core test, the merge and the border assignment. The
+    // neighbours of idx are nbs[offsets[idx], offsets[idx + 1]).
+    utility::LogDebug("Find Core Points");
+    std::vector<int> offsets;
+    std::vector<int> nbs;
+    std::vector<double> dists2;
+    if (kdtree.BatchSearchRadius(points_, eps, offsets, nbs, dists2) < 0) {
+        utility::LogWarning("[ClusterDBSCAN] Neighbor search failed.");
+        return std::vector<int>(num_points, -1);
+    }
+    // Only the indices are used below.
+    std::vector<double>().swap(dists2);
 
-    // precompute all neighbours
-    utility::LogDebug("Precompute Neighbours");
-    utility::ConsoleProgressBar progress_bar(
-            points_.size(), "Precompute Neighbours", print_progress);
-    std::vector<std::vector<int>> nbs(points_.size());
+    // Core points have at least min_points neighbours, including themselves.
+    std::vector<char> is_core(num_points, 0);
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
-    for (int idx = 0; idx < int(points_.size()); ++idx) {
-        std::vector<double> dists2;
-        kdtree.SearchRadius(points_[idx], eps, nbs[idx], dists2);
-
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-        { ++progress_bar; }
+    for (int idx = 0; idx < num_points; ++idx) {
+        is_core[idx] = size_t(offsets[idx + 1] - offsets[idx]) >= min_points;
     }
-    utility::LogDebug("Done Precompute Neighbours");
+    utility::LogDebug("Done Find Core Points");
 
-    // set all labels to undefined (-2)
+    // Core points within eps of each other belong to the same cluster. Each
+    // pair is merged once, from its smaller index.
     utility::LogDebug("Compute Clusters");
-    progress_bar.reset(points_.size(), "Clustering", print_progress);
-    std::vector<int> labels(points_.size(), -2);
-    int cluster_label = 0;
-    for (size_t idx = 0; idx < points_.size(); ++idx) {
-        if (labels[idx] != -2) {  // label is not undefined
-            continue;
+    utility::ConsoleProgressBar progress_bar(num_points, "Merge Core Points",
+                                             print_progress);
+    ConcurrentUnionFind clusters(num_points);
+    ParallelForWithProgress(num_points, progress_bar, [&](int idx) {
+        if (!is_core[idx]) {
+            return;
         }
-
-        // check density
-        if (nbs[idx].size() < min_points) {
-            labels[idx] = -1;
-            continue;
+        for (int i = offsets[idx]; i < offsets[idx + 1]; ++i) {
+            const int nb = nbs[i];
+            if (nb > idx && is_core[nb]) {
+                clusters.Union(idx, nb);
+            }
         }
+    });
 
-        std::unordered_set<int> nbs_next(nbs[idx].begin(), nbs[idx].end());
-        std::unordered_set<int> nbs_visited;
-        nbs_visited.insert(int(idx));
-
-        labels[idx] = cluster_label;
-        ++progress_bar;
-        while (!nbs_next.empty()) {
-            int nb = *nbs_next.begin();
-            nbs_next.erase(nbs_next.begin());
-            nbs_visited.insert(nb);
-
-            if (labels[nb] == -1) {  // noise label
-                labels[nb] = cluster_label;
-                ++progress_bar;
-            }
-            if (labels[nb] != -2) {  // not undefined label
-                continue;
+    // Clusters are numbered in the order of their smallest core point, which
+    // is their root, as the serial algorithm does.
+    std::vector<int> labels(num_points, -1);
+    int cluster_label = 0;
+    for (int idx = 0; idx < num_points; ++idx) {
+        if (is_core[idx] && clusters.Find(idx) == idx) {
+            labels[idx] = cluster_label++;
+        }
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int idx = 0; idx < num_points; ++idx) {
+        if (is_core[idx]) {
+            // Roots already hold their label and are read by other threads.
+            const int root = clusters.Find(idx);
+            if (root != idx) {
+                labels[idx] = labels[root];
             }
-            labels[nb] = cluster_label;
-            ++progress_bar;
+        }
+    }
 
-            if (nbs[nb].size() >= min_points) {
-                for (int qnb : nbs[nb]) {
-                    if (nbs_visited.count(qnb) == 0) {
-                        nbs_next.insert(qnb);
-                    }
-                }
+    // A border point joins the first cluster, in label order, of the core
+    // points within eps; the other points are noise.
+    progress_bar.reset(num_points, "Assign Border Points", print_progress);
+    ParallelForWithProgress(num_points, progress_bar, [&](int idx) {
+        if (is_core[idx]) {
+            return;
+        }
+        int label = -1;
+        for (int i = offsets[idx]; i < offsets[idx + 1]; ++i) {
+            const int nb = nbs[i];
+            if (is_core[nb] && (label < 0 || labels[nb] < label)) {
+                label = labels[nb];
             }
         }
-
-        cluster_label++;
-    }
+        labels[idx] = label;
+    });
 
     utility::LogDebug("Done Compute Clusters: {:d}", cluster_label);
     return labels;
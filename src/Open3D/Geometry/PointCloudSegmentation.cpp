@@ -28,14 +28,20 @@
 
 #include <Eigen/Dense>
 #include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <numeric>
 #include <random>
 #include <unordered_set>
+#include <utility>
 
 #include "Open3D/Geometry/TriangleMesh.h"
 #include "Open3D/Utility/Console.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace open3d {
 namespace geometry {
 
@@ -54,27 +60,25 @@ public:
 
 // Calculates the number of inliers given a list of points and a plane model,
 // and the total distance between the inliers and the plane. These numbers are
-// then used to evaluate how well the plane model fits the given points.
+// then used to evaluate how well the plane model fits the given points. The
+// loop only counts, without branches or allocations, so that it vectorizes.
 RANSACResult EvaluateRANSACBasedOnDistance(
         const std::vector<Eigen::Vector3d> &points,
         const Eigen::Vector4d plane_model,
-        std::vector<size_t> &inliers,
-        double distance_threshold,
-        double error) {
+        double distance_threshold) {
     RANSACResult result;
-
+    size_t inlier_num = 0;
+    double error = 0;
     for (size_t idx = 0; idx < points.size(); ++idx) {
-        Eigen::Vector4d point(points[idx](0), points[idx](1), points[idx](2),
-                              1);
-        double distance = std::abs(plane_model.dot(point));
-
-        if (distance < distance_threshold) {
-            error += distance;
-            inliers.emplace_back(idx);
-        }
+        const double distance = std::abs(plane_model(0) * points[idx](0) +
+                                         plane_model(1) * points[idx](1) +
+                                         plane_model(2) * points[idx](2) +
+                                         plane_model(3));
+        const bool is_inlier = distance < distance_threshold;
+        inlier_num += is_inlier;
+        error += is_inlier ? distance : 0.0;
     }
 
-    size_t inlier_num = inliers.size();
     if (inlier_num == 0) {
         result.fitness_ = 0;
         result.inlier_rmse_ = 0;
@@ -85,6 +89,24 @@ RANSACResult EvaluateRANSACBasedOnDistance(
     return result;
 }
 
+// Returns the indices of the points closer than distance_threshold to the
+// plane, in ascending order.
+std::vector<size_t> GetPlaneInliers(const std::vector<Eigen::Vector3d> &points,
+                                    const Eigen::Vector4d &plane_model,
+                                    double distance_threshold) {
+    std::vector<size_t> inliers;
+    for (size_t idx = 0; idx < points.size(); ++idx) {
+        Eigen::Vector4d point(points[idx](0), points[idx](1), points[idx](2),
+                              1);
+        double distance = std::abs(plane_model.dot(point));
+
+        if (distance < distance_threshold) {
+            inliers.emplace_back(idx);
+        }
+    }
+    return inliers;
+}
+
 // Find the plane such that the summed squared distance from the
 // plane to all points is minimized.
 //
@@ -133,79 +155,135 @@ Eigen::Vector4d GetPlaneFromPoints(const std::vector<Eigen::Vector3d> &points,
     return Eigen::Vector4d(abc(0), abc(1), abc(2), d);
 }
 
-std::tuple<Eigen::Vector4d, std::vector<size_t>> PointCloud::SegmentPlane(
-        const double distance_threshold /* = 0.01 */,
-        const int ransac_n /* = 3 */,
-        const int num_iterations /* = 100 */) const {
-    RANSACResult result;
-    double error = 0;
+// Returns the number of iterations after which RANSAC has drawn a sample of
+// inliers only with the given probability, for a plane with the given
+// fitness, capped to num_iterations.
+int GetRequiredRANSACIterations(double fitness,
+                                int ransac_n,
+                                double probability,
+                                int num_iterations) {
+    if (fitness <= 0) {
+        return num_iterations;
+    }
+    const double required = std::log(1.0 - probability) /
+                            std::log(1.0 - std::pow(fitness, ransac_n));
+    // Also catches the NaN and infinity of probability 1.
+    if (!(required < num_iterations)) {
+        return num_iterations;
+    }
+    return int(std::ceil(required));
+}
 
-    // Initialize the plane model ax + by + cz + d = 0.
-    Eigen::Vector4d plane_model = Eigen::Vector4d(0, 0, 0, 0);
-    // Initialize the best plane model.
+// Runs RANSAC for a plane on points and returns the model with the best
+// fitness, or zero if every sample was degenerate. The hypotheses are
+// evaluated in parallel, one batch of as many hypotheses as threads at a
+// time, and the iterations stop once the best fitness so far makes more of
+// them unnecessary at the given probability. The sample of iteration i is
+// drawn from a generator seeded with (seed, i) and the stopping iteration is
+// the one of a sequential run, so that the result does not depend on the
+// number of threads.
+Eigen::Vector4d FindPlaneRANSAC(const std::vector<Eigen::Vector3d> &points,
+                                double distance_threshold,
+                                int ransac_n,
+                                int num_iterations,
+                                double probability,
+                                unsigned int seed,
+                                RANSACResult &best_result) {
     Eigen::Vector4d best_plane_model = Eigen::Vector4d(0, 0, 0, 0);
+    best_result = RANSACResult();
+    int batch_size = 1;
+#ifdef _OPENMP
+    batch_size = omp_get_max_threads();
+#endif
+    std::vector<RANSACResult> results(batch_size);
+    std::vector<Eigen::Vector4d> plane_models(batch_size);
+    int max_iterations = num_iterations;
+    for (int begin = 0; begin < max_iterations; begin += batch_size) {
+        const int end = (std::min)(begin + batch_size, max_iterations);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int itr = begin; itr < end; itr++) {
+            std::seed_seq seed_sequence{seed, (unsigned int)itr};
+            std::mt19937 rng(seed_sequence);
+            std::uniform_int_distribution<size_t> distribution(
+                    0, points.size() - 1);
+            std::vector<size_t> sample;
+            while (int(sample.size()) < ransac_n) {
+                const size_t idx = distribution(rng);
+                if (std::find(sample.begin(), sample.end(), idx) ==
+                    sample.end()) {
+                    sample.push_back(idx);
+                }
+            }
 
-    // Initialize consensus set.
-    std::vector<size_t> inliers;
-
-    size_t num_points = points_.size();
-    std::vector<size_t> indices(num_points);
-    std::iota(std::begin(indices), std::end(indices), 0);
+            // Fit model to the randomly selected points.
+            Eigen::Vector4d &plane_model = plane_models[itr - begin];
+            if (ransac_n == 3) {
+                plane_model = TriangleMesh::ComputeTrianglePlane(
+                        points[sample[0]], points[sample[1]],
+                        points[sample[2]]);
+            } else {
+                plane_model = GetPlaneFromPoints(points, sample);
+            }
+            results[itr - begin] =
+                    plane_model.isZero(0)
+                            ? RANSACResult()
+                            : EvaluateRANSACBasedOnDistance(
+                                      points, plane_model, distance_threshold);
+        }
 
-    std::random_device rd;
-    std::mt19937 rng(rd());
+        // The hypotheses are reduced in order and the ones past the stopping
+        // iteration are dropped, as a sequential run would not draw them.
+        for (int itr = begin; itr < end && itr < max_iterations; itr++) {
+            const RANSACResult &this_result = results[itr - begin];
+            if (this_result.fitness_ > best_result.fitness_ ||
+                (this_result.fitness_ == best_result.fitness_ &&
+                 this_result.inlier_rmse_ < best_result.inlier_rmse_)) {
+                best_result = this_result;
+                best_plane_model = plane_models[itr - begin];
+                max_iterations = GetRequiredRANSACIterations(
+                        best_result.fitness_, ransac_n, probability,
+                        num_iterations);
+            }
+        }
+    }
+    return best_plane_model;
+}
 
+// Checks the RANSAC parameters common to SegmentPlane and SegmentPlanes.
+void CheckRANSACParameters(size_t num_points,
+                           int ransac_n,
+                           double probability) {
     // Return if ransac_n is less than the required plane model parameters.
     if (ransac_n < 3) {
         utility::LogError(
                 "ransac_n should be set to higher than or equal to 3.");
-        return std::make_tuple(best_plane_model, inliers);
     }
     if (num_points < size_t(ransac_n)) {
         utility::LogError("There must be at least 'ransac_n' points.");
-        return std::make_tuple(best_plane_model, inliers);
     }
+    if (probability <= 0 || probability > 1) {
+        utility::LogError("probability must be in (0, 1].");
+    }
+}
 
-    for (int itr = 0; itr < num_iterations; itr++) {
-        for (int i = 0; i < ransac_n; ++i) {
-            std::swap(indices[i], indices[rng() % num_points]);
-        }
-        inliers.clear();
-        for (int idx = 0; idx < ransac_n; ++idx) {
-            inliers.emplace_back(indices[idx]);
-        }
-
-        // Fit model to num_model_parameters randomly selected points among the
-        // inliers.
-        plane_model = TriangleMesh::ComputeTrianglePlane(
-                points_[inliers[0]], points_[inliers[1]], points_[inliers[2]]);
-        if (plane_model.isZero(0)) {
-            continue;
-        }
+std::tuple<Eigen::Vector4d, std::vector<size_t>> PointCloud::SegmentPlane(
+        const double distance_threshold /* = 0.01 */,
+        const int ransac_n /* = 3 */,
+        const int num_iterations /* = 100 */,
+        const double probability /* = 0.99999999 */,
+        unsigned int seed /* = 0 */) const {
+    CheckRANSACParameters(points_.size(), ransac_n, probability);
 
-        error = 0;
-        inliers.clear();
-        auto this_result = EvaluateRANSACBasedOnDistance(
-                points_, plane_model, inliers, distance_threshold, error);
-        if (this_result.fitness_ > result.fitness_ ||
-            (this_result.fitness_ == result.fitness_ &&
-             this_result.inlier_rmse_ < result.inlier_rmse_)) {
-            result = this_result;
-            best_plane_model = plane_model;
-        }
-    }
+    RANSACResult result;
+    Eigen::Vector4d best_plane_model =
+            FindPlaneRANSAC(points_, distance_threshold, ransac_n,
+                            num_iterations, probability, seed, result);
 
     // Find the final inliers using best_plane_model.
-    inliers.clear();
-    for (size_t idx = 0; idx < points_.size(); ++idx) {
-        Eigen::Vector4d point(points_[idx](0), points_[idx](1), points_[idx](2),
-                              1);
-        double distance = std::abs(best_plane_model.dot(point));
-
-        if (distance < distance_threshold) {
-            inliers.emplace_back(idx);
-        }
-    }
+    std::vector<size_t> inliers =
+            GetPlaneInliers(points_, best_plane_model, distance_threshold);
 
     // Improve best_plane_model using the final inliers.
     best_plane_model = GetPlaneFromPoints(points_, inliers);
@@ -215,5 +293,63 @@ std::tuple<Eigen::Vector4d, std::vector<size_t>> PointCloud::SegmentPlane(
     return std::make_tuple(best_plane_model, inliers);
 }
 
+std::tuple<std::vector<Eigen::Vector4d>, std::vector<std::vector<size_t>>>
+PointCloud::SegmentPlanes(const int num_planes,
+                          const double distance_threshold /* = 0.01 */,
+                          const int ransac_n /* = 3 */,
+                          const int num_iterations /* = 100 */,
+                          const size_t min_num_inliers /* = 3 */,
+                          const double probability /* = 0.99999999 */,
+                          unsigned int seed /* = 0 */) const {
+    CheckRANSACParameters(points_.size(), ransac_n, probability);
+
+    std::vector<Eigen::Vector4d> plane_models;
+    std::vector<std::vector<size_t>> plane_inliers;
+    // The points not assigned to a plane yet, and their indices in points_.
+    // Both are compacted in place after each plane.
+    std::vector<Eigen::Vector3d> remaining_points = points_;
+    std::vector<size_t> remaining_indices(points_.size());
+    std::iota(remaining_indices.begin(), remaining_indices.end(), 0);
+
+    while (int(plane_models.size()) < num_planes &&
+           remaining_points.size() >= size_t(ransac_n)) {
+        // Each plane draws its samples from a seed of its own.
+        RANSACResult result;
+        Eigen::Vector4d plane_model = FindPlaneRANSAC(
+                remaining_points, distance_threshold, ransac_n,
+                num_iterations, probability,
+                seed + (unsigned int)plane_models.size(), result);
+        if (plane_model.isZero(0)) {
+            break;
+        }
+        std::vector<size_t> inliers = GetPlaneInliers(
+                remaining_points, plane_model, distance_threshold);
+        if (inliers.size() < (std::max)(min_num_inliers, size_t(1))) {
+            break;
+        }
+        plane_models.push_back(GetPlaneFromPoints(remaining_points, inliers));
+
+        size_t num_remaining = 0;
+        size_t next_inlier = 0;
+        for (size_t idx = 0; idx < remaining_points.size(); ++idx) {
+            if (next_inlier < inliers.size() && inliers[next_inlier] == idx) {
+                inliers[next_inlier++] = remaining_indices[idx];
+            } else {
+                remaining_points[num_remaining] = remaining_points[idx];
+                remaining_indices[num_remaining] = remaining_indices[idx];
+                num_remaining++;
+            }
+        }
+        remaining_points.resize(num_remaining);
+        remaining_indices.resize(num_remaining);
+        utility::LogDebug(
+                "RANSAC | Plane {:d}: Inliers: {:d}, Fitness: {:e}, RMSE: {:e}",
+                plane_models.size() - 1, inliers.size(), result.fitness_,
+                result.inlier_rmse_);
+        plane_inliers.push_back(std::move(inliers));
+    }
+    return std::make_tuple(plane_models, plane_inliers);
+}
+
 }  // namespace geometry
 }  // namespace open3d
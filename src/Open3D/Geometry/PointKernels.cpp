@@ -0,0 +1,260 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/PointKernels.h"
+
+#include <Eigen/Geometry>
+#include <algorithm>
+#include <cmath>
+
+namespace open3d {
+namespace geometry {
+namespace kernel {
+
+namespace {
+
+int64_t GetNumBlocks(size_t size) {
+    return (int64_t(size) + kPointBlockSize - 1) / kPointBlockSize;
+}
+
+}  // unnamed namespace
+
+bool IsAffine(const Eigen::Matrix4d &transformation) {
+    return transformation(3, 0) == 0.0 && transformation(3, 1) == 0.0 &&
+           transformation(3, 2) == 0.0 && transformation(3, 3) == 1.0;
+}
+
+void ComputeBounds(const std::vector<Eigen::Vector3d> &points,
+                   Eigen::Vector3d &min_bound,
+                   Eigen::Vector3d &max_bound) {
+    if (points.empty()) {
+        min_bound.setZero();
+        max_bound.setZero();
+        return;
+    }
+    const int64_t num_points = int64_t(points.size());
+    const int64_t num_blocks = GetNumBlocks(points.size());
+    std::vector<Eigen::Vector3d> block_min(num_blocks), block_max(num_blocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t b = 0; b < num_blocks; b++) {
+        const int64_t begin = b * kPointBlockSize;
+        const int64_t end = (std::min)(begin + kPointBlockSize, num_points);
+        // Plain scalar min/max per coordinate, which the compiler turns into
+        // packed min/max instructions.
+        double min_x = points[begin](0), min_y = points[begin](1),
+               min_z = points[begin](2);
+        double max_x = min_x, max_y = min_y, max_z = min_z;
+        for (int64_t i = begin + 1; i < end; i++) {
+            const double *p = points[i].data();
+            min_x = (std::min)(min_x, p[0]);
+            min_y = (std::min)(min_y, p[1]);
+            min_z = (std::min)(min_z, p[2]);
+            max_x = (std::max)(max_x, p[0]);
+            max_y = (std::max)(max_y, p[1]);
+            max_z = (std::max)(max_z, p[2]);
+        }
+        block_min[b] = Eigen::Vector3d(min_x, min_y, min_z);
+        block_max[b] = Eigen::Vector3d(max_x, max_y, max_z);
+    }
+    min_bound = block_min[0];
+    max_bound = block_max[0];
+    for (int64_t b = 1; b < num_blocks; b++) {
+        min_bound = min_bound.array().min(block_min[b].array()).matrix();
+        max_bound = max_bound.array().max(block_max[b].array()).matrix();
+    }
+}
+
+Eigen::Vector3d ComputeSum(const std::vector<Eigen::Vector3d> &points) {
+    const int64_t num_points = int64_t(points.size());
+    const int64_t num_blocks = GetNumBlocks(points.size());
+    std::vector<Eigen::Vector3d> block_sum(num_blocks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t b = 0; b < num_blocks; b++) {
+        const int64_t begin = b * kPointBlockSize;
+        const int64_t end = (std::min)(begin + kPointBlockSize, num_points);
+        Eigen::Vector3d sum(0, 0, 0);
+        for (int64_t i = begin; i < end; i++) {
+            sum += points[i];
+        }
+        block_sum[b] = sum;
+    }
+    Eigen::Vector3d sum(0, 0, 0);
+    for (const auto &s : block_sum) {
+        sum += s;
+    }
+    return sum;
+}
+
+void AffineTransform(const Eigen::Matrix3d &A,
+                     const Eigen::Vector3d &t,
+                     std::vector<Eigen::Vector3d> &points) {
+    const int64_t num_points = int64_t(points.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_points; i++) {
+        points[i] = A * points[i] + t;
+    }
+}
+
+void LinearTransform(const Eigen::Matrix3d &A,
+                     std::vector<Eigen::Vector3d> &vectors) {
+    const int64_t num_vectors = int64_t(vectors.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_vectors; i++) {
+        vectors[i] = A * vectors[i];
+    }
+}
+
+void HomogeneousTransform(const Eigen::Matrix4d &transformation,
+                          std::vector<Eigen::Vector3d> &points) {
+    if (IsAffine(transformation)) {
+        AffineTransform(transformation.block<3, 3>(0, 0),
+                        transformation.block<3, 1>(0, 3), points);
+        return;
+    }
+    const int64_t num_points = int64_t(points.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_points; i++) {
+        const Eigen::Vector4d p = transformation * points[i].homogeneous();
+        points[i] = p.head<3>() / p(3);
+    }
+}
+
+void RotateCovariances(const Eigen::Matrix3d &R,
+                       std::vector<Eigen::Matrix3d> &covariances) {
+    const int64_t num_covariances = int64_t(covariances.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_covariances; i++) {
+        covariances[i] = R * covariances[i] * R.transpose();
+    }
+}
+
+void Normalize(std::vector<Eigen::Vector3d> &vectors) {
+    const int64_t num_vectors = int64_t(vectors.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_vectors; i++) {
+        vectors[i].normalize();
+    }
+}
+
+void ComputeMaskInAxisAlignedBox(const std::vector<Eigen::Vector3d> &points,
+                                 const Eigen::Vector3d &min_bound,
+                                 const Eigen::Vector3d &max_bound,
+                                 std::vector<char> &mask) {
+    const int64_t num_points = int64_t(points.size());
+    mask.resize(points.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_points; i++) {
+        const Eigen::Vector3d &p = points[i];
+        // Non-short-circuit '&' keeps the loop body free of branches.
+        mask[i] = char((p(0) >= min_bound(0)) & (p(0) <= max_bound(0)) &
+                       (p(1) >= min_bound(1)) & (p(1) <= max_bound(1)) &
+                       (p(2) >= min_bound(2)) & (p(2) <= max_bound(2)));
+    }
+}
+
+void ComputeMaskInOrientedBox(const std::vector<Eigen::Vector3d> &points,
+                              const Eigen::Vector3d &center,
+                              const Eigen::Matrix3d &R,
+                              const Eigen::Vector3d &extent,
+                              std::vector<char> &mask) {
+    const int64_t num_points = int64_t(points.size());
+    const Eigen::Matrix3d R_inv = R.transpose();
+    const Eigen::Vector3d half_extent = extent / 2;
+    mask.resize(points.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_points; i++) {
+        // Coordinates of the point in the frame of the box.
+        const Eigen::Vector3d p = R_inv * (points[i] - center);
+        mask[i] = char((std::abs(p(0)) <= half_extent(0)) &
+                       (std::abs(p(1)) <= half_extent(1)) &
+                       (std::abs(p(2)) <= half_extent(2)));
+    }
+}
+
+size_t ComputeBlockOffsets(const std::vector<char> &mask,
+                           std::vector<size_t> &block_offsets) {
+    const int64_t size = int64_t(mask.size());
+    const int64_t num_blocks = GetNumBlocks(mask.size());
+    block_offsets.assign(num_blocks + 1, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t b = 0; b < num_blocks; b++) {
+        const int64_t begin = b * kPointBlockSize;
+        const int64_t end = (std::min)(begin + kPointBlockSize, size);
+        size_t count = 0;
+        for (int64_t i = begin; i < end; i++) {
+            count += mask[i] != 0;
+        }
+        block_offsets[b + 1] = count;
+    }
+    for (int64_t b = 0; b < num_blocks; b++) {
+        block_offsets[b + 1] += block_offsets[b];
+    }
+    return block_offsets.back();
+}
+
+std::vector<size_t> MaskToIndices(const std::vector<char> &mask) {
+    const int64_t size = int64_t(mask.size());
+    const int64_t num_blocks = GetNumBlocks(mask.size());
+    std::vector<size_t> block_offsets;
+    std::vector<size_t> indices(ComputeBlockOffsets(mask, block_offsets));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t b = 0; b < num_blocks; b++) {
+        const int64_t end = (std::min)((b + 1) * kPointBlockSize, size);
+        size_t offset = block_offsets[b];
+        for (int64_t i = b * kPointBlockSize; i < end; i++) {
+            if (mask[i]) {
+                indices[offset++] = size_t(i);
+            }
+        }
+    }
+    return indices;
+}
+
+}  // namespace kernel
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,109 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+namespace kernel {
+
+/// Number of consecutive points processed by one task of the kernels below.
+/// Reductions are carried out per block and the block results are combined
+/// in order, so that they do not depend on the number of threads.
+constexpr int64_t kPointBlockSize = 4096;
+
+/// Returns true if the last row of \p transformation is (0, 0, 0, 1).
+bool IsAffine(const Eigen::Matrix4d &transformation);
+
+/// \brief Computes the component-wise min and max of \p points in one pass.
+///
+/// Both bounds are zero for an empty list.
+void ComputeBounds(const std::vector<Eigen::Vector3d> &points,
+                   Eigen::Vector3d &min_bound,
+                   Eigen::Vector3d &max_bound);
+
+/// Returns the sum of \p points.
+Eigen::Vector3d ComputeSum(const std::vector<Eigen::Vector3d> &points);
+
+/// Applies p = A * p + t to all \p points.
+void AffineTransform(const Eigen::Matrix3d &A,
+                     const Eigen::Vector3d &t,
+                     std::vector<Eigen::Vector3d> &points);
+
+/// Applies v = A * v to all \p vectors.
+void LinearTransform(const Eigen::Matrix3d &A,
+                     std::vector<Eigen::Vector3d> &vectors);
+
+/// \brief Applies the homogeneous \p transformation to all \p points.
+///
+/// Affine transformations skip the perspective division.
+void HomogeneousTransform(const Eigen::Matrix4d &transformation,
+                          std::vector<Eigen::Vector3d> &points);
+
+/// Applies C = R * C * R^T to all \p covariances.
+void RotateCovariances(const Eigen::Matrix3d &R,
+                       std::vector<Eigen::Matrix3d> &covariances);
+
+/// Normalizes all \p vectors to unit length.
+void Normalize(std::vector<Eigen::Vector3d> &vectors);
+
+/// Sets mask[i] to 1 if points[i] lies in the closed axis-aligned box
+/// [\p min_bound, \p max_bound], and to 0 otherwise.
+void ComputeMaskInAxisAlignedBox(const std::vector<Eigen::Vector3d> &points,
+                                 const Eigen::Vector3d &min_bound,
+                                 const Eigen::Vector3d &max_bound,
+                                 std::vector<char> &mask);
+
+/// \brief Sets mask[i] to 1 if points[i] lies in the closed oriented box,
+/// and to 0 otherwise.
+///
+/// The box is centered at \p center, has its axes along the columns of the
+/// orthonormal matrix \p R, and side lengths \p extent along those axes.
+void ComputeMaskInOrientedBox(const std::vector<Eigen::Vector3d> &points,
+                              const Eigen::Vector3d &center,
+                              const Eigen::Matrix3d &R,
+                              const Eigen::Vector3d &extent,
+                              std::vector<char> &mask);
+
+/// \brief Computes where each block of \p mask starts in the compacted
+/// output.
+///
+/// block_offsets[b] is the number of set entries of \p mask before block b,
+/// and the last entry holds the total number of set entries, which is also
+/// returned.
+size_t ComputeBlockOffsets(const std::vector<char> &mask,
+                           std::vector<size_t> &block_offsets);
+
+/// Returns the indices of the set entries of \p mask, in increasing order.
+std::vector<size_t> MaskToIndices(const std::vector<char> &mask);
+
+}  // namespace kernel
+}  // namespace geometry
+}  // namespace open3d
@@ -0,0 +1,231 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/SoAPointCloud.h"
+
+#include <Eigen/Geometry>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/PointKernels.h"
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace geometry {
+
+namespace {
+
+template <typename Scalar>
+void CopyFromVectors(const std::vector<Eigen::Vector3d> &vectors,
+                     std::vector<Scalar> &buffer) {
+    const int64_t num_vectors = int64_t(vectors.size());
+    buffer.resize(vectors.size() * 3);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_vectors; i++) {
+        buffer[3 * i] = Scalar(vectors[i](0));
+        buffer[3 * i + 1] = Scalar(vectors[i](1));
+        buffer[3 * i + 2] = Scalar(vectors[i](2));
+    }
+}
+
+template <typename Scalar>
+void CopyToVectors(const std::vector<Scalar> &buffer,
+                   std::vector<Eigen::Vector3d> &vectors) {
+    const int64_t num_vectors = int64_t(buffer.size() / 3);
+    vectors.resize(buffer.size() / 3);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_vectors; i++) {
+        vectors[i] = Eigen::Vector3d(buffer[3 * i], buffer[3 * i + 1],
+                                     buffer[3 * i + 2]);
+    }
+}
+
+}  // unnamed namespace
+
+template <typename Scalar>
+SoAPointCloud<Scalar>::SoAPointCloud(const PointCloud &pointcloud) {
+    CopyFromVectors(pointcloud.points_, points_);
+    if (pointcloud.HasNormals()) {
+        CopyFromVectors(pointcloud.normals_, normals_);
+    }
+    if (pointcloud.HasColors()) {
+        CopyFromVectors(pointcloud.colors_, colors_);
+    }
+}
+
+template <typename Scalar>
+SoAPointCloud<Scalar> &SoAPointCloud<Scalar>::Clear() {
+    points_.clear();
+    normals_.clear();
+    colors_.clear();
+    attributes_.clear();
+    return *this;
+}
+
+template <typename Scalar>
+SoAPointCloud<Scalar> &SoAPointCloud<Scalar>::Resize(size_t num_points) {
+    const bool has_normals = HasNormals();
+    const bool has_colors = HasColors();
+    points_.resize(num_points * 3, Scalar(0));
+    if (has_normals) normals_.resize(num_points * 3, Scalar(0));
+    if (has_colors) colors_.resize(num_points * 3, Scalar(0));
+    for (auto &attribute : attributes_) {
+        attribute.second.data_.resize(num_points * attribute.second.channels_,
+                                      Scalar(0));
+    }
+    return *this;
+}
+
+template <typename Scalar>
+Eigen::Map<typename SoAPointCloud<Scalar>::MatrixXX>
+SoAPointCloud<Scalar>::AddAttribute(const std::string &name,
+                                    int channels /* = 1 */) {
+    if (channels <= 0) {
+        utility::LogError(
+                "[SoAPointCloud::AddAttribute] Attribute {} needs at least "
+                "one channel.",
+                name);
+    }
+    auto itr = attributes_.find(name);
+    if (itr != attributes_.end()) {
+        if (itr->second.channels_ != channels) {
+            utility::LogError(
+                    "[SoAPointCloud::AddAttribute] Attribute {} already "
+                    "exists with {:d} channels, not {:d}.",
+                    name, itr->second.channels_, channels);
+        }
+        return GetAttribute(name);
+    }
+    Attribute &attribute = attributes_[name];
+    attribute.channels_ = channels;
+    attribute.data_.assign(Size() * channels, Scalar(0));
+    return GetAttribute(name);
+}
+
+template <typename Scalar>
+int SoAPointCloud<Scalar>::GetAttributeChannels(
+        const std::string &name) const {
+    auto itr = attributes_.find(name);
+    if (itr == attributes_.end()) {
+        utility::LogError(
+                "[SoAPointCloud::GetAttributeChannels] Unknown attribute {}.",
+                name);
+    }
+    return itr->second.channels_;
+}
+
+template <typename Scalar>
+Eigen::Map<typename SoAPointCloud<Scalar>::MatrixXX>
+SoAPointCloud<Scalar>::GetAttribute(const std::string &name) {
+    auto itr = attributes_.find(name);
+    if (itr == attributes_.end()) {
+        utility::LogError(
+                "[SoAPointCloud::GetAttribute] Unknown attribute {}.", name);
+    }
+    Attribute &attribute = itr->second;
+    return Eigen::Map<MatrixXX>(attribute.data_.data(), attribute.channels_,
+                                attribute.data_.size() / attribute.channels_);
+}
+
+template <typename Scalar>
+Eigen::Map<const typename SoAPointCloud<Scalar>::MatrixXX>
+SoAPointCloud<Scalar>::GetAttribute(const std::string &name) const {
+    auto itr = attributes_.find(name);
+    if (itr == attributes_.end()) {
+        utility::LogError(
+                "[SoAPointCloud::GetAttribute] Unknown attribute {}.", name);
+    }
+    const Attribute &attribute = itr->second;
+    return Eigen::Map<const MatrixXX>(
+            attribute.data_.data(), attribute.channels_,
+            attribute.data_.size() / attribute.channels_);
+}
+
+template <typename Scalar>
+std::vector<std::string> SoAPointCloud<Scalar>::GetAttributeNames() const {
+    std::vector<std::string> names;
+    for (const auto &attribute : attributes_) {
+        names.push_back(attribute.first);
+    }
+    return names;
+}
+
+template <typename Scalar>
+SoAPointCloud<Scalar> &SoAPointCloud<Scalar>::Transform(
+        const Eigen::Matrix4d &transformation) {
+    typedef Eigen::Matrix<Scalar, 3, 1> Vector3;
+    typedef Eigen::Matrix<Scalar, 4, 1> Vector4;
+    const Eigen::Matrix<Scalar, 4, 4> T = transformation.cast<Scalar>();
+    const Eigen::Matrix<Scalar, 3, 3> R = T.template block<3, 3>(0, 0);
+    const Vector3 t = T.template block<3, 1>(0, 3);
+    const bool affine = kernel::IsAffine(transformation);
+    auto points = GetPoints();
+    const int64_t num_points = int64_t(Size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_points; i++) {
+        const Vector3 point = points.col(i);
+        if (affine) {
+            points.col(i) = R * point + t;
+        } else {
+            const Vector4 p = T * point.homogeneous();
+            points.col(i) = p.template head<3>() / p(3);
+        }
+    }
+    auto normals = GetNormals();
+    const int64_t num_normals = int64_t(normals.cols());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int64_t i = 0; i < num_normals; i++) {
+        const Vector3 normal = normals.col(i);
+        normals.col(i) = R * normal;
+    }
+    return *this;
+}
+
+template <typename Scalar>
+std::shared_ptr<PointCloud> SoAPointCloud<Scalar>::ToPointCloud() const {
+    auto pointcloud = std::make_shared<PointCloud>();
+    CopyToVectors(points_, pointcloud->points_);
+    if (HasNormals()) {
+        CopyToVectors(normals_, pointcloud->normals_);
+    }
+    if (HasColors()) {
+        CopyToVectors(colors_, pointcloud->colors_);
+    }
+    return pointcloud;
+}
+
+template class SoAPointCloud<float>;
+template class SoAPointCloud<double>;
+
+}  // namespace geometry
+}  // namespace open3d
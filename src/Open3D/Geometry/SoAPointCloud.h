@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace open3d {
+namespace geometry {
+
+class PointCloud;
+
+/// \class SoAPointCloud
+///
+/// \brief Point cloud storing each per-point attribute in its own contiguous
+/// buffer of float or double values.
+///
+/// Unlike PointCloud, which keeps one std::vector<Eigen::Vector3d> per
+/// attribute, every attribute is a flat std::vector<Scalar> holding the
+/// channels of point 0, then those of point 1, and so on. With Scalar = float
+/// this halves the memory footprint. The buffers can be handed to Eigen, FLANN
+/// and the IO functions as they are, without copies, and any number of named
+/// attributes (e.g. intensity, timestamps, labels) can be attached.
+///
+/// \tparam Scalar Either float or double.
+template <typename Scalar>
+class SoAPointCloud {
+public:
+    /// Matrix with one point per column.
+    typedef Eigen::Matrix<Scalar, 3, Eigen::Dynamic> Matrix3X;
+    /// Matrix with the channels of one point per column.
+    typedef Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic> MatrixXX;
+
+public:
+    /// \brief Default Constructor.
+    SoAPointCloud() {}
+    /// \brief Parameterized Constructor.
+    ///
+    /// Converts the points, normals and colors of \p pointcloud.
+    explicit SoAPointCloud(const PointCloud &pointcloud);
+    ~SoAPointCloud() {}
+
+public:
+    /// Returns the number of points.
+    size_t Size() const { return points_.size() / 3; }
+    /// Returns `true` if the point cloud contains no points.
+    bool IsEmpty() const { return !HasPoints(); }
+    /// Returns `true` if the point cloud contains points.
+    bool HasPoints() const { return !points_.empty(); }
+    /// Returns `true` if the point cloud contains point normals.
+    bool HasNormals() const {
+        return !points_.empty() && normals_.size() == points_.size();
+    }
+    /// Returns `true` if the point cloud contains point colors.
+    bool HasColors() const {
+        return !points_.empty() && colors_.size() == points_.size();
+    }
+    /// Removes all points and attributes.
+    SoAPointCloud &Clear();
+    /// \brief Resizes the point cloud to \p num_points points.
+    ///
+    /// Normals, colors and named attributes are resized along if they exist.
+    /// New entries are zero.
+    SoAPointCloud &Resize(size_t num_points);
+
+    /// Returns a 3 x Size() view of the points.
+    Eigen::Map<Matrix3X> GetPoints() {
+        return Eigen::Map<Matrix3X>(points_.data(), 3, points_.size() / 3);
+    }
+    /// Returns a 3 x Size() view of the points.
+    Eigen::Map<const Matrix3X> GetPoints() const {
+        return Eigen::Map<const Matrix3X>(points_.data(), 3,
+                                          points_.size() / 3);
+    }
+    /// Returns a 3 x Size() view of the normals.
+    Eigen::Map<Matrix3X> GetNormals() {
+        return Eigen::Map<Matrix3X>(normals_.data(), 3, normals_.size() / 3);
+    }
+    /// Returns a 3 x Size() view of the normals.
+    Eigen::Map<const Matrix3X> GetNormals() const {
+        return Eigen::Map<const Matrix3X>(normals_.data(), 3,
+                                          normals_.size() / 3);
+    }
+    /// Returns a 3 x Size() view of the colors.
+    Eigen::Map<Matrix3X> GetColors() {
+        return Eigen::Map<Matrix3X>(colors_.data(), 3, colors_.size() / 3);
+    }
+    /// Returns a 3 x Size() view of the colors.
+    Eigen::Map<const Matrix3X> GetColors() const {
+        return Eigen::Map<const Matrix3X>(colors_.data(), 3,
+                                          colors_.size() / 3);
+    }
+
+    /// \brief Adds the per-point attribute \p name with \p channels values per
+    /// point, all set to zero.
+    ///
+    /// If an attribute of the same name and channel count exists, it is kept
+    /// as it is. An existing attribute with a different channel count is an
+    /// error.
+    ///
+    /// \return A channels x Size() view of the attribute.
+    Eigen::Map<MatrixXX> AddAttribute(const std::string &name,
+                                      int channels = 1);
+    /// Returns `true` if the attribute \p name exists.
+    bool HasAttribute(const std::string &name) const {
+        return attributes_.count(name) > 0;
+    }
+    /// Removes the attribute \p name. Returns `false` if it does not exist.
+    bool RemoveAttribute(const std::string &name) {
+        return attributes_.erase(name) > 0;
+    }
+    /// Returns the number of channels of the attribute \p name.
+    int GetAttributeChannels(const std::string &name) const;
+    /// Returns a channels x Size() view of the attribute \p name.
+    Eigen::Map<MatrixXX> GetAttribute(const std::string &name);
+    /// Returns a channels x Size() view of the attribute \p name.
+    Eigen::Map<const MatrixXX> GetAttribute(const std::string &name) const;
+    /// Returns the names of all attributes, in lexicographic order.
+    std::vector<std::string> GetAttributeNames() const;
+
+    /// \brief Applies the 4x4 \p transformation to the points and normals.
+    ///
+    /// Same as PointCloud::Transform(), computed in Scalar precision.
+    SoAPointCloud &Transform(const Eigen::Matrix4d &transformation);
+
+    /// \brief Converts to a PointCloud.
+    ///
+    /// Points, normals and colors are copied, named attributes are dropped.
+    std::shared_ptr<PointCloud> ToPointCloud() const;
+
+public:
+    /// Point coordinates, x, y and z of each point one after the other.
+    std::vector<Scalar> points_;
+    /// Point normals, laid out as #points_. Either empty or of the same size.
+    std::vector<Scalar> normals_;
+    /// RGB colors in [0, 1], laid out as #points_. Either empty or of the
+    /// same size.
+    std::vector<Scalar> colors_;
+
+protected:
+    struct Attribute {
+        int channels_;
+        std::vector<Scalar> data_;
+    };
+    /// Named per-point attributes, kept at Size() points by Resize().
+    std::map<std::string, Attribute> attributes_;
+};
+
+}  // namespace geometry
+}  // namespace open3d
@@ -1342,8 +1342,11 @@ bool TriangleMesh::IsSelfIntersecting() const {
 }
 
 bool TriangleMesh::IsBoundingBoxIntersecting(const TriangleMesh &other) const {
-    return IntersectionTest::AABBAABB(GetMinBound(), GetMaxBound(),
-                                      other.GetMinBound(), other.GetMaxBound());
+    const AxisAlignedBoundingBox box = GetAxisAlignedBoundingBox();
+    const AxisAlignedBoundingBox other_box = other.GetAxisAlignedBoundingBox();
+    return IntersectionTest::AABBAABB(box.min_bound_, box.max_bound_,
+                                      other_box.min_bound_,
+                                      other_box.max_bound_);
 }
 
 bool TriangleMesh::IsIntersecting(const TriangleMesh &other) const {
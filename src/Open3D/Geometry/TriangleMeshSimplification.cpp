@@ -30,6 +30,7 @@
 #include <queue>
 #include <tuple>
 
+#include "Open3D/Geometry/BoundingVolume.h"
 #include "Open3D/Utility/Console.h"
 
 namespace open3d {
@@ -105,8 +106,9 @@ std::shared_ptr<TriangleMesh> TriangleMesh::SimplifyVertexClustering(
 
     Eigen::Vector3d voxel_size3 =
             Eigen::Vector3d(voxel_size, voxel_size, voxel_size);
-    Eigen::Vector3d voxel_min_bound = GetMinBound() - voxel_size3 * 0.5;
-    Eigen::Vector3d voxel_max_bound = GetMaxBound() + voxel_size3 * 0.5;
+    const AxisAlignedBoundingBox box = GetAxisAlignedBoundingBox();
+    Eigen::Vector3d voxel_min_bound = box.min_bound_ - voxel_size3 * 0.5;
+    Eigen::Vector3d voxel_max_bound = box.max_bound_ + voxel_size3 * 0.5;
     if (voxel_size * std::numeric_limits<int>::max() <
         (voxel_max_bound - voxel_min_bound).maxCoeff()) {
         utility::LogError("[VoxelGridFromPointCloud] voxel_size is too small.");
@@ -27,6 +27,7 @@
 #include <numeric>
 #include <unordered_map>
 
+#include "Open3D/Geometry/BoundingVolume.h"
 #include "Open3D/Geometry/IntersectionTest.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/TriangleMesh.h"
@@ -108,8 +109,9 @@ std::shared_ptr<VoxelGrid> VoxelGrid::CreateFromPointCloudWithinBounds(
 std::shared_ptr<VoxelGrid> VoxelGrid::CreateFromPointCloud(
         const PointCloud &input, double voxel_size) {
     Eigen::Vector3d voxel_size3(voxel_size, voxel_size, voxel_size);
-    Eigen::Vector3d min_bound = input.GetMinBound() - voxel_size3 * 0.5;
-    Eigen::Vector3d max_bound = input.GetMaxBound() + voxel_size3 * 0.5;
+    const AxisAlignedBoundingBox box = input.GetAxisAlignedBoundingBox();
+    Eigen::Vector3d min_bound = box.min_bound_ - voxel_size3 * 0.5;
+    Eigen::Vector3d max_bound = box.max_bound_ + voxel_size3 * 0.5;
     return CreateFromPointCloudWithinBounds(input, voxel_size, min_bound,
                                             max_bound);
 }
@@ -164,8 +166,9 @@ std::shared_ptr<VoxelGrid> VoxelGrid::CreateFromTriangleMeshWithinBounds(
 std::shared_ptr<VoxelGrid> VoxelGrid::CreateFromTriangleMesh(
         const TriangleMesh &input, double voxel_size) {
     Eigen::Vector3d voxel_size3(voxel_size, voxel_size, voxel_size);
-    Eigen::Vector3d min_bound = input.GetMinBound() - voxel_size3 * 0.5;
-    Eigen::Vector3d max_bound = input.GetMaxBound() + voxel_size3 * 0.5;
+    const AxisAlignedBoundingBox box = input.GetAxisAlignedBoundingBox();
+    Eigen::Vector3d min_bound = box.min_bound_ - voxel_size3 * 0.5;
+    Eigen::Vector3d max_bound = box.max_bound_ + voxel_size3 * 0.5;
     return CreateFromTriangleMeshWithinBounds(input, voxel_size, min_bound,
                                               max_bound);
 }
@@ -0,0 +1,112 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/ClassIO/SoAPointCloudIO.h"
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
+
+namespace open3d {
+namespace io {
+
+template <typename Scalar>
+bool ReadSoAPointCloud(const std::string &filename,
+                       geometry::SoAPointCloud<Scalar> &pointcloud,
+                       const std::string &format,
+                       bool print_progress) {
+    std::string filename_ext;
+    if (format == "auto") {
+        filename_ext =
+                utility::filesystem::GetFileExtensionInLowerCase(filename);
+    } else {
+        filename_ext = format;
+    }
+    if (filename_ext == "ply") {
+        bool success =
+                ReadSoAPointCloudFromPLY(filename, pointcloud, print_progress);
+        utility::LogDebug("Read geometry::SoAPointCloud: {:d} vertices.",
+                          (int)pointcloud.Size());
+        return success;
+    }
+    geometry::PointCloud buffer;
+    bool success = ReadPointCloud(filename, buffer, format, true, true,
+                                  print_progress);
+    pointcloud = geometry::SoAPointCloud<Scalar>(buffer);
+    return success;
+}
+
+template <typename Scalar>
+bool WriteSoAPointCloud(const std::string &filename,
+                        const geometry::SoAPointCloud<Scalar> &pointcloud,
+                        bool write_ascii /* = false*/,
+                        bool compressed /* = false*/,
+                        bool print_progress) {
+    std::string filename_ext =
+            utility::filesystem::GetFileExtensionInLowerCase(filename);
+    if (filename_ext == "ply") {
+        bool success = WriteSoAPointCloudToPLY(filename, pointcloud,
+                                               write_ascii, compressed,
+                                               print_progress);
+        utility::LogDebug("Write geometry::SoAPointCloud: {:d} vertices.",
+                          (int)pointcloud.Size());
+        return success;
+    }
+    if (!pointcloud.GetAttributeNames().empty()) {
+        utility::LogWarning(
+                "Write geometry::SoAPointCloud: named attributes are only "
+                "written to PLY files, ignoring them.");
+    }
+    return WritePointCloud(filename, *pointcloud.ToPointCloud(), write_ascii,
+                           compressed, print_progress);
+}
+
+template bool ReadSoAPointCloud<float>(
+        const std::string &filename,
+        geometry::SoAPointCloud<float> &pointcloud,
+        const std::string &format,
+        bool print_progress);
+template bool ReadSoAPointCloud<double>(
+        const std::string &filename,
+        geometry::SoAPointCloud<double> &pointcloud,
+        const std::string &format,
+        bool print_progress);
+template bool WriteSoAPointCloud<float>(
+        const std::string &filename,
+        const geometry::SoAPointCloud<float> &pointcloud,
+        bool write_ascii,
+        bool compressed,
+        bool print_progress);
+template bool WriteSoAPointCloud<double>(
+        const std::string &filename,
+        const geometry::SoAPointCloud<double> &pointcloud,
+        bool write_ascii,
+        bool compressed,
+        bool print_progress);
+
+}  // namespace io
+}  // namespace open3d
@@ -0,0 +1,77 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <string>
+
+#include "Open3D/Geometry/SoAPointCloud.h"
+
+namespace open3d {
+namespace io {
+
+/// \brief The general entrance for reading a SoAPointCloud from a file.
+///
+/// PLY files are read straight into the buffers of \p pointcloud, and every
+/// vertex property other than the points, normals and colors becomes a named
+/// attribute. Properties name_0, name_1, ... are gathered into one attribute
+/// name with several channels. The other formats are read through a
+/// PointCloud, see ReadPointCloud().
+/// \return return true if the read function is successful, false otherwise.
+template <typename Scalar>
+bool ReadSoAPointCloud(const std::string &filename,
+                       geometry::SoAPointCloud<Scalar> &pointcloud,
+                       const std::string &format = "auto",
+                       bool print_progress = false);
+
+/// \brief The general entrance for writing a SoAPointCloud to a file.
+///
+/// PLY files are written straight from the buffers of \p pointcloud, with
+/// the named attributes as additional vertex properties, see
+/// ReadSoAPointCloud(). The other formats are written through a PointCloud,
+/// without the named attributes.
+/// \return return true if the write function is successful, false otherwise.
+template <typename Scalar>
+bool WriteSoAPointCloud(const std::string &filename,
+                        const geometry::SoAPointCloud<Scalar> &pointcloud,
+                        bool write_ascii = false,
+                        bool compressed = false,
+                        bool print_progress = false);
+
+template <typename Scalar>
+bool ReadSoAPointCloudFromPLY(const std::string &filename,
+                              geometry::SoAPointCloud<Scalar> &pointcloud,
+                              bool print_progress = false);
+
+template <typename Scalar>
+bool WriteSoAPointCloudToPLY(const std::string &filename,
+                             const geometry::SoAPointCloud<Scalar> &pointcloud,
+                             bool write_ascii = false,
+                             bool compressed = false,
+                             bool print_progress = false);
+
+}  // namespace io
+}  // namespace open3d
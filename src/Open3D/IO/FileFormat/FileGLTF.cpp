@@ -27,6 +27,7 @@
 #include <numeric>
 #include <vector>
 
+#include "Open3D/Geometry/BoundingVolume.h"
 #include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "Open3D/Utility/Console.h"
 #include "Open3D/Utility/FileSystem.h"
@@ -501,11 +502,13 @@ bool WriteTriangleMeshToGLTF(const std::string& filename,
         }
     }
 
-    Eigen::Vector3d min_bound = mesh.GetMinBound();
+    const geometry::AxisAlignedBoundingBox box =
+            mesh.GetAxisAlignedBoundingBox();
+    const Eigen::Vector3d &min_bound = box.min_bound_;
     positions_accessor.minValues.push_back(min_bound[0]);
     positions_accessor.minValues.push_back(min_bound[1]);
     positions_accessor.minValues.push_back(min_bound[2]);
-    Eigen::Vector3d max_bound = mesh.GetMaxBound();
+    const Eigen::Vector3d &max_bound = box.max_bound_;
     positions_accessor.maxValues.push_back(max_bound[0]);
     positions_accessor.maxValues.push_back(max_bound[1]);
     positions_accessor.maxValues.push_back(max_bound[2]);
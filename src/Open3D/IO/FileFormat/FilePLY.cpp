@@ -25,9 +25,14 @@
 // ----------------------------------------------------------------------------
 
 #include <rply/rply.h>
+#include <algorithm>
+#include <cstdlib>
+#include <map>
+#include <type_traits>
 
 #include "Open3D/IO/ClassIO/LineSetIO.h"
 #include "Open3D/IO/ClassIO/PointCloudIO.h"
+#include "Open3D/IO/ClassIO/SoAPointCloudIO.h"
 #include "Open3D/IO/ClassIO/TriangleMeshIO.h"
 #include "Open3D/IO/ClassIO/VoxelGridIO.h"
 #include "Open3D/Utility/Console.h"
@@ -105,6 +110,58 @@ int ReadColorCallback(p_ply_argument argument) {
 
 }  // namespace ply_pointcloud_reader
 
+namespace ply_soa_pointcloud_reader {
+
+/// Where the values of one vertex property go: value i is divided by divisor
+/// and stored at data[i * stride].
+template <typename Scalar>
+struct PLYPropertyTarget {
+    Scalar *data;
+    size_t stride;
+    double divisor;
+    long index;
+    long num;
+    utility::ConsoleProgressBar *progress_bar;
+};
+
+template <typename Scalar>
+int ReadPropertyCallback(p_ply_argument argument) {
+    PLYPropertyTarget<Scalar> *target_ptr;
+    long unused;
+    ply_get_argument_user_data(
+            argument, reinterpret_cast<void **>(&target_ptr), &unused);
+    if (target_ptr->index >= target_ptr->num) {
+        return 0;
+    }
+
+    double value = ply_get_argument_value(argument);
+    target_ptr->data[target_ptr->index * target_ptr->stride] =
+            Scalar(value / target_ptr->divisor);
+    target_ptr->index++;
+    if (target_ptr->progress_bar != nullptr) {
+        ++(*target_ptr->progress_bar);
+    }
+    return 1;
+}
+
+/// Splits "name_<channel>" into name and channel. Returns false if
+/// \p property does not end with an underscore and a number.
+bool SplitChannelSuffix(const std::string &property,
+                        std::string &name,
+                        int &channel) {
+    size_t pos = property.find_last_of('_');
+    if (pos == std::string::npos || pos == 0 || pos + 1 == property.size() ||
+        property.find_first_not_of("0123456789", pos + 1) !=
+                std::string::npos) {
+        return false;
+    }
+    name = property.substr(0, pos);
+    channel = std::atoi(property.c_str() + pos + 1);
+    return true;
+}
+
+}  // namespace ply_soa_pointcloud_reader
+
 namespace ply_trianglemesh_reader {
 
 struct PLYReaderState {
@@ -499,6 +556,266 @@ bool WritePointCloudToPLY(const std::string &filename,
     return true;
 }
 
+template <typename Scalar>
+bool ReadSoAPointCloudFromPLY(const std::string &filename,
+                              geometry::SoAPointCloud<Scalar> &pointcloud,
+                              bool print_progress) {
+    using namespace ply_soa_pointcloud_reader;
+
+    p_ply ply_file = ply_open(filename.c_str(), NULL, 0, NULL);
+    if (!ply_file) {
+        utility::LogWarning("Read PLY failed: unable to open file: {}",
+                            filename.c_str());
+        return false;
+    }
+    if (!ply_read_header(ply_file)) {
+        utility::LogWarning("Read PLY failed: unable to parse header.");
+        ply_close(ply_file);
+        return false;
+    }
+
+    // Collect the scalar properties of the vertex element.
+    long vertex_num = 0;
+    std::vector<std::string> properties;
+    p_ply_element element = NULL;
+    while ((element = ply_get_next_element(ply_file, element))) {
+        const char *element_name;
+        long num_instances;
+        ply_get_element_info(element, &element_name, &num_instances);
+        if (std::string(element_name) != "vertex") {
+            continue;
+        }
+        vertex_num = num_instances;
+        p_ply_property property = NULL;
+        while ((property = ply_get_next_property(element, property))) {
+            const char *property_name;
+            e_ply_type type;
+            ply_get_property_info(property, &property_name, &type, NULL,
+                                  NULL);
+            if (type != PLY_LIST) {
+                properties.push_back(property_name);
+            }
+        }
+    }
+    auto has_property = [&](const std::string &name) {
+        return std::find(properties.begin(), properties.end(), name) !=
+               properties.end();
+    };
+    if (vertex_num <= 0) {
+        utility::LogWarning("Read PLY failed: number of vertex <= 0.");
+        ply_close(ply_file);
+        return false;
+    }
+    if (!has_property("x") || !has_property("y") || !has_property("z")) {
+        utility::LogWarning("Read PLY failed: vertex has no x, y and z.");
+        ply_close(ply_file);
+        return false;
+    }
+    const bool has_normals =
+            has_property("nx") && has_property("ny") && has_property("nz");
+    const bool has_colors = has_property("red") && has_property("green") &&
+                            has_property("blue");
+
+    // Every other property is an attribute. name_0, name_1, ... form one
+    // attribute if the channels are exactly 0 to n - 1 with n > 1 and there
+    // is no property called name, otherwise each is an attribute of its own.
+    std::map<std::string, std::vector<int>> channels;
+    for (const auto &property : properties) {
+        std::string name;
+        int channel;
+        if (SplitChannelSuffix(property, name, channel)) {
+            channels[name].push_back(channel);
+        }
+    }
+    auto is_multichannel = [&](const std::string &name) {
+        auto itr = channels.find(name);
+        if (itr == channels.end() || itr->second.size() < 2 ||
+            has_property(name)) {
+            return false;
+        }
+        std::vector<int> sorted = itr->second;
+        std::sort(sorted.begin(), sorted.end());
+        for (size_t c = 0; c < sorted.size(); c++) {
+            if (sorted[c] != int(c)) return false;
+        }
+        return true;
+    };
+
+    pointcloud.Clear();
+    pointcloud.Resize(vertex_num);
+    if (has_normals) pointcloud.normals_.resize(vertex_num * 3);
+    if (has_colors) pointcloud.colors_.resize(vertex_num * 3);
+
+    utility::ConsoleProgressBar progress_bar(vertex_num + 1,
+                                             "Reading PLY: ", print_progress);
+    // The callbacks keep pointers to the targets, which must not move.
+    std::vector<PLYPropertyTarget<Scalar>> targets;
+    targets.reserve(properties.size());
+    for (const auto &property : properties) {
+        PLYPropertyTarget<Scalar> target;
+        target.stride = 3;
+        target.divisor = 1.0;
+        target.index = 0;
+        target.num = vertex_num;
+        target.progress_bar = nullptr;
+        const char *xyz[] = {"x", "y", "z"};
+        const char *normal[] = {"nx", "ny", "nz"};
+        const char *color[] = {"red", "green", "blue"};
+        target.data = nullptr;
+        for (int c = 0; c < 3; c++) {
+            if (property == xyz[c]) {
+                target.data = pointcloud.points_.data() + c;
+                if (c == 0) target.progress_bar = &progress_bar;
+            } else if (has_normals && property == normal[c]) {
+                target.data = pointcloud.normals_.data() + c;
+            } else if (has_colors && property == color[c]) {
+                target.data = pointcloud.colors_.data() + c;
+                target.divisor = 255.0;
+            }
+        }
+        if (target.data == nullptr) {
+            std::string name;
+            int channel;
+            if (SplitChannelSuffix(property, name, channel) &&
+                is_multichannel(name)) {
+                int num_channels = int(channels[name].size());
+                target.data =
+                        pointcloud.AddAttribute(name, num_channels).data() +
+                        channel;
+                target.stride = num_channels;
+            } else {
+                target.data = pointcloud.AddAttribute(property).data();
+                target.stride = 1;
+            }
+        }
+        targets.push_back(target);
+        ply_set_read_cb(ply_file, "vertex", property.c_str(),
+                        ReadPropertyCallback<Scalar>, &targets.back(), 0);
+    }
+
+    if (!ply_read(ply_file)) {
+        utility::LogWarning("Read PLY failed: unable to read file: {}",
+                            filename);
+        ply_close(ply_file);
+        return false;
+    }
+
+    ply_close(ply_file);
+    ++progress_bar;
+    return true;
+}
+
+template <typename Scalar>
+bool WriteSoAPointCloudToPLY(const std::string &filename,
+                             const geometry::SoAPointCloud<Scalar> &pointcloud,
+                             bool write_ascii /* = false*/,
+                             bool compressed /* = false*/,
+                             bool print_progress) {
+    if (pointcloud.IsEmpty()) {
+        utility::LogWarning("Write PLY failed: point cloud has 0 points.");
+        return false;
+    }
+
+    p_ply ply_file = ply_create(filename.c_str(),
+                                write_ascii ? PLY_ASCII : PLY_LITTLE_ENDIAN,
+                                NULL, 0, NULL);
+    if (!ply_file) {
+        utility::LogWarning("Write PLY failed: unable to open file: {}",
+                            filename);
+        return false;
+    }
+
+    // One column per vertex property, value i is at data[i * stride].
+    struct Column {
+        const Scalar *data;
+        size_t stride;
+        bool is_color;
+    };
+    std::vector<Column> columns;
+    const e_ply_type type =
+            std::is_same<Scalar, float>::value ? PLY_FLOAT : PLY_DOUBLE;
+    auto add_column = [&](const std::string &name, const Scalar *data,
+                          size_t stride, bool is_color) {
+        e_ply_type column_type = is_color ? PLY_UCHAR : type;
+        ply_add_property(ply_file, name.c_str(), column_type, column_type,
+                         column_type);
+        columns.push_back({data, stride, is_color});
+    };
+    ply_add_comment(ply_file, "Created by Open3D");
+    ply_add_element(ply_file, "vertex", static_cast<long>(pointcloud.Size()));
+    add_column("x", pointcloud.points_.data(), 3, false);
+    add_column("y", pointcloud.points_.data() + 1, 3, false);
+    add_column("z", pointcloud.points_.data() + 2, 3, false);
+    if (pointcloud.HasNormals()) {
+        add_column("nx", pointcloud.normals_.data(), 3, false);
+        add_column("ny", pointcloud.normals_.data() + 1, 3, false);
+        add_column("nz", pointcloud.normals_.data() + 2, 3, false);
+    }
+    if (pointcloud.HasColors()) {
+        add_column("red", pointcloud.colors_.data(), 3, true);
+        add_column("green", pointcloud.colors_.data() + 1, 3, true);
+        add_column("blue", pointcloud.colors_.data() + 2, 3, true);
+    }
+    for (const auto &name : pointcloud.GetAttributeNames()) {
+        const auto attribute = pointcloud.GetAttribute(name);
+        const size_t num_channels = size_t(attribute.rows());
+        for (size_t c = 0; c < num_channels; c++) {
+            add_column(num_channels == 1 ? name
+                                         : name + "_" + std::to_string(c),
+                       attribute.data() + c, num_channels, false);
+        }
+    }
+    if (!ply_write_header(ply_file)) {
+        utility::LogWarning("Write PLY failed: unable to write header.");
+        ply_close(ply_file);
+        return false;
+    }
+
+    utility::ConsoleProgressBar progress_bar(pointcloud.Size(),
+                                             "Writing PLY: ", print_progress);
+
+    bool printed_color_warning = false;
+    for (size_t i = 0; i < pointcloud.Size(); i++) {
+        for (const auto &column : columns) {
+            double value = column.data[i * column.stride];
+            if (column.is_color) {
+                if (!printed_color_warning && (value < 0 || value > 1)) {
+                    utility::LogWarning(
+                            "Write Ply clamped color value to valid range");
+                    printed_color_warning = true;
+                }
+                value = std::min(255.0, std::max(0.0, value * 255.0));
+            }
+            ply_write(ply_file, value);
+        }
+        ++progress_bar;
+    }
+
+    ply_close(ply_file);
+    return true;
+}
+
+template bool ReadSoAPointCloudFromPLY<float>(
+        const std::string &filename,
+        geometry::SoAPointCloud<float> &pointcloud,
+        bool print_progress);
+template bool ReadSoAPointCloudFromPLY<double>(
+        const std::string &filename,
+        geometry::SoAPointCloud<double> &pointcloud,
+        bool print_progress);
+template bool WriteSoAPointCloudToPLY<float>(
+        const std::string &filename,
+        const geometry::SoAPointCloud<float> &pointcloud,
+        bool write_ascii,
+        bool compressed,
+        bool print_progress);
+template bool WriteSoAPointCloudToPLY<double>(
+        const std::string &filename,
+        const geometry::SoAPointCloud<double> &pointcloud,
+        bool write_ascii,
+        bool compressed,
+        bool print_progress);
+
 bool ReadTriangleMeshFromPLY(const std::string &filename,
                              geometry::TriangleMesh &mesh,
                              bool print_progress) {
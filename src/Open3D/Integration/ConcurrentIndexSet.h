@@ -0,0 +1,175 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace open3d {
+namespace integration {
+
+/// \class ConcurrentIndexSet
+///
+/// \brief Fixed capacity set of 3D integer indices that threads insert into
+/// without locks.
+///
+/// The set is an open addressing hash table of packed keys with linear
+/// probing. An insertion claims an empty slot with a single compare and swap,
+/// so concurrent insertions of the same index store it once. The capacity is
+/// fixed between calls to Reset(), so that a set can be reused without
+/// reallocating it. Each coordinate must lie in [-2^20, 2^20).
+class ConcurrentIndexSet {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param max_size Maximum number of indices the set holds.
+    explicit ConcurrentIndexSet(size_t max_size = 0) : num_slots_(0) {
+        Reset(max_size);
+    }
+
+    /// \brief Removes all indices and makes room for \p max_size indices.
+    ///
+    /// The table is only reallocated if it has to grow. Must not run
+    /// concurrently with Insert().
+    void Reset(size_t max_size) {
+        // A load factor of at most 0.5 keeps the probe sequences short.
+        size_t num_slots = 1;
+        while (num_slots < 2 * max_size) {
+            num_slots <<= 1;
+        }
+        if (num_slots > num_slots_) {
+            num_slots_ = num_slots;
+            slots_.reset(new std::atomic<uint64_t>[num_slots_]);
+        }
+        for (size_t i = 0; i < num_slots_; i++) {
+            slots_[i].store(kEmptySlot, std::memory_order_relaxed);
+        }
+    }
+
+    /// Returns the number of indices the set holds at a load factor of 0.5.
+    size_t GetMaxSize() const { return num_slots_ / 2; }
+
+    /// \brief Inserts \p index, safe to call from several threads.
+    ///
+    /// \return `false` if the set is full.
+    bool Insert(const Eigen::Vector3i &index) {
+        const uint64_t key = Pack(index);
+        size_t slot = Hash(key) & (num_slots_ - 1);
+        for (size_t probe = 0; probe < num_slots_; probe++) {
+            uint64_t current = slots_[slot].load(std::memory_order_relaxed);
+            if (current == key) {
+                return true;
+            }
+            if (current == kEmptySlot) {
+                if (slots_[slot].compare_exchange_strong(
+                            current, key, std::memory_order_relaxed)) {
+                    return true;
+                }
+                // Another thread claimed the slot, possibly for this key.
+                if (current == key) {
+                    return true;
+                }
+            }
+            slot = (slot + 1) & (num_slots_ - 1);
+        }
+        return false;
+    }
+
+    /// \brief Returns the indices in the set, in no particular order.
+    ///
+    /// Must not run concurrently with Insert().
+    std::vector<Eigen::Vector3i> GetIndices() const {
+        std::vector<Eigen::Vector3i> indices;
+        for (size_t i = 0; i < num_slots_; i++) {
+            const uint64_t key = slots_[i].load(std::memory_order_relaxed);
+            if (key != kEmptySlot) {
+                indices.push_back(Unpack(key));
+            }
+        }
+        return indices;
+    }
+
+    /// \brief Returns the indices in the set, in no particular order, and
+    /// removes them, in a single pass over the table.
+    ///
+    /// Must not run concurrently with Insert().
+    std::vector<Eigen::Vector3i> ExtractIndices() {
+        std::vector<Eigen::Vector3i> indices;
+        for (size_t i = 0; i < num_slots_; i++) {
+            const uint64_t key = slots_[i].load(std::memory_order_relaxed);
+            if (key != kEmptySlot) {
+                indices.push_back(Unpack(key));
+                slots_[i].store(kEmptySlot, std::memory_order_relaxed);
+            }
+        }
+        return indices;
+    }
+
+public:
+    /// Key of the empty slots, has the top bit set and never collides with a
+    /// packed index.
+    static const uint64_t kEmptySlot = ~uint64_t(0);
+
+    /// Packs the three coordinates of \p index in 63 bits.
+    static uint64_t Pack(const Eigen::Vector3i &index) {
+        return (uint64_t(index(0) + kOffset) & kMask) |
+               ((uint64_t(index(1) + kOffset) & kMask) << kBits) |
+               ((uint64_t(index(2) + kOffset) & kMask) << (2 * kBits));
+    }
+
+    /// Inverse of Pack().
+    static Eigen::Vector3i Unpack(uint64_t key) {
+        return Eigen::Vector3i(int(int64_t(key & kMask) - kOffset),
+                               int(int64_t((key >> kBits) & kMask) - kOffset),
+                               int(int64_t((key >> (2 * kBits)) & kMask) -
+                                   kOffset));
+    }
+
+    /// Finalizer of splitmix64, spreads neighboring indices over the table.
+    static uint64_t Hash(uint64_t key) {
+        key ^= key >> 30;
+        key *= 0xbf58476d1ce4e5b9ULL;
+        key ^= key >> 27;
+        key *= 0x94d049bb133111ebULL;
+        key ^= key >> 31;
+        return key;
+    }
+
+private:
+    static const int kBits = 21;
+    static const int64_t kOffset = int64_t(1) << (kBits - 1);
+    static const uint64_t kMask = (uint64_t(1) << kBits) - 1;
+
+    size_t num_slots_;
+    std::unique_ptr<std::atomic<uint64_t>[]> slots_;
+};
+
+}  // namespace integration
+}  // namespace open3d
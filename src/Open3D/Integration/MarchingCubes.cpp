@@ -0,0 +1,114 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/MarchingCubes.h"
+
+#include <unordered_map>
+
+#include "Open3D/Utility/Helper.h"
+
+namespace open3d {
+namespace integration {
+
+std::shared_ptr<geometry::TriangleMesh> MergeMarchingCubesChunks(
+        const std::vector<MarchingCubesChunk> &chunks) {
+    auto mesh = std::make_shared<geometry::TriangleMesh>();
+    // Stitching: walk the chunks in order and map every local vertex to its
+    // output index. A boundary vertex whose edge was already emitted by an
+    // earlier chunk reuses that vertex. Only boundary vertices are hashed.
+    std::unordered_map<
+            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
+            std::equal_to<Eigen::Vector4i>,
+            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
+            edgeindex_to_vertexindex;
+    std::vector<std::vector<int>> vertex_maps(chunks.size());
+    std::vector<size_t> vertex_offsets(chunks.size() + 1, 0);
+    std::vector<size_t> triangle_offsets(chunks.size() + 1, 0);
+    bool has_colors = false;
+    for (size_t c = 0; c < chunks.size(); c++) {
+        const auto &chunk = chunks[c];
+        const int num_vertices = (int)chunk.mesh_.vertices_.size();
+        auto &vertex_map = vertex_maps[c];
+        vertex_map.assign(num_vertices, -1);
+        for (size_t i = 0; i < chunk.boundary_vertices_.size(); i++) {
+            auto it = edgeindex_to_vertexindex.find(chunk.boundary_edges_[i]);
+            if (it != edgeindex_to_vertexindex.end()) {
+                vertex_map[chunk.boundary_vertices_[i]] = it->second;
+            }
+        }
+        int next = (int)vertex_offsets[c];
+        for (int v = 0; v < num_vertices; v++) {
+            if (vertex_map[v] < 0) {
+                vertex_map[v] = next++;
+            }
+        }
+        for (size_t i = 0; i < chunk.boundary_vertices_.size(); i++) {
+            edgeindex_to_vertexindex.emplace(
+                    chunk.boundary_edges_[i],
+                    vertex_map[chunk.boundary_vertices_[i]]);
+        }
+        vertex_offsets[c + 1] = next;
+        triangle_offsets[c + 1] =
+                triangle_offsets[c] + chunk.mesh_.triangles_.size();
+        has_colors = has_colors || chunk.mesh_.HasVertexColors();
+    }
+
+    mesh->vertices_.resize(vertex_offsets.back());
+    if (has_colors) {
+        mesh->vertex_colors_.resize(vertex_offsets.back());
+    }
+    mesh->triangles_.resize(triangle_offsets.back());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int c = 0; c < (int)chunks.size(); c++) {
+        const auto &chunk = chunks[c];
+        const auto &vertex_map = vertex_maps[c];
+        for (size_t v = 0; v < chunk.mesh_.vertices_.size(); v++) {
+            // Vertices mapped below the chunk's offset are owned by an
+            // earlier chunk.
+            if (vertex_map[v] < (int)vertex_offsets[c]) {
+                continue;
+            }
+            mesh->vertices_[vertex_map[v]] = chunk.mesh_.vertices_[v];
+            if (has_colors) {
+                mesh->vertex_colors_[vertex_map[v]] =
+                        chunk.mesh_.vertex_colors_[v];
+            }
+        }
+        for (size_t t = 0; t < chunk.mesh_.triangles_.size(); t++) {
+            const auto &triangle = chunk.mesh_.triangles_[t];
+            mesh->triangles_[triangle_offsets[c] + t] =
+                    Eigen::Vector3i(vertex_map[triangle(0)],
+                                    vertex_map[triangle(1)],
+                                    vertex_map[triangle(2)]);
+        }
+    }
+    return mesh;
+}
+
+}  // namespace integration
+}  // namespace open3d
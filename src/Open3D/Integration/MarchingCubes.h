@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Geometry/TriangleMesh.h"
+#include "Open3D/Integration/MarchingCubesConst.h"
+
+namespace open3d {
+namespace integration {
+
+/// \class MarchingCubesChunk
+///
+/// \brief Triangle mesh of one block of a TSDF volume, extracted
+/// independently of the other blocks.
+///
+/// Vertices are deduplicated inside the block only. The vertices on the faces
+/// of the block can also be generated by a neighbor block, they are recorded
+/// with their global edge index so that MergeMarchingCubesChunks() can stitch
+/// them.
+class MarchingCubesChunk {
+public:
+    /// Mesh of the block, with vertex colors for colored volumes.
+    geometry::TriangleMesh mesh_;
+    /// Indices into mesh_.vertices_ of the vertices on the block faces.
+    std::vector<int> boundary_vertices_;
+    /// Global edge index (x, y, z, axis) of each boundary vertex.
+    std::vector<Eigen::Vector4i, Eigen::aligned_allocator<Eigen::Vector4i>>
+            boundary_edges_;
+};
+
+/// \brief Runs marching cubes over the cubes [cube_begin, cube_end) of a TSDF
+/// grid.
+///
+/// Cube (x, y, z) has voxel (x, y, z) as its first corner. Vertices are
+/// deduplicated with a block-local edge table instead of a global hash map.
+///
+/// \param get_voxel Functor `bool(int x, int y, int z, float &tsdf,
+/// Eigen::Vector3d &color)` that reads the voxel at (x, y, z) relative to \p
+/// cube_begin, where each coordinate is in [0, cube_end - cube_begin]. It
+/// returns `false` for voxels that have not been observed.
+/// \param cube_begin Global grid index of the first cube.
+/// \param cube_end Global grid index past the last cube.
+/// \param voxel_length Length of a voxel.
+/// \param origin Offset added to all vertices.
+/// \param with_color If `true`, vertex colors are interpolated.
+/// \param edge_to_vertex Scratch buffer for the edge table, it can be reused
+/// between calls.
+/// \param chunk Output chunk.
+template <typename GetVoxel>
+void ExtractMarchingCubesChunk(const GetVoxel &get_voxel,
+                               const Eigen::Vector3i &cube_begin,
+                               const Eigen::Vector3i &cube_end,
+                               double voxel_length,
+                               const Eigen::Vector3d &origin,
+                               bool with_color,
+                               std::vector<int> &edge_to_vertex,
+                               MarchingCubesChunk &chunk) {
+    // implementation of marching cubes, based on
+    // http://paulbourke.net/geometry/polygonise/
+    const Eigen::Vector3i extent = cube_end - cube_begin;
+    const int stride_y = (extent(2) + 1) * 3;
+    const int stride_x = (extent(1) + 1) * stride_y;
+    edge_to_vertex.assign(size_t(extent(0) + 1) * stride_x, -1);
+    chunk.mesh_.Clear();
+    chunk.boundary_vertices_.clear();
+    chunk.boundary_edges_.clear();
+    auto &mesh = chunk.mesh_;
+    const double half_voxel_length = voxel_length * 0.5;
+    int edge_to_index[12];
+    for (int x = 0; x < extent(0); x++) {
+        for (int y = 0; y < extent(1); y++) {
+            for (int z = 0; z < extent(2); z++) {
+                int cube_index = 0;
+                float f[8];
+                Eigen::Vector3d c[8];
+                for (int i = 0; i < 8; i++) {
+                    if (!get_voxel(x + shift[i](0), y + shift[i](1),
+                                   z + shift[i](2), f[i], c[i])) {
+                        cube_index = 0;
+                        break;
+                    }
+                    if (f[i] < 0.0f) {
+                        cube_index |= (1 << i);
+                    }
+                }
+                if (cube_index == 0 || cube_index == 255) {
+                    continue;
+                }
+                for (int i = 0; i < 12; i++) {
+                    if (!(edge_table[cube_index] & (1 << i))) {
+                        continue;
+                    }
+                    Eigen::Vector4i local_edge =
+                            Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
+                    int &vertex =
+                            edge_to_vertex[local_edge(0) * stride_x +
+                                           local_edge(1) * stride_y +
+                                           local_edge(2) * 3 + local_edge(3)];
+                    if (vertex < 0) {
+                        vertex = (int)mesh.vertices_.size();
+                        Eigen::Vector4i edge_index =
+                                local_edge + Eigen::Vector4i(cube_begin(0),
+                                                             cube_begin(1),
+                                                             cube_begin(2), 0);
+                        Eigen::Vector3d pt(
+                                half_voxel_length +
+                                        voxel_length * edge_index(0),
+                                half_voxel_length +
+                                        voxel_length * edge_index(1),
+                                half_voxel_length +
+                                        voxel_length * edge_index(2));
+                        double f0 = std::abs((double)f[edge_to_vert[i][0]]);
+                        double f1 = std::abs((double)f[edge_to_vert[i][1]]);
+                        pt(edge_index(3)) += f0 * voxel_length / (f0 + f1);
+                        mesh.vertices_.push_back(pt + origin);
+                        if (with_color) {
+                            const auto &c0 = c[edge_to_vert[i][0]];
+                            const auto &c1 = c[edge_to_vert[i][1]];
+                            mesh.vertex_colors_.push_back((f1 * c0 + f0 * c1) /
+                                                          (f0 + f1));
+                        }
+                        // An edge is shared with the cubes of a neighbor
+                        // block if it lies on a face of this block.
+                        for (int k = 0; k < 3; k++) {
+                            if (k != local_edge(3) &&
+                                (local_edge(k) == 0 ||
+                                 local_edge(k) == extent(k))) {
+                                chunk.boundary_vertices_.push_back(vertex);
+                                chunk.boundary_edges_.push_back(edge_index);
+                                break;
+                            }
+                        }
+                    }
+                    edge_to_index[i] = vertex;
+                }
+                for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
+                    mesh.triangles_.push_back(Eigen::Vector3i(
+                            edge_to_index[tri_table[cube_index][i]],
+                            edge_to_index[tri_table[cube_index][i + 2]],
+                            edge_to_index[tri_table[cube_index][i + 1]]));
+                }
+            }
+        }
+    }
+}
+
+/// \brief Concatenates chunks into one mesh, stitching the boundary vertices
+/// shared by neighbor chunks.
+///
+/// The output does not depend on how the chunks were scheduled: vertices and
+/// triangles appear in chunk order.
+std::shared_ptr<geometry::TriangleMesh> MergeMarchingCubesChunks(
+        const std::vector<MarchingCubesChunk> &chunks);
+
+}  // namespace integration
+}  // namespace open3d
@@ -26,16 +26,83 @@
 
 #include "Open3D/Integration/ScalableTSDFVolume.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <unordered_set>
 
 #include "Open3D/Geometry/PointCloud.h"
-#include "Open3D/Integration/MarchingCubesConst.h"
-#include "Open3D/Integration/UniformTSDFVolume.h"
+#include "Open3D/Integration/ConcurrentIndexSet.h"
+#include "Open3D/Integration/MarchingCubes.h"
+#include "Open3D/Integration/TSDFIntegration.h"
+#include "Open3D/Integration/TSDFRaycast.h"
 #include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/FileSystem.h"
 
 namespace open3d {
 namespace integration {
 
+namespace {
+
+/// Identifies the files written by ScalableTSDFVolume::WriteToFile().
+const char kVolumeFileMagic[8] = {'O', '3', 'D', 'T', 'S', 'D', 'F', '\0'};
+const uint32_t kVolumeFileVersion = 1;
+
+bool IndexLess(const Eigen::Vector3i &a, const Eigen::Vector3i &b) {
+    return std::lexicographical_compare(a.data(), a.data() + 3, b.data(),
+                                        b.data() + 3);
+}
+
+template <typename T>
+bool WriteValue(FILE *file, const T &value) {
+    return fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template <typename T>
+bool ReadValue(FILE *file, T &value) {
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+/// Creates a subdirectory of \p root that did not exist before, and returns
+/// its regularized name, or an empty string on failure.
+std::string MakeUniqueDirectory(const std::string &root) {
+    // mkdir fails on existing directories, so a name is never handed out
+    // twice, even to volumes of different processes.
+    for (int i = 0;; i++) {
+        const std::string directory = root + "volume_" + std::to_string(i);
+        if (utility::filesystem::MakeDirectory(directory)) {
+            return utility::filesystem::GetRegularizedDirectoryName(directory);
+        }
+        if (!utility::filesystem::DirectoryExists(directory)) {
+            return std::string();
+        }
+    }
+}
+
+bool CopyPageFile(const std::string &source, const std::string &destination) {
+    FILE *input = utility::filesystem::FOpen(source, "rb");
+    if (input == NULL) {
+        return false;
+    }
+    FILE *output = utility::filesystem::FOpen(destination, "wb");
+    if (output == NULL) {
+        fclose(input);
+        return false;
+    }
+    char buffer[65536];
+    bool success = true;
+    size_t size;
+    while (success && (size = fread(buffer, 1, sizeof(buffer), input)) > 0) {
+        success = fwrite(buffer, 1, size, output) == size;
+    }
+    success = success && !ferror(input);
+    fclose(input);
+    success = fclose(output) == 0 && success;
+    return success;
+}
+
+}  // unnamed namespace
+
 ScalableTSDFVolume::ScalableTSDFVolume(double voxel_length,
                                        double sdf_trunc,
                                        TSDFVolumeColorType color_type,
@@ -44,85 +111,262 @@ ScalableTSDFVolume::ScalableTSDFVolume(double voxel_length,
     : TSDFVolume(voxel_length, sdf_trunc, color_type),
       volume_unit_resolution_(volume_unit_resolution),
       volume_unit_length_(voxel_length * volume_unit_resolution),
-      depth_sampling_stride_(depth_sampling_stride) {}
+      depth_sampling_stride_(depth_sampling_stride),
+      paging_memory_budget_(0),
+      paging_working_radius_(0.0),
+      access_tick_(0) {
+    block_pool_ = TSDFVoxelArray(color_type_);
+}
 
-ScalableTSDFVolume::~ScalableTSDFVolume() {}
+ScalableTSDFVolume::ScalableTSDFVolume(const ScalableTSDFVolume &other)
+    : TSDFVolume(other),
+      volume_unit_resolution_(other.volume_unit_resolution_),
+      volume_unit_length_(other.volume_unit_length_),
+      depth_sampling_stride_(other.depth_sampling_stride_),
+      volume_units_(other.volume_units_),
+      volume_unit_map_(other.volume_unit_map_),
+      block_pool_(other.block_pool_),
+      dirty_units_(other.dirty_units_),
+      paging_memory_budget_(other.paging_memory_budget_),
+      paging_working_radius_(other.paging_working_radius_),
+      access_tick_(other.access_tick_),
+      free_blocks_(other.free_blocks_) {
+    if (other.IsPagingEnabled() && !CopyPagingDirectory(other)) {
+        utility::LogError(
+                "[ScalableTSDFVolume] Unable to copy the page files of {}.",
+                other.paging_directory_);
+    }
+}
 
-void ScalableTSDFVolume::Reset() { volume_units_.clear(); }
+ScalableTSDFVolume &ScalableTSDFVolume::operator=(
+        const ScalableTSDFVolume &other) {
+    if (this == &other) {
+        return *this;
+    }
+    RemovePagingDirectory();
+    TSDFVolume::operator=(other);
+    volume_unit_resolution_ = other.volume_unit_resolution_;
+    volume_unit_length_ = other.volume_unit_length_;
+    depth_sampling_stride_ = other.depth_sampling_stride_;
+    volume_units_ = other.volume_units_;
+    volume_unit_map_ = other.volume_unit_map_;
+    block_pool_ = other.block_pool_;
+    dirty_units_ = other.dirty_units_;
+    paging_memory_budget_ = other.paging_memory_budget_;
+    paging_working_radius_ = other.paging_working_radius_;
+    access_tick_ = other.access_tick_;
+    free_blocks_ = other.free_blocks_;
+    if (other.IsPagingEnabled() && !CopyPagingDirectory(other)) {
+        utility::LogError(
+                "[ScalableTSDFVolume] Unable to copy the page files of {}.",
+                other.paging_directory_);
+    }
+    return *this;
+}
+
+ScalableTSDFVolume::~ScalableTSDFVolume() { RemovePagingDirectory(); }
+
+void ScalableTSDFVolume::Reset() {
+    if (IsPagingEnabled()) {
+        for (const auto &unit : volume_units_) {
+            if (unit.block_ < 0) {
+                utility::filesystem::RemoveFile(GetPageFilename(unit.index_));
+            }
+        }
+    }
+    volume_units_.clear();
+    volume_unit_map_.Clear();
+    block_pool_ = TSDFVoxelArray(color_type_);
+    free_blocks_.clear();
+    dirty_units_.clear();
+}
 
 void ScalableTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic) {
-    if ((image.depth_.num_of_channels_ != 1) ||
-        (image.depth_.bytes_per_channel_ != 4) ||
-        (image.depth_.width_ != intrinsic.width_) ||
-        (image.depth_.height_ != intrinsic.height_) ||
-        (color_type_ == TSDFVolumeColorType::RGB8 &&
-         image.color_.num_of_channels_ != 3) ||
-        (color_type_ == TSDFVolumeColorType::RGB8 &&
-         image.color_.bytes_per_channel_ != 1) ||
-        (color_type_ == TSDFVolumeColorType::Gray32 &&
-         image.color_.num_of_channels_ != 1) ||
-        (color_type_ == TSDFVolumeColorType::Gray32 &&
-         image.color_.bytes_per_channel_ != 4) ||
-        (color_type_ != TSDFVolumeColorType::NoColor &&
-         image.color_.width_ != intrinsic.width_) ||
-        (color_type_ != TSDFVolumeColorType::NoColor &&
-         image.color_.height_ != intrinsic.height_)) {
+    if (!IsImageFormatSupported(image, intrinsic)) {
         utility::LogError(
                 "[ScalableTSDFVolume::Integrate] Unsupported image format.");
     }
     auto depth2cameradistance =
             geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage(
                     intrinsic);
-    auto pointcloud = geometry::PointCloud::CreateFromDepthImage(
-            image.depth_, intrinsic, extrinsic, 1000.0, 1000.0,
-            depth_sampling_stride_);
-    std::unordered_set<Eigen::Vector3i,
-                       utility::hash_eigen::hash<Eigen::Vector3i>>
-            touched_volume_units_;
-    for (const auto &point : pointcloud->points_) {
-        auto min_bound = LocateVolumeUnit(
-                point - Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        auto max_bound = LocateVolumeUnit(
-                point + Eigen::Vector3d(sdf_trunc_, sdf_trunc_, sdf_trunc_));
-        for (auto x = min_bound(0); x <= max_bound(0); x++) {
-            for (auto y = min_bound(1); y <= max_bound(1); y++) {
-                for (auto z = min_bound(2); z <= max_bound(2); z++) {
-                    auto loc = Eigen::Vector3i(x, y, z);
-                    if (touched_volume_units_.find(loc) ==
-                        touched_volume_units_.end()) {
-                        touched_volume_units_.insert(loc);
-                        auto volume = OpenVolumeUnit(Eigen::Vector3i(x, y, z));
-                        volume->IntegrateWithDepthToCameraDistanceMultiplier(
-                                image, intrinsic, extrinsic,
-                                *depth2cameradistance);
-                    }
+    IntegrateWithDepthToCameraDistanceMultiplier(image, intrinsic, extrinsic,
+                                                 *depth2cameradistance);
+}
+
+bool ScalableTSDFVolume::InsertTouchedVolumeUnits(
+        const geometry::RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic) {
+    // The truncation band of every sampled pixel is a segment of its ray, and
+    // the units it crosses are found by a DDA traversal.
+    const int stride = (std::max)(depth_sampling_stride_, 1);
+    const int num_rows = (intrinsic.height_ + stride - 1) / stride;
+    const Eigen::Matrix4d camera_pose = extrinsic.inverse();
+    const Eigen::Matrix3d rotation = camera_pose.block<3, 3>(0, 0);
+    const Eigen::Vector3d translation = camera_pose.block<3, 1>(0, 3);
+    const auto focal_length = intrinsic.GetFocalLength();
+    const auto principal_point = intrinsic.GetPrincipalPoint();
+    int num_failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+ : num_failed)
+#endif
+    for (int row = 0; row < num_rows; row++) {
+        const int v = row * stride;
+        for (int u = 0; u < intrinsic.width_; u += stride) {
+            const float d = *image.depth_.PointerAt<float>(u, v);
+            if (d <= 0.0f || !std::isfinite(d)) {
+                continue;
+            }
+            const Eigen::Vector3d ray(
+                    (u - principal_point.first) / focal_length.first,
+                    (v - principal_point.second) / focal_length.second, 1.0);
+            // Voxels at depth z on the ray have sdf = (d - z) * |ray|.
+            const double band = sdf_trunc_ / ray.norm();
+            const Eigen::Vector3d p0 =
+                    rotation * (ray * (std::max)(d - band, 0.0)) + translation;
+            const Eigen::Vector3d p1 =
+                    rotation * (ray * (d + band)) + translation;
+            const Eigen::Vector3d direction = p1 - p0;
+            Eigen::Vector3i index = LocateVolumeUnit(p0);
+            const Eigen::Vector3i end_index = LocateVolumeUnit(p1);
+            // t_max(k) is the segment parameter of the next unit face along
+            // axis k, t_delta(k) the parameter length of a unit.
+            Eigen::Vector3i step;
+            Eigen::Vector3d t_max, t_delta;
+            for (int k = 0; k < 3; k++) {
+                if (direction(k) > 0.0) {
+                    step(k) = 1;
+                    t_max(k) = ((index(k) + 1) * volume_unit_length_ - p0(k)) /
+                               direction(k);
+                    t_delta(k) = volume_unit_length_ / direction(k);
+                } else if (direction(k) < 0.0) {
+                    step(k) = -1;
+                    t_max(k) = (index(k) * volume_unit_length_ - p0(k)) /
+                               direction(k);
+                    t_delta(k) = -volume_unit_length_ / direction(k);
+                } else {
+                    step(k) = 0;
+                    t_max(k) = std::numeric_limits<double>::infinity();
+                    t_delta(k) = std::numeric_limits<double>::infinity();
+                }
+            }
+            if (!touched_units_.Insert(index)) {
+                num_failed++;
+            }
+            while (index != end_index) {
+                int k;
+                if (t_max.minCoeff(&k) > 1.0) {
+                    break;
+                }
+                index(k) += step(k);
+                t_max(k) += t_delta(k);
+                if (!touched_units_.Insert(index)) {
+                    num_failed++;
                 }
             }
         }
     }
+    return num_failed == 0;
+}
+
+void ScalableTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
+        const geometry::RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        const geometry::Image &depth_to_camera_distance_multiplier) {
+    // Allocation: the units crossed by the truncation band of the sampled
+    // rays are collected in a set shared by all threads, then sorted, so
+    // that they are opened in the same order on every run. The set is kept
+    // from frame to frame and grows on demand: a frame whose units do not fit
+    // is traversed again with twice the room, up to the room that every
+    // sampled ray needs.
+    const int stride = (std::max)(depth_sampling_stride_, 1);
+    const int num_cols = (intrinsic.width_ + stride - 1) / stride;
+    const int num_rows = (intrinsic.height_ + stride - 1) / stride;
+    // A segment of length 2 * sdf_trunc_ crosses at most
+    // floor(2 * sdf_trunc_ / volume_unit_length_) + 1 unit faces per axis.
+    const size_t max_units_per_ray =
+            4 + 3 * size_t(2.0 * sdf_trunc_ / volume_unit_length_);
+    const size_t max_touched_units =
+            size_t(num_cols) * num_rows * max_units_per_ray;
+    while (!InsertTouchedVolumeUnits(image, intrinsic, extrinsic)) {
+        touched_units_.Reset((std::min)(
+                (std::max)(2 * touched_units_.GetMaxSize(), size_t(1024)),
+                max_touched_units));
+    }
+    std::vector<Eigen::Vector3i> touched_indices =
+            touched_units_.ExtractIndices();
+    // Keeps the load factor of the next frame at most 0.5.
+    if (touched_indices.size() > touched_units_.GetMaxSize()) {
+        touched_units_.Reset(2 * touched_indices.size());
+    }
+    std::sort(touched_indices.begin(), touched_indices.end(), IndexLess);
+
+    // Opening units may grow the hash map and the block pool, which is done
+    // on one thread and in sorted order, so that the handles and blocks are
+    // the same on every run. Paged out units are loaded back.
+    access_tick_++;
+    std::vector<int> touched_blocks(touched_indices.size());
+    for (size_t i = 0; i < touched_indices.size(); i++) {
+        touched_blocks[i] =
+                volume_units_[OpenVolumeUnit(touched_indices[i])].block_;
+    }
+    dirty_units_.insert(touched_indices.begin(), touched_indices.end());
+
+    // Integration: a single parallel pass in which each thread integrates
+    // whole units, instead of one parallel region per unit.
+    const int num_columns = volume_unit_resolution_ * volume_unit_resolution_;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < (int)touched_blocks.size(); i++) {
+        IntegrateTSDFColumns(
+                image, intrinsic, extrinsic,
+                depth_to_camera_distance_multiplier,
+                voxel_length_, sdf_trunc_,
+                touched_indices[i].cast<double>() * volume_unit_length_,
+                volume_unit_resolution_,
+                size_t(touched_blocks[i]) * GetVoxelsPerUnit(), 0, num_columns,
+                block_pool_);
+    }
+
+    if (IsPagingEnabled()) {
+        const Eigen::Vector3d camera_center =
+                -extrinsic.block<3, 3>(0, 0).transpose() *
+                extrinsic.block<3, 1>(0, 3);
+        const std::unordered_set<Eigen::Vector3i,
+                                 utility::hash_eigen::hash<Eigen::Vector3i>>
+                pinned(touched_indices.begin(), touched_indices.end());
+        EnforcePagingLimits(&camera_center, &pinned);
+    }
 }
 
 std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
     auto pointcloud = std::make_shared<geometry::PointCloud>();
     double half_voxel_length = voxel_length_ * 0.5;
     float w0, w1, f0, f1;
-    Eigen::Vector3f c0, c1;
-    for (const auto &unit : volume_units_) {
-        if (unit.second.volume_) {
-            const auto &volume0 = *unit.second.volume_;
-            const auto &index0 = unit.second.index_;
-            for (int x = 0; x < volume0.resolution_; x++) {
-                for (int y = 0; y < volume0.resolution_; y++) {
-                    for (int z = 0; z < volume0.resolution_; z++) {
+    Eigen::Vector3d c0, c1;
+    // The normals are sampled in the units around each unit.
+    const auto indices = GetVolumeUnitIndices();
+    const size_t batch_size = GetVolumeUnitBatchSize(Neighborhood::All);
+    for (size_t begin = 0; begin < indices.size(); begin += batch_size) {
+        const size_t end = (std::min)(begin + batch_size, indices.size());
+        PrepareVolumeUnitBatch(indices, begin, end, Neighborhood::All);
+        for (size_t n = begin; n < end; n++) {
+            const auto &index0 = indices[n];
+            const size_t offset0 = size_t(GetVoxelOffset(index0));
+            for (int x = 0; x < volume_unit_resolution_; x++) {
+                for (int y = 0; y < volume_unit_resolution_; y++) {
+                    for (int z = 0; z < volume_unit_resolution_; z++) {
                         Eigen::Vector3i idx0(x, y, z);
-                        w0 = volume0.voxels_[volume0.IndexOf(idx0)].weight_;
-                        f0 = volume0.voxels_[volume0.IndexOf(idx0)].tsdf_;
+                        size_t ind0 = offset0 + VoxelIndexOf(x, y, z);
+                        w0 = block_pool_.weight_[ind0];
+                        f0 = block_pool_.tsdf_[ind0];
                         if (color_type_ != TSDFVolumeColorType::NoColor)
-                            c0 = volume0.voxels_[volume0.IndexOf(idx0)]
-                                         .color_.cast<float>();
+                            c0 = block_pool_.GetColor(ind0);
                         if (w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f) {
                             Eigen::Vector3d p0 =
                                     Eigen::Vector3d(half_voxel_length +
@@ -138,39 +382,24 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
                                 Eigen::Vector3i index1 = index0;
                                 p1(i) += voxel_length_;
                                 idx1(i) += 1;
-                                if (idx1(i) < volume0.resolution_) {
-                                    w1 = volume0.voxels_[volume0.IndexOf(idx1)]
-                                                 .weight_;
-                                    f1 = volume0.voxels_[volume0.IndexOf(idx1)]
-                                                 .tsdf_;
+                                int64_t offset1 = int64_t(offset0);
+                                if (idx1(i) >= volume_unit_resolution_) {
+                                    idx1(i) -= volume_unit_resolution_;
+                                    index1(i) += 1;
+                                    offset1 = GetVoxelOffset(index1);
+                                }
+                                if (offset1 < 0) {
+                                    w1 = 0.0f;
+                                    f1 = 0.0f;
+                                } else {
+                                    size_t ind1 = size_t(offset1) +
+                                                  VoxelIndexOf(idx1(0), idx1(1),
+                                                               idx1(2));
+                                    w1 = block_pool_.weight_[ind1];
+                                    f1 = block_pool_.tsdf_[ind1];
                                     if (color_type_ !=
                                         TSDFVolumeColorType::NoColor)
-                                        c1 = volume0.voxels_[volume0.IndexOf(
-                                                                     idx1)]
-                                                     .color_.cast<float>();
-                                } else {
-                                    idx1(i) -= volume0.resolution_;
-                                    index1(i) += 1;
-                                    auto unit_itr = volume_units_.find(index1);
-                                    if (unit_itr == volume_units_.end()) {
-                                        w1 = 0.0f;
-                                        f1 = 0.0f;
-                                    } else {
-                                        const auto &volume1 =
-                                                *unit_itr->second.volume_;
-                                        w1 = volume1.voxels_[volume1.IndexOf(
-                                                                     idx1)]
-                                                     .weight_;
-                                        f1 = volume1.voxels_[volume1.IndexOf(
-                                                                     idx1)]
-                                                     .tsdf_;
-                                        if (color_type_ !=
-                                            TSDFVolumeColorType::NoColor)
-                                            c1 = volume1.voxels_
-                                                         [volume1.IndexOf(idx1)]
-                                                                 .color_
-                                                                 .cast<float>();
-                                    }
+                                        c1 = block_pool_.GetColor(ind1);
                                 }
                                 if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
                                     f0 * f1 < 0) {
@@ -180,18 +409,11 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
                                     p(i) = (p0(i) * r1 + p1(i) * r0) /
                                            (r0 + r1);
                                     pointcloud->points_.push_back(p);
-                                    if (color_type_ ==
-                                        TSDFVolumeColorType::RGB8) {
-                                        pointcloud->colors_.push_back(
-                                                ((c0 * r1 + c1 * r0) /
-                                                 (r0 + r1) / 255.0f)
-                                                        .cast<double>());
-                                    } else if (color_type_ ==
-                                               TSDFVolumeColorType::Gray32) {
+                                    if (color_type_ !=
+                                        TSDFVolumeColorType::NoColor) {
                                         pointcloud->colors_.push_back(
-                                                ((c0 * r1 + c1 * r0) /
-                                                 (r0 + r1))
-                                                        .cast<double>());
+                                                (c0 * r1 + c1 * r0) /
+                                                (r0 + r1));
                                     }
                                     // has_normal
                                     pointcloud->normals_.push_back(
@@ -203,182 +425,682 @@ std::shared_ptr<geometry::PointCloud> ScalableTSDFVolume::ExtractPointCloud() {
                 }
             }
         }
+        EnforcePagingLimits(nullptr, nullptr);
     }
     return pointcloud;
 }
 
 std::shared_ptr<geometry::TriangleMesh>
 ScalableTSDFVolume::ExtractTriangleMesh() {
-    // implementation of marching cubes, based on
-    // http://paulbourke.net/geometry/polygonise/
-    auto mesh = std::make_shared<geometry::TriangleMesh>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
+    // Each unit is meshed as an independent block, and the vertices shared
+    // by neighbor units are stitched afterwards.
+    const auto indices = GetVolumeUnitIndices();
+    const size_t batch_size = GetVolumeUnitBatchSize(Neighborhood::Forward);
+    std::vector<MarchingCubesChunk> chunks(indices.size());
+    for (size_t begin = 0; begin < indices.size(); begin += batch_size) {
+        const size_t end = (std::min)(begin + batch_size, indices.size());
+        PrepareVolumeUnitBatch(indices, begin, end, Neighborhood::Forward);
+#ifdef _OPENMP
+#pragma omp parallel
+        {
+#endif
+            std::vector<int> edge_to_vertex;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int i = (int)begin; i < (int)end; i++) {
+                ExtractVolumeUnitMesh(indices[i], edge_to_vertex, chunks[i]);
+            }
+#ifdef _OPENMP
+        }
+#endif
+        EnforcePagingLimits(nullptr, nullptr);
+    }
+    return MergeMarchingCubesChunks(chunks);
+}
+
+std::shared_ptr<RaycastResult> ScalableTSDFVolume::Raycast(
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        double depth_min /* = 0.1*/,
+        double depth_max /* = 3.0*/) {
+    const Eigen::Vector3d half_voxel =
+            Eigen::Vector3d::Constant(voxel_length_ * 0.5);
+    // Block skip: a ray entering a unit that is not allocated, or paged out,
+    // jumps to the point where it leaves the unit.
+    auto sample = [&](const Eigen::Vector3d &p,
+                      const Eigen::Vector3d &direction, float &tsdf,
+                      double &skip) -> bool {
+        const Eigen::Vector3d p_locate = p - half_voxel;
+        const Eigen::Vector3i index = LocateVolumeUnit(p_locate);
+        if (GetVoxelOffset(index) < 0) {
+            skip = std::numeric_limits<double>::max();
+            for (int k = 0; k < 3; k++) {
+                if (direction(k) == 0.0) {
+                    continue;
+                }
+                double bound = (index(k) + (direction(k) > 0.0 ? 1 : 0)) *
+                               volume_unit_length_;
+                skip = (std::min)(skip, (bound - p_locate(k)) / direction(k));
+            }
+            skip = (std::max)(skip, 0.0) + 0.01 * voxel_length_;
+            return false;
+        }
+        skip = sdf_trunc_;
+        return InterpolateTSDF(p, tsdf, nullptr);
+    };
+    auto shade = [&](const Eigen::Vector3d &p, Eigen::Vector3d &normal,
+                     Eigen::Vector3d &color) -> bool {
+        float tsdf;
+        if (!InterpolateTSDF(p, tsdf, &color)) {
+            color.setZero();
+        }
+        normal = GetNormalAt(p);
+        return std::isfinite(normal(0)) && std::isfinite(normal(1)) &&
+               std::isfinite(normal(2));
+    };
+    if (volume_units_.empty()) {
+        return RaycastTSDF(sample, shade, Eigen::Vector3d::Zero(),
+                           Eigen::Vector3d::Constant(-1.0), voxel_length_,
+                           sdf_trunc_, color_type_, intrinsic, extrinsic,
+                           depth_min, depth_max);
+    }
+    Eigen::Vector3i min_index = volume_units_[0].index_;
+    Eigen::Vector3i max_index = min_index;
     for (const auto &unit : volume_units_) {
-        if (unit.second.volume_) {
-            const auto &volume0 = *unit.second.volume_;
-            const auto &index0 = unit.second.index_;
-            for (int x = 0; x < volume0.resolution_; x++) {
-                for (int y = 0; y < volume0.resolution_; y++) {
-                    for (int z = 0; z < volume0.resolution_; z++) {
-                        Eigen::Vector3i idx0(x, y, z);
-                        int cube_index = 0;
-                        float w[8];
-                        float f[8];
-                        Eigen::Vector3d c[8];
-                        for (int i = 0; i < 8; i++) {
-                            Eigen::Vector3i index1 = index0;
-                            Eigen::Vector3i idx1 = idx0 + shift[i];
-                            if (idx1(0) < volume_unit_resolution_ &&
-                                idx1(1) < volume_unit_resolution_ &&
-                                idx1(2) < volume_unit_resolution_) {
-                                w[i] = volume0.voxels_[volume0.IndexOf(idx1)]
-                                               .weight_;
-                                f[i] = volume0.voxels_[volume0.IndexOf(idx1)]
-                                               .tsdf_;
-                                if (color_type_ == TSDFVolumeColorType::RGB8)
-                                    c[i] = volume0.voxels_[volume0.IndexOf(
-                                                                   idx1)]
-                                                   .color_.cast<double>() /
-                                           255.0;
-                                else if (color_type_ ==
-                                         TSDFVolumeColorType::Gray32)
-                                    c[i] = volume0.voxels_[volume0.IndexOf(
-                                                                   idx1)]
-                                                   .color_.cast<double>();
-                            } else {
-                                for (int j = 0; j < 3; j++) {
-                                    if (idx1(j) >= volume_unit_resolution_) {
-                                        idx1(j) -= volume_unit_resolution_;
-                                        index1(j) += 1;
-                                    }
-                                }
-                                auto unit_itr1 = volume_units_.find(index1);
-                                if (unit_itr1 == volume_units_.end()) {
-                                    w[i] = 0.0f;
-                                    f[i] = 0.0f;
-                                } else {
-                                    const auto &volume1 =
-                                            *unit_itr1->second.volume_;
-                                    w[i] = volume1.voxels_[volume1.IndexOf(
-                                                                   idx1)]
-                                                   .weight_;
-                                    f[i] = volume1.voxels_[volume1.IndexOf(
-                                                                   idx1)]
-                                                   .tsdf_;
-                                    if (color_type_ ==
-                                        TSDFVolumeColorType::RGB8)
-                                        c[i] = volume1.voxels_[volume1.IndexOf(
-                                                                       idx1)]
-                                                       .color_.cast<double>() /
-                                               255.0;
-                                    else if (color_type_ ==
-                                             TSDFVolumeColorType::Gray32)
-                                        c[i] = volume1.voxels_[volume1.IndexOf(
-                                                                       idx1)]
-                                                       .color_.cast<double>();
-                                }
-                            }
-                            if (w[i] == 0.0f) {
-                                cube_index = 0;
-                                break;
-                            } else {
-                                if (f[i] < 0.0f) {
-                                    cube_index |= (1 << i);
-                                }
-                            }
-                        }
-                        if (cube_index == 0 || cube_index == 255) {
+        min_index = min_index.cwiseMin(unit.index_);
+        max_index = max_index.cwiseMax(unit.index_);
+    }
+    return RaycastTSDF(
+            sample, shade,
+            min_index.cast<double>() * volume_unit_length_ + half_voxel,
+            (max_index.cast<double>().array() + 1.0) * volume_unit_length_ +
+                    half_voxel.array(),
+            voxel_length_, sdf_trunc_, color_type_, intrinsic, extrinsic,
+            depth_min, depth_max);
+}
+
+std::shared_ptr<geometry::PointCloud>
+ScalableTSDFVolume::ExtractVoxelPointCloud() {
+    auto voxel = std::make_shared<geometry::PointCloud>();
+    const Eigen::Vector3d half_voxel =
+            Eigen::Vector3d::Constant(voxel_length_ * 0.5);
+    const auto indices = GetVolumeUnitIndices();
+    const size_t batch_size = GetVolumeUnitBatchSize(Neighborhood::None);
+    for (size_t begin = 0; begin < indices.size(); begin += batch_size) {
+        const size_t end = (std::min)(begin + batch_size, indices.size());
+        PrepareVolumeUnitBatch(indices, begin, end, Neighborhood::None);
+        for (size_t i = begin; i < end; i++) {
+            const size_t offset = size_t(GetVoxelOffset(indices[i]));
+            const Eigen::Vector3d origin =
+                    indices[i].cast<double>() * volume_unit_length_;
+            for (int x = 0; x < volume_unit_resolution_; x++) {
+                for (int y = 0; y < volume_unit_resolution_; y++) {
+                    for (int z = 0; z < volume_unit_resolution_; z++) {
+                        const size_t ind = offset + VoxelIndexOf(x, y, z);
+                        const float w = block_pool_.weight_[ind];
+                        const float f = block_pool_.tsdf_[ind];
+                        if (!(w != 0.0f && f < 0.98f && f >= -0.98f)) {
                             continue;
                         }
-                        for (int i = 0; i < 12; i++) {
-                            if (edge_table[cube_index] & (1 << i)) {
-                                Eigen::Vector4i edge_index =
-                                        Eigen::Vector4i(index0(0), index0(1),
-                                                        index0(2), 0) *
-                                                volume_unit_resolution_ +
-                                        Eigen::Vector4i(x, y, z, 0) +
-                                        edge_shift[i];
-                                if (edgeindex_to_vertexindex.find(edge_index) ==
-                                    edgeindex_to_vertexindex.end()) {
-                                    edge_to_index[i] =
-                                            (int)mesh->vertices_.size();
-                                    edgeindex_to_vertexindex[edge_index] =
-                                            (int)mesh->vertices_.size();
-                                    Eigen::Vector3d pt(
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(0),
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(1),
-                                            half_voxel_length +
-                                                    voxel_length_ *
-                                                            edge_index(2));
-                                    double f0 = std::abs(
-                                            (double)f[edge_to_vert[i][0]]);
-                                    double f1 = std::abs(
-                                            (double)f[edge_to_vert[i][1]]);
-                                    pt(edge_index(3)) +=
-                                            f0 * voxel_length_ / (f0 + f1);
-                                    mesh->vertices_.push_back(pt);
-                                    if (color_type_ !=
-                                        TSDFVolumeColorType::NoColor) {
-                                        const auto &c0 = c[edge_to_vert[i][0]];
-                                        const auto &c1 = c[edge_to_vert[i][1]];
-                                        mesh->vertex_colors_.push_back(
-                                                (f1 * c0 + f0 * c1) /
-                                                (f0 + f1));
-                                    }
-                                } else {
-                                    edge_to_index[i] = edgeindex_to_vertexindex
-                                            [edge_index];
-                                }
-                            }
-                        }
-                        for (int i = 0; tri_table[cube_index][i] != -1;
-                             i += 3) {
-                            mesh->triangles_.push_back(Eigen::Vector3i(
-                                    edge_to_index[tri_table[cube_index][i]],
-                                    edge_to_index[tri_table[cube_index][i + 2]],
-                                    edge_to_index[tri_table[cube_index]
-                                                           [i + 1]]));
-                        }
+                        voxel->points_.push_back(
+                                origin + half_voxel +
+                                voxel_length_ * Eigen::Vector3d(x, y, z));
+                        double c = (f + 1.0) * 0.5;
+                        voxel->colors_.push_back(Eigen::Vector3d(c, c, c));
                     }
                 }
             }
         }
+        EnforcePagingLimits(nullptr, nullptr);
     }
-    return mesh;
+    return voxel;
 }
 
-std::shared_ptr<geometry::PointCloud>
-ScalableTSDFVolume::ExtractVoxelPointCloud() {
-    auto voxel = std::make_shared<geometry::PointCloud>();
+std::vector<std::pair<Eigen::Vector3i, std::shared_ptr<geometry::TriangleMesh>>>
+ScalableTSDFVolume::ExtractDirtyTriangleMeshes() {
+    // The cubes of a unit reach into the units at +x, +y and +z, so a change
+    // in a unit also invalidates the units at -x, -y and -z.
+    std::vector<Eigen::Vector3i> indices;
+    for (const auto &index : dirty_units_) {
+        for (int n = 0; n < 8; n++) {
+            Eigen::Vector3i index0 =
+                    index - Eigen::Vector3i(n & 1, (n >> 1) & 1, (n >> 2) & 1);
+            if (volume_unit_map_.Find(index0) >= 0) {
+                indices.push_back(index0);
+            }
+        }
+    }
+    dirty_units_.clear();
+    std::sort(indices.begin(), indices.end(), IndexLess);
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+    std::vector<std::pair<Eigen::Vector3i,
+                          std::shared_ptr<geometry::TriangleMesh>>>
+            meshes(indices.size());
+    const size_t batch_size = GetVolumeUnitBatchSize(Neighborhood::Forward);
+    for (size_t begin = 0; begin < indices.size(); begin += batch_size) {
+        const size_t end = (std::min)(begin + batch_size, indices.size());
+        PrepareVolumeUnitBatch(indices, begin, end, Neighborhood::Forward);
+#ifdef _OPENMP
+#pragma omp parallel
+        {
+#endif
+            std::vector<int> edge_to_vertex;
+            MarchingCubesChunk chunk;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+            for (int i = (int)begin; i < (int)end; i++) {
+                ExtractVolumeUnitMesh(indices[i], edge_to_vertex, chunk);
+                meshes[i].first = indices[i];
+                meshes[i].second =
+                        std::make_shared<geometry::TriangleMesh>(chunk.mesh_);
+            }
+#ifdef _OPENMP
+        }
+#endif
+        EnforcePagingLimits(nullptr, nullptr);
+    }
+    return meshes;
+}
+
+bool ScalableTSDFVolume::EnablePaging(const std::string &directory,
+                                      size_t memory_budget,
+                                      double working_radius /* = 0.0*/) {
+    if (directory.empty() ||
+        (!utility::filesystem::DirectoryExists(directory) &&
+         !utility::filesystem::MakeDirectoryHierarchy(directory))) {
+        utility::LogWarning(
+                "[ScalableTSDFVolume::EnablePaging] Unable to create "
+                "directory {}.",
+                directory);
+        return false;
+    }
+    const std::string paging_root =
+            utility::filesystem::GetRegularizedDirectoryName(directory);
+    if (IsPagingEnabled() && paging_root != paging_root_) {
+        DisablePaging();
+    }
+    if (!IsPagingEnabled()) {
+        paging_directory_ = MakeUniqueDirectory(paging_root);
+        if (paging_directory_.empty()) {
+            utility::LogWarning(
+                    "[ScalableTSDFVolume::EnablePaging] Unable to create a "
+                    "page directory in {}.",
+                    paging_root);
+            return false;
+        }
+        paging_root_ = paging_root;
+    }
+    paging_memory_budget_ = memory_budget;
+    paging_working_radius_ = working_radius;
+    EnforcePagingLimits(nullptr, nullptr);
+    return true;
+}
+
+void ScalableTSDFVolume::DisablePaging() {
+    if (!IsPagingEnabled()) {
+        return;
+    }
     for (auto &unit : volume_units_) {
-        if (unit.second.volume_) {
-            auto v = unit.second.volume_->ExtractVoxelPointCloud();
-            *voxel += *v;
+        if (unit.block_ < 0) {
+            LoadVolumeUnit(unit);
         }
     }
-    return voxel;
+    utility::filesystem::DeleteDirectory(paging_directory_);
+    paging_root_.clear();
+    paging_directory_.clear();
+    paging_memory_budget_ = 0;
+    paging_working_radius_ = 0.0;
+}
+
+size_t ScalableTSDFVolume::GetResidentMemorySize() const {
+    size_t num_resident = 0;
+    for (const auto &unit : volume_units_) {
+        if (unit.block_ >= 0) {
+            num_resident++;
+        }
+    }
+    return num_resident * GetVolumeUnitMemorySize();
+}
+
+bool ScalableTSDFVolume::WriteToFile(const std::string &filename) const {
+    FILE *file = utility::filesystem::FOpen(filename, "wb");
+    if (file == NULL) {
+        utility::LogWarning(
+                "Write ScalableTSDFVolume failed: unable to open file: {}",
+                filename);
+        return false;
+    }
+    bool success = fwrite(kVolumeFileMagic, 1, 8, file) == 8 &&
+                   WriteValue(file, kVolumeFileVersion) &&
+                   WriteValue(file, int32_t(color_type_)) &&
+                   WriteValue(file, int32_t(volume_unit_resolution_)) &&
+                   WriteValue(file, voxel_length_) &&
+                   WriteValue(file, sdf_trunc_) &&
+                   WriteValue(file, uint64_t(volume_units_.size()));
+    // Paged out units are read into a scratch array, the resident set is not
+    // changed.
+    TSDFVoxelArray scratch(color_type_, GetVoxelsPerUnit());
+    for (const auto &index : GetVolumeUnitIndices()) {
+        if (!success) {
+            break;
+        }
+        const int64_t offset = GetVoxelOffset(index);
+        if (offset >= 0) {
+            success = WriteVolumeUnit(file, index, block_pool_, size_t(offset));
+            continue;
+        }
+        FILE *page = utility::filesystem::FOpen(GetPageFilename(index), "rb");
+        Eigen::Vector3i page_index;
+        success = page != NULL &&
+                  ReadVolumeUnit(page, page_index, scratch, 0) &&
+                  page_index == index &&
+                  WriteVolumeUnit(file, index, scratch, 0);
+        if (page != NULL) {
+            fclose(page);
+        }
+    }
+    fclose(file);
+    if (!success) {
+        utility::LogWarning(
+                "Write ScalableTSDFVolume failed: unexpected error.");
+    }
+    return success;
+}
+
+bool ScalableTSDFVolume::ReadFromFile(const std::string &filename) {
+    FILE *file = utility::filesystem::FOpen(filename, "rb");
+    if (file == NULL) {
+        utility::LogWarning(
+                "Read ScalableTSDFVolume failed: unable to open file: {}",
+                filename);
+        return false;
+    }
+    char magic[8];
+    uint32_t version;
+    int32_t color_type, unit_resolution;
+    double voxel_length, sdf_trunc;
+    uint64_t num_units;
+    if (fread(magic, 1, 8, file) != 8 || !ReadValue(file, version) ||
+        !ReadValue(file, color_type) || !ReadValue(file, unit_resolution) ||
+        !ReadValue(file, voxel_length) || !ReadValue(file, sdf_trunc) ||
+        !ReadValue(file, num_units)) {
+        utility::LogWarning("Read ScalableTSDFVolume failed: unexpected EOF.");
+        fclose(file);
+        return false;
+    }
+    if (!std::equal(magic, magic + 8, kVolumeFileMagic) ||
+        version != kVolumeFileVersion) {
+        utility::LogWarning(
+                "Read ScalableTSDFVolume failed: unknown file format.");
+        fclose(file);
+        return false;
+    }
+    if (color_type != int32_t(color_type_) ||
+        unit_resolution != volume_unit_resolution_ ||
+        voxel_length != voxel_length_ || sdf_trunc != sdf_trunc_) {
+        utility::LogWarning(
+                "Read ScalableTSDFVolume failed: the volume parameters do not "
+                "match.");
+        fclose(file);
+        return false;
+    }
+    Reset();
+    // Large volumes are paged out while they are read, once the memory budget
+    // is used up.
+    size_t max_resident = std::numeric_limits<size_t>::max();
+    if (IsPagingEnabled() && paging_memory_budget_ > 0) {
+        max_resident = paging_memory_budget_ / GetVolumeUnitMemorySize();
+    }
+    size_t num_resident = 0;
+    bool success = true;
+    for (uint64_t i = 0; i < num_units && success; i++) {
+        Eigen::Vector3i index;
+        const int block = AllocateBlock();
+        success = ReadVolumeUnit(file, index, block_pool_,
+                                 size_t(block) * GetVoxelsPerUnit()) &&
+                  volume_unit_map_.Find(index) < 0;
+        if (success) {
+            bool inserted;
+            volume_unit_map_.Reserve(volume_units_.size() + 1);
+            volume_unit_map_.Insert(index, inserted);
+            volume_units_.push_back(VolumeUnit());
+            auto &unit = volume_units_.back();
+            unit.index_ = index;
+            unit.block_ = block;
+            dirty_units_.insert(index);
+            if (num_resident < max_resident || !PageOutVolumeUnit(unit)) {
+                num_resident++;
+            }
+        }
+    }
+    fclose(file);
+    if (!success) {
+        utility::LogWarning("Read ScalableTSDFVolume failed: unexpected EOF.");
+        Reset();
+    }
+    return success;
+}
+
+int ScalableTSDFVolume::OpenVolumeUnit(const Eigen::Vector3i &index) {
+    volume_unit_map_.Reserve(volume_units_.size() + 1);
+    bool inserted;
+    const int handle = volume_unit_map_.Insert(index, inserted);
+    if (inserted) {
+        // Handles are dense and units are only added here and in
+        // ReadFromFile(), one at a time.
+        volume_units_.push_back(VolumeUnit());
+        volume_units_[handle].index_ = index;
+        volume_units_[handle].block_ = AllocateBlock();
+    } else if (volume_units_[handle].block_ < 0) {
+        LoadVolumeUnit(volume_units_[handle]);
+    }
+    auto &unit = volume_units_[handle];
+    unit.last_access_ = access_tick_;
+    unit.num_accesses_++;
+    return handle;
+}
+
+int ScalableTSDFVolume::AllocateBlock() {
+    const size_t voxels_per_unit = GetVoxelsPerUnit();
+    if (!free_blocks_.empty()) {
+        const int block = free_blocks_.back();
+        free_blocks_.pop_back();
+        block_pool_.Reset(size_t(block) * voxels_per_unit, voxels_per_unit);
+        return block;
+    }
+    const int block = int(block_pool_.size() / voxels_per_unit);
+    block_pool_.Resize(block_pool_.size() + voxels_per_unit);
+    return block;
+}
+
+std::vector<Eigen::Vector3i> ScalableTSDFVolume::GetVolumeUnitIndices() const {
+    std::vector<Eigen::Vector3i> indices;
+    indices.reserve(volume_units_.size());
+    for (const auto &unit : volume_units_) {
+        indices.push_back(unit.index_);
+    }
+    std::sort(indices.begin(), indices.end(), IndexLess);
+    return indices;
+}
+
+size_t ScalableTSDFVolume::GetVolumeUnitMemorySize() const {
+    return GetVoxelsPerUnit() * block_pool_.BytesPerVoxel();
+}
+
+size_t ScalableTSDFVolume::GetVolumeUnitBatchSize(
+        Neighborhood neighborhood) const {
+    if (!IsPagingEnabled() || paging_memory_budget_ == 0) {
+        return (std::max)(volume_units_.size(), size_t(1));
+    }
+    const size_t max_resident =
+            paging_memory_budget_ / GetVolumeUnitMemorySize();
+    // Neighbor units are shared by the units of a batch, the estimate assumes
+    // they are not.
+    size_t units_per_item = 27;
+    if (neighborhood == Neighborhood::None) {
+        units_per_item = 1;
+    } else if (neighborhood == Neighborhood::Forward) {
+        units_per_item = 8;
+    }
+    return (std::max)(max_resident / units_per_item, size_t(1));
+}
+
+void ScalableTSDFVolume::PrepareVolumeUnitBatch(
+        const std::vector<Eigen::Vector3i> &indices,
+        size_t begin,
+        size_t end,
+        Neighborhood neighborhood) {
+    access_tick_++;
+    const int offset_min = neighborhood == Neighborhood::All ? -1 : 0;
+    const int offset_max = neighborhood == Neighborhood::None ? 0 : 1;
+    for (size_t i = begin; i < end; i++) {
+        for (int x = offset_min; x <= offset_max; x++) {
+            for (int y = offset_min; y <= offset_max; y++) {
+                for (int z = offset_min; z <= offset_max; z++) {
+                    const int handle = volume_unit_map_.Find(
+                            indices[i] + Eigen::Vector3i(x, y, z));
+                    if (handle < 0) {
+                        continue;
+                    }
+                    auto &unit = volume_units_[handle];
+                    if (unit.block_ < 0) {
+                        LoadVolumeUnit(unit);
+                    }
+                    if (unit.last_access_ != access_tick_) {
+                        unit.last_access_ = access_tick_;
+                        unit.num_accesses_++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ScalableTSDFVolume::EnforcePagingLimits(
+        const Eigen::Vector3d *camera_center,
+        const std::unordered_set<Eigen::Vector3i,
+                                 utility::hash_eigen::hash<Eigen::Vector3i>>
+                *pinned) {
+    if (!IsPagingEnabled()) {
+        return;
+    }
+    size_t num_resident = 0, num_out_of_range = 0, num_evicted = 0;
+    std::vector<VolumeUnit *> candidates;
+    for (auto &unit : volume_units_) {
+        if (unit.block_ < 0) {
+            continue;
+        }
+        num_resident++;
+        if (pinned != nullptr && pinned->count(unit.index_) > 0) {
+            continue;
+        }
+        if (camera_center != nullptr && paging_working_radius_ > 0.0) {
+            const Eigen::Vector3d center =
+                    (unit.index_.cast<double>().array() + 0.5) *
+                    volume_unit_length_;
+            if ((center - *camera_center).norm() > paging_working_radius_) {
+                if (PageOutVolumeUnit(unit)) {
+                    num_resident--;
+                    num_out_of_range++;
+                }
+                continue;
+            }
+        }
+        candidates.push_back(&unit);
+    }
+    if (paging_memory_budget_ > 0) {
+        const size_t max_resident =
+                paging_memory_budget_ / GetVolumeUnitMemorySize();
+        if (num_resident > max_resident) {
+            // Least recently used first, ties are broken by index so that the
+            // same units are paged out on every run.
+            std::sort(candidates.begin(), candidates.end(),
+                      [](const VolumeUnit *a, const VolumeUnit *b) {
+                          if (a->last_access_ != b->last_access_) {
+                              return a->last_access_ < b->last_access_;
+                          }
+                          return IndexLess(a->index_, b->index_);
+                      });
+            for (size_t i = 0;
+                 i < candidates.size() && num_resident > max_resident; i++) {
+                if (PageOutVolumeUnit(*candidates[i])) {
+                    num_resident--;
+                    num_evicted++;
+                }
+            }
+        }
+        if (num_resident > max_resident) {
+            utility::LogDebug(
+                    "[ScalableTSDFVolume] {:d} units in use exceed the memory "
+                    "budget of {:d} units.",
+                    num_resident, max_resident);
+        }
+    }
+    if (num_out_of_range + num_evicted > 0) {
+        utility::LogDebug(
+                "[ScalableTSDFVolume] Paged out {:d} units out of range and "
+                "{:d} least recently used units, {:d} units resident.",
+                num_out_of_range, num_evicted, num_resident);
+    }
+}
+
+std::string ScalableTSDFVolume::GetPageFilename(
+        const Eigen::Vector3i &index) const {
+    return paging_directory_ + std::to_string(index(0)) + "_" +
+           std::to_string(index(1)) + "_" + std::to_string(index(2)) + ".bin";
+}
+
+bool ScalableTSDFVolume::CopyPagingDirectory(const ScalableTSDFVolume &other) {
+    paging_root_ = other.paging_root_;
+    paging_directory_ = MakeUniqueDirectory(paging_root_);
+    if (paging_directory_.empty()) {
+        paging_root_.clear();
+        return false;
+    }
+    bool success = true;
+    for (const auto &unit : volume_units_) {
+        if (unit.block_ < 0) {
+            success = CopyPageFile(other.GetPageFilename(unit.index_),
+                               GetPageFilename(unit.index_)) &&
+                      success;
+        }
+    }
+    if (!success) {
+        RemovePagingDirectory();
+    }
+    return success;
+}
+
+void ScalableTSDFVolume::RemovePagingDirectory() {
+    if (!IsPagingEnabled()) {
+        return;
+    }
+    for (const auto &unit : volume_units_) {
+        if (unit.block_ < 0) {
+            utility::filesystem::RemoveFile(GetPageFilename(unit.index_));
+        }
+    }
+    utility::filesystem::DeleteDirectory(paging_directory_);
+    paging_root_.clear();
+    paging_directory_.clear();
+}
+
+bool ScalableTSDFVolume::PageOutVolumeUnit(VolumeUnit &unit) {
+    const std::string filename = GetPageFilename(unit.index_);
+    FILE *file = utility::filesystem::FOpen(filename, "wb");
+    if (file == NULL) {
+        utility::LogWarning(
+                "[ScalableTSDFVolume] Paging out failed: unable to open file: "
+                "{}",
+                filename);
+        return false;
+    }
+    const bool success =
+            WriteVolumeUnit(file, unit.index_, block_pool_,
+                            size_t(unit.block_) * GetVoxelsPerUnit());
+    fclose(file);
+    if (!success) {
+        utility::LogWarning(
+                "[ScalableTSDFVolume] Paging out failed: unable to write file: "
+                "{}",
+                filename);
+        utility::filesystem::RemoveFile(filename);
+        return false;
+    }
+    free_blocks_.push_back(unit.block_);
+    unit.block_ = -1;
+    unit.num_evictions_++;
+    return true;
+}
+
+bool ScalableTSDFVolume::LoadVolumeUnit(VolumeUnit &unit) {
+    const std::string filename = GetPageFilename(unit.index_);
+    unit.block_ = AllocateBlock();
+    unit.num_loads_++;
+    const size_t offset = size_t(unit.block_) * GetVoxelsPerUnit();
+    FILE *file = utility::filesystem::FOpen(filename, "rb");
+    Eigen::Vector3i index;
+    const bool success = file != NULL &&
+                         ReadVolumeUnit(file, index, block_pool_, offset) &&
+                         index == unit.index_;
+    if (file != NULL) {
+        fclose(file);
+    }
+    utility::filesystem::RemoveFile(filename);
+    if (!success) {
+        // The unit is kept, empty, so that the volume stays consistent.
+        utility::LogWarning(
+                "[ScalableTSDFVolume] Loading paged out unit failed: {}",
+                filename);
+        block_pool_.Reset(offset, GetVoxelsPerUnit());
+        return false;
+    }
+    return true;
 }
 
-std::shared_ptr<UniformTSDFVolume> ScalableTSDFVolume::OpenVolumeUnit(
-        const Eigen::Vector3i &index) {
-    auto &unit = volume_units_[index];
-    if (!unit.volume_) {
-        unit.volume_.reset(new UniformTSDFVolume(
-                volume_unit_length_, volume_unit_resolution_, sdf_trunc_,
-                color_type_, index.cast<double>() * volume_unit_length_));
-        unit.index_ = index;
+bool ScalableTSDFVolume::WriteVolumeUnit(FILE *file,
+                                         const Eigen::Vector3i &index,
+                                         const TSDFVoxelArray &voxels,
+                                         size_t offset) const {
+    const int32_t index_data[3] = {index(0), index(1), index(2)};
+    return fwrite(index_data, sizeof(int32_t), 3, file) == 3 &&
+           voxels.WriteToBinary(file, offset, GetVoxelsPerUnit());
+}
+
+bool ScalableTSDFVolume::ReadVolumeUnit(FILE *file,
+                                        Eigen::Vector3i &index,
+                                        TSDFVoxelArray &voxels,
+                                        size_t offset) const {
+    int32_t index_data[3];
+    if (fread(index_data, sizeof(int32_t), 3, file) != 3) {
+        return false;
+    }
+    index = Eigen::Vector3i(index_data[0], index_data[1], index_data[2]);
+    return voxels.ReadFromBinary(file, offset, GetVoxelsPerUnit());
+}
+
+void ScalableTSDFVolume::ExtractVolumeUnitMesh(
+        const Eigen::Vector3i &index,
+        std::vector<int> &edge_to_vertex,
+        MarchingCubesChunk &chunk) const {
+    const int res = volume_unit_resolution_;
+    // The last layer of cubes reaches into the units at +x, +y and +z. The
+    // unit at offset (n & 1, (n >> 1) & 1, (n >> 2) & 1) is looked up once as
+    // neighbors[n], instead of once per boundary voxel.
+    int64_t neighbors[8];
+    for (int n = 0; n < 8; n++) {
+        neighbors[n] = GetVoxelOffset(
+                index + Eigen::Vector3i(n & 1, (n >> 1) & 1, (n >> 2) & 1));
     }
-    return unit.volume_;
+    const bool with_color = color_type_ != TSDFVolumeColorType::NoColor;
+    auto get_voxel = [&](int x, int y, int z, float &tsdf,
+                         Eigen::Vector3d &color) -> bool {
+        const int64_t offset = neighbors[int(x >= res) | (int(y >= res) << 1) |
+                                         (int(z >= res) << 2)];
+        if (offset < 0) {
+            return false;
+        }
+        const size_t ind = size_t(offset) +
+                           VoxelIndexOf(x >= res ? x - res : x,
+                                        y >= res ? y - res : y,
+                                        z >= res ? z - res : z);
+        if (block_pool_.weight_[ind] == 0) {
+            return false;
+        }
+        tsdf = block_pool_.tsdf_[ind];
+        if (with_color) {
+            color = block_pool_.GetColor(ind);
+        }
+        return true;
+    };
+    const Eigen::Vector3i cube_begin = index * res;
+    ExtractMarchingCubesChunk(get_voxel, cube_begin,
+                              cube_begin + Eigen::Vector3i::Constant(res),
+                              voxel_length_, Eigen::Vector3d::Zero(),
+                              with_color, edge_to_vertex, chunk);
 }
 
 Eigen::Vector3d ScalableTSDFVolume::GetNormalAt(const Eigen::Vector3d &p) {
@@ -398,11 +1120,10 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
     Eigen::Vector3d p_locate =
             p - Eigen::Vector3d(0.5, 0.5, 0.5) * voxel_length_;
     Eigen::Vector3i index0 = LocateVolumeUnit(p_locate);
-    auto unit_itr = volume_units_.find(index0);
-    if (unit_itr == volume_units_.end()) {
+    const int64_t offset0 = GetVoxelOffset(index0);
+    if (offset0 < 0) {
         return 0.0;
     }
-    const auto &volume0 = *unit_itr->second.volume_;
     Eigen::Vector3i idx0;
     Eigen::Vector3d p_grid =
             (p_locate - index0.cast<double>() * volume_unit_length_) /
@@ -421,7 +1142,8 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
         if (idx1(0) < volume_unit_resolution_ &&
             idx1(1) < volume_unit_resolution_ &&
             idx1(2) < volume_unit_resolution_) {
-            f[i] = volume0.voxels_[volume0.IndexOf(idx1)].tsdf_;
+            f[i] = block_pool_.tsdf_[size_t(offset0) +
+                                     VoxelIndexOf(idx1(0), idx1(1), idx1(2))];
         } else {
             for (int j = 0; j < 3; j++) {
                 if (idx1(j) >= volume_unit_resolution_) {
@@ -429,12 +1151,13 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
                     index1(j) += 1;
                 }
             }
-            auto unit_itr1 = volume_units_.find(index1);
-            if (unit_itr1 == volume_units_.end()) {
+            const int64_t offset1 = GetVoxelOffset(index1);
+            if (offset1 < 0) {
                 f[i] = 0.0f;
             } else {
-                const auto &volume1 = *unit_itr1->second.volume_;
-                f[i] = volume1.voxels_[volume1.IndexOf(idx1)].tsdf_;
+                f[i] = block_pool_.tsdf_[size_t(offset1) +
+                                         VoxelIndexOf(idx1(0), idx1(1),
+                                                      idx1(2))];
             }
         }
     }
@@ -444,5 +1167,64 @@ double ScalableTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
                    r(1) * ((1 - r(2)) * f[2] + r(2) * f[6]));
 }
 
+bool ScalableTSDFVolume::InterpolateTSDF(const Eigen::Vector3d &p,
+                                         float &tsdf,
+                                         Eigen::Vector3d *color) const {
+    Eigen::Vector3d p_locate =
+            p - Eigen::Vector3d(0.5, 0.5, 0.5) * voxel_length_;
+    Eigen::Vector3i index0 = LocateVolumeUnit(p_locate);
+    Eigen::Vector3d p_grid =
+            (p_locate - index0.cast<double>() * volume_unit_length_) /
+            voxel_length_;
+    Eigen::Vector3i idx0;
+    for (int i = 0; i < 3; i++) {
+        idx0(i) = (std::max)(0, (std::min)((int)std::floor(p_grid(i)),
+                                           volume_unit_resolution_ - 1));
+    }
+    Eigen::Vector3d r = p_grid - idx0.cast<double>();
+    // The corners may lie in the units at +x, +y and +z, each unit is looked
+    // up once.
+    int64_t neighbors[8] = {-1, -1, -1, -1, -1, -1, -1, -1};
+    bool looked_up[8] = {false};
+    double sum = 0.0;
+    Eigen::Vector3d color_sum(0, 0, 0);
+    for (int i = 0; i < 8; i++) {
+        Eigen::Vector3i idx1 = idx0 + shift[i];
+        int n = 0;
+        for (int j = 0; j < 3; j++) {
+            if (idx1(j) >= volume_unit_resolution_) {
+                idx1(j) -= volume_unit_resolution_;
+                n |= 1 << j;
+            }
+        }
+        if (!looked_up[n]) {
+            neighbors[n] = GetVoxelOffset(
+                    index0 +
+                    Eigen::Vector3i(n & 1, (n >> 1) & 1, (n >> 2) & 1));
+            looked_up[n] = true;
+        }
+        if (neighbors[n] < 0) {
+            return false;
+        }
+        const size_t ind = size_t(neighbors[n]) +
+                           VoxelIndexOf(idx1(0), idx1(1), idx1(2));
+        if (block_pool_.weight_[ind] == 0) {
+            return false;
+        }
+        double w = (shift[i](0) ? r(0) : 1 - r(0)) *
+                   (shift[i](1) ? r(1) : 1 - r(1)) *
+                   (shift[i](2) ? r(2) : 1 - r(2));
+        sum += w * block_pool_.tsdf_[ind];
+        if (color != nullptr) {
+            color_sum += w * block_pool_.GetColor(ind);
+        }
+    }
+    tsdf = float(sum);
+    if (color != nullptr) {
+        *color = color_sum;
+    }
+    return true;
+}
+
 }  // namespace integration
 }  // namespace open3d
@@ -26,16 +26,24 @@
 
 #pragma once
 
+#include <cstdint>
+#include <cstdio>
 #include <memory>
-#include <unordered_map>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "Open3D/Integration/ConcurrentIndexSet.h"
 #include "Open3D/Integration/TSDFVolume.h"
+#include "Open3D/Integration/TSDFVoxelArray.h"
+#include "Open3D/Integration/VoxelBlockHashMap.h"
 #include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 namespace integration {
 
-class UniformTSDFVolume;
+class MarchingCubesChunk;
 
 /// The ScalableTSDFVolume implements a more memory efficient data structure for
 /// volumetric integration.
@@ -55,15 +63,37 @@ class UniformTSDFVolume;
 /// normal and producing a smooth surface output. The carving is great in
 /// removing outlier structures like floating noise pixels and bumps along
 /// structure edges.
+///
+/// The volume units are found through a spatial hash, volume_unit_map_, and
+/// their voxels are stored in fixed size blocks of one contiguous pool,
+/// block_pool_. The volume can page volume units out to disk, see
+/// EnablePaging(), so that scenes larger than the memory can be integrated.
 class ScalableTSDFVolume : public TSDFVolume {
 public:
+    /// Bookkeeping of a volume unit, its voxels live in block_pool_.
     struct VolumeUnit {
     public:
-        VolumeUnit() : volume_(NULL) {}
+        VolumeUnit()
+            : index_(0, 0, 0),
+              block_(-1),
+              last_access_(0),
+              num_accesses_(0),
+              num_loads_(0),
+              num_evictions_(0) {}
 
     public:
-        std::shared_ptr<UniformTSDFVolume> volume_;
         Eigen::Vector3i index_;
+        /// Block of the voxels in block_pool_, -1 while the unit is paged out
+        /// to disk.
+        int block_;
+        /// Value of access_tick_ when the unit was last used.
+        size_t last_access_;
+        /// Number of Integrate() calls and extraction batches using the unit.
+        size_t num_accesses_;
+        /// Number of times the unit was loaded from its page file.
+        size_t num_loads_;
+        /// Number of times the unit was paged out to disk.
+        size_t num_evictions_;
     };
 
 public:
@@ -72,6 +102,13 @@ public:
                        TSDFVolumeColorType color_type,
                        int volume_unit_resolution = 16,
                        int depth_sampling_stride = 4);
+    /// \brief Copy constructor.
+    ///
+    /// The page files of \p other are copied to a page directory of the new
+    /// volume.
+    ScalableTSDFVolume(const ScalableTSDFVolume &other);
+    ScalableTSDFVolume &operator=(const ScalableTSDFVolume &other);
+    /// Removes the page files and the page directory of the volume.
     ~ScalableTSDFVolume() override;
 
 public:
@@ -79,11 +116,80 @@ public:
     void Integrate(const geometry::RGBDImage &image,
                    const camera::PinholeCameraIntrinsic &intrinsic,
                    const Eigen::Matrix4d &extrinsic) override;
+    void IntegrateWithDepthToCameraDistanceMultiplier(
+            const geometry::RGBDImage &image,
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            const geometry::Image &depth_to_camera_distance_multiplier)
+            override;
     std::shared_ptr<geometry::PointCloud> ExtractPointCloud() override;
     std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() override;
+    std::shared_ptr<RaycastResult> Raycast(
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            double depth_min = 0.1,
+            double depth_max = 3.0) override;
     /// Debug function to extract the voxel data into a point cloud.
     std::shared_ptr<geometry::PointCloud> ExtractVoxelPointCloud();
 
+    /// \brief Extracts the meshes of the volume units whose surface may have
+    /// changed since the previous call, and clears dirty_units_.
+    ///
+    /// A unit is re-meshed if it or a neighbor sharing its boundary cubes was
+    /// integrated into. Each unit mesh holds the cubes whose first corner lies
+    /// in the unit; vertices on the unit faces are duplicated in the meshes of
+    /// the neighbor units. A unit without surface is returned with an empty
+    /// mesh, so that a cached copy can be replaced.
+    ///
+    /// \return Pairs of unit index and unit mesh, sorted by unit index.
+    std::vector<std::pair<Eigen::Vector3i,
+                          std::shared_ptr<geometry::TriangleMesh>>>
+    ExtractDirtyTriangleMeshes();
+
+    /// \brief Enables paging of the volume units to disk.
+    ///
+    /// After each Integrate(), the units farther than \p working_radius from
+    /// the camera center are written to disk and released, then the
+    /// least recently used units are released until the resident voxels fit
+    /// in \p memory_budget. Paged out units are loaded back when Integrate()
+    /// or an extraction function needs them; extraction processes the units
+    /// in batches that fit in the budget. Raycast() only sees the resident
+    /// units.
+    ///
+    /// The page files are written to a subdirectory of \p directory owned by
+    /// the volume, so that several volumes can page to the same directory.
+    /// The subdirectory is removed by DisablePaging() and by the destructor.
+    ///
+    /// \param directory Parent directory of the page files, created if
+    /// needed.
+    /// \param memory_budget Maximum size in bytes of the resident voxels, 0
+    /// for no limit.
+    /// \param working_radius Radius around the camera center of the units
+    /// kept resident, 0 for no limit.
+    /// \return `false` if the directories cannot be created.
+    bool EnablePaging(const std::string &directory,
+                      size_t memory_budget,
+                      double working_radius = 0.0);
+    /// Loads the paged out units back to memory and disables paging.
+    void DisablePaging();
+    /// Returns `true` if paging is enabled.
+    bool IsPagingEnabled() const { return !paging_directory_.empty(); }
+    /// \brief Returns the size in bytes of the voxels of the resident units.
+    ///
+    /// block_pool_ keeps its peak size, the blocks of paged out units are
+    /// reused by the next units.
+    size_t GetResidentMemorySize() const;
+
+    /// \brief Writes the volume, including the paged out units, to a binary
+    /// file.
+    bool WriteToFile(const std::string &filename) const;
+    /// \brief Replaces the content of the volume by a file written with
+    /// WriteToFile().
+    ///
+    /// The file must have the voxel length, truncation, color type and unit
+    /// resolution of the volume. The paging settings are kept.
+    bool ReadFromFile(const std::string &filename);
+
 public:
     int volume_unit_resolution_;
     double volume_unit_length_;
@@ -92,24 +198,176 @@ public:
     /// Assume the index of the volume unit is (x, y, z), then the unit spans
     /// from (x, y, z) * volume_unit_length_
     /// to (x + 1, y + 1, z + 1) * volume_unit_length_
-    std::unordered_map<Eigen::Vector3i,
-                       VolumeUnit,
+    ///
+    /// The units are indexed by the handles of volume_unit_map_.
+    std::vector<VolumeUnit> volume_units_;
+    /// Spatial hash from the index of a volume unit to its handle.
+    VoxelBlockHashMap volume_unit_map_;
+    /// Voxels of the resident units. Block b holds
+    /// volume_unit_resolution_^3 voxels from b * volume_unit_resolution_^3,
+    /// voxel (x, y, z) of the unit is at (x * res + y) * res + z in its
+    /// block.
+    TSDFVoxelArray block_pool_;
+
+    /// Indices of the volume units integrated into since the last call to
+    /// ExtractDirtyTriangleMeshes().
+    std::unordered_set<Eigen::Vector3i,
                        utility::hash_eigen::hash<Eigen::Vector3i>>
-            volume_units_;
+            dirty_units_;
+
+    /// Directory passed to EnablePaging(), empty if paging is disabled.
+    std::string paging_root_;
+    /// Subdirectory of paging_root_ holding the page files of this volume,
+    /// empty if paging is disabled.
+    std::string paging_directory_;
+    /// Maximum size in bytes of the resident voxels, 0 for no limit.
+    size_t paging_memory_budget_;
+    /// Radius around the camera center of the units kept resident, 0 for no
+    /// limit.
+    double paging_working_radius_;
+    /// Clock of the paging statistics, incremented by every Integrate() call
+    /// and extraction batch.
+    size_t access_tick_;
 
 private:
-    Eigen::Vector3i LocateVolumeUnit(const Eigen::Vector3d &point) {
+    /// Blocks of block_pool_ released by paged out units.
+    std::vector<int> free_blocks_;
+    /// Volume units touched by the frame being integrated, kept to reuse its
+    /// table.
+    ConcurrentIndexSet touched_units_;
+
+    /// Volume units read by the extraction of a unit.
+    enum class Neighborhood {
+        /// The unit only.
+        None,
+        /// The unit and the units at offsets in {0, 1}^3.
+        Forward,
+        /// The unit and the units at offsets in {-1, 0, 1}^3.
+        All,
+    };
+
+    Eigen::Vector3i LocateVolumeUnit(const Eigen::Vector3d &point) const {
         return Eigen::Vector3i((int)std::floor(point(0) / volume_unit_length_),
                                (int)std::floor(point(1) / volume_unit_length_),
                                (int)std::floor(point(2) / volume_unit_length_));
     }
 
-    std::shared_ptr<UniformTSDFVolume> OpenVolumeUnit(
-            const Eigen::Vector3i &index);
+    /// Returns the number of voxels of a volume unit.
+    size_t GetVoxelsPerUnit() const {
+        return size_t(volume_unit_resolution_) * volume_unit_resolution_ *
+               volume_unit_resolution_;
+    }
+
+    /// \brief Returns the offset in block_pool_ of the voxels of the unit
+    /// \p index, or -1 if the unit is not allocated or paged out.
+    int64_t GetVoxelOffset(const Eigen::Vector3i &index) const {
+        const int handle = volume_unit_map_.Find(index);
+        if (handle < 0 || volume_units_[handle].block_ < 0) {
+            return -1;
+        }
+        return int64_t(volume_units_[handle].block_) * GetVoxelsPerUnit();
+    }
+
+    /// Returns the offset of voxel (x, y, z) in the block of a unit.
+    int VoxelIndexOf(int x, int y, int z) const {
+        return (x * volume_unit_resolution_ + y) * volume_unit_resolution_ + z;
+    }
+
+    /// \brief Inserts the units crossed by the truncation band of the sampled
+    /// rays of \p image into touched_units_.
+    ///
+    /// \return `false` if touched_units_ is full.
+    bool InsertTouchedVolumeUnits(
+            const geometry::RGBDImage &image,
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic);
+
+    /// \brief Returns the handle of the unit \p index, allocated if needed
+    /// and loaded if paged out.
+    int OpenVolumeUnit(const Eigen::Vector3i &index);
+
+    /// Returns a zeroed block of block_pool_, the pool may grow.
+    int AllocateBlock();
+
+    /// Returns the indices of the volume units, sorted.
+    std::vector<Eigen::Vector3i> GetVolumeUnitIndices() const;
+
+    /// Returns the size in bytes of the voxels of a volume unit.
+    size_t GetVolumeUnitMemorySize() const;
+
+    /// \brief Returns the number of units processed per extraction batch, so
+    /// that a batch with its \p neighborhood fits in the memory budget.
+    size_t GetVolumeUnitBatchSize(Neighborhood neighborhood) const;
+
+    /// \brief Loads the units in [\p begin, \p end) of \p indices, with
+    /// their \p neighborhood, and updates their paging statistics.
+    void PrepareVolumeUnitBatch(const std::vector<Eigen::Vector3i> &indices,
+                                size_t begin,
+                                size_t end,
+                                Neighborhood neighborhood);
+
+    /// \brief Pages out the units outside the working radius of
+    /// \p camera_center, if not null, then the least recently used units
+    /// until the memory budget holds. The units of \p pinned, if not null,
+    /// stay resident.
+    void EnforcePagingLimits(
+            const Eigen::Vector3d *camera_center,
+            const std::unordered_set<Eigen::Vector3i,
+                                     utility::hash_eigen::hash<Eigen::Vector3i>>
+                    *pinned);
+
+    std::string GetPageFilename(const Eigen::Vector3i &index) const;
+
+    /// \brief Creates a page directory in the paging root of \p other and
+    /// copies the page files of the paged out units of \p other to it.
+    ///
+    /// The units of the volume must be those of \p other.
+    bool CopyPagingDirectory(const ScalableTSDFVolume &other);
+
+    /// Removes the page files of the paged out units and the page directory.
+    void RemovePagingDirectory();
+
+    /// Writes \p unit to its page file and releases its voxels.
+    bool PageOutVolumeUnit(VolumeUnit &unit);
+
+    /// Reads the voxels of a paged out \p unit and removes its page file.
+    bool LoadVolumeUnit(VolumeUnit &unit);
+
+    /// Writes \p index and the unit voxels of \p voxels from \p offset.
+    bool WriteVolumeUnit(FILE *file,
+                         const Eigen::Vector3i &index,
+                         const TSDFVoxelArray &voxels,
+                         size_t offset) const;
+
+    /// Reads the index and the voxels of a unit into \p voxels from
+    /// \p offset.
+    bool ReadVolumeUnit(FILE *file,
+                        Eigen::Vector3i &index,
+                        TSDFVoxelArray &voxels,
+                        size_t offset) const;
+
+    /// \brief Runs marching cubes over the cubes of the unit \p index.
+    ///
+    /// \param index The index of the volume unit.
+    /// \param edge_to_vertex Scratch buffer for the edge table.
+    /// \param chunk Output chunk, with global edge indices for the vertices
+    /// shared with neighbor units.
+    void ExtractVolumeUnitMesh(const Eigen::Vector3i &index,
+                               std::vector<int> &edge_to_vertex,
+                               MarchingCubesChunk &chunk) const;
 
     Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
 
     double GetTSDFAt(const Eigen::Vector3d &p);
+
+    /// \brief Trilinearly interpolates the TSDF, and the color if \p color is
+    /// not null, at \p p.
+    ///
+    /// Returns `false` if one of the eight voxels is unobserved or lies in a
+    /// unit that is not allocated.
+    bool InterpolateTSDF(const Eigen::Vector3d &p,
+                         float &tsdf,
+                         Eigen::Vector3d *color) const;
 };
 
 }  // namespace integration
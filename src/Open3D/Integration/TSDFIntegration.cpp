@@ -0,0 +1,107 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/TSDFIntegration.h"
+
+#include <algorithm>
+
+namespace open3d {
+namespace integration {
+
+void IntegrateTSDFColumns(
+        const geometry::RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        const geometry::Image &depth_to_camera_distance_multiplier,
+        double voxel_length,
+        double sdf_trunc,
+        const Eigen::Vector3d &origin,
+        int resolution,
+        size_t offset,
+        int column_begin,
+        int column_end,
+        TSDFVoxelArray &voxels) {
+    const float fx = static_cast<float>(intrinsic.GetFocalLength().first);
+    const float fy = static_cast<float>(intrinsic.GetFocalLength().second);
+    const float cx = static_cast<float>(intrinsic.GetPrincipalPoint().first);
+    const float cy = static_cast<float>(intrinsic.GetPrincipalPoint().second);
+    const Eigen::Matrix4f extrinsic_f = extrinsic.cast<float>();
+    const float voxel_length_f = static_cast<float>(voxel_length);
+    const float half_voxel_length_f = voxel_length_f * 0.5f;
+    const float sdf_trunc_f = static_cast<float>(sdf_trunc);
+    const float sdf_trunc_inv_f = 1.0f / sdf_trunc_f;
+    const Eigen::Matrix4f extrinsic_scaled_f = extrinsic_f * voxel_length_f;
+    const float safe_width_f = intrinsic.width_ - 0.0001f;
+    const float safe_height_f = intrinsic.height_ - 0.0001f;
+
+    for (int column = column_begin; column < column_end; column++) {
+        int x = column / resolution;
+        int y = column % resolution;
+        Eigen::Vector4f pt_3d_homo(float(half_voxel_length_f +
+                                         voxel_length_f * x + origin(0)),
+                                   float(half_voxel_length_f +
+                                         voxel_length_f * y + origin(1)),
+                                   float(half_voxel_length_f + origin(2)),
+                                   1.f);
+        Eigen::Vector4f pt_camera = extrinsic_f * pt_3d_homo;
+        for (int z = 0; z < resolution; z++,
+                 pt_camera(0) += extrinsic_scaled_f(0, 2),
+                 pt_camera(1) += extrinsic_scaled_f(1, 2),
+                 pt_camera(2) += extrinsic_scaled_f(2, 2)) {
+            // Skip if negative depth after projection
+            if (pt_camera(2) <= 0) {
+                continue;
+            }
+            // Skip if x-y coordinate not in range
+            float u_f = pt_camera(0) * fx / pt_camera(2) + cx + 0.5f;
+            float v_f = pt_camera(1) * fy / pt_camera(2) + cy + 0.5f;
+            if (!(u_f >= 0.0001f && u_f < safe_width_f && v_f >= 0.0001f &&
+                  v_f < safe_height_f)) {
+                continue;
+            }
+            // Skip if negative depth in depth image
+            int u = (int)u_f;
+            int v = (int)v_f;
+            float d = *image.depth_.PointerAt<float>(u, v);
+            if (d <= 0.0f) {
+                continue;
+            }
+
+            size_t v_ind = offset + (x * resolution + y) * resolution + z;
+            float sdf = (d - pt_camera(2)) *
+                        (*depth_to_camera_distance_multiplier.PointerAt<float>(
+                                u, v));
+            if (sdf > -sdf_trunc_f) {
+                // integrate
+                float tsdf = std::min(1.0f, sdf * sdf_trunc_inv_f);
+                voxels.IntegrateVoxel(v_ind, tsdf, image.color_, u, v);
+            }
+        }
+    }
+}
+
+}  // namespace integration
+}  // namespace open3d
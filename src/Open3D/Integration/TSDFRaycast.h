@@ -0,0 +1,184 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Integration/TSDFVolume.h"
+
+namespace open3d {
+namespace integration {
+
+/// \brief Marches a ray through every pixel of a camera until the TSDF
+/// changes sign from positive to negative.
+///
+/// Observed samples advance the ray by the distance the TSDF guarantees to be
+/// free, at least one voxel. Unobserved samples advance it by a distance
+/// chosen by \p sample, e.g. to the end of an unallocated block. The crossing
+/// is found by linear interpolation between the last two samples. The pixels
+/// are processed in parallel.
+///
+/// \param sample Functor `bool(const Eigen::Vector3d &p, const
+/// Eigen::Vector3d &direction, float &tsdf, double &skip)` that interpolates
+/// the TSDF at world point \p p. It returns `false` if \p p is unobserved, and
+/// sets `skip` to the distance the ray can safely advance along the unit
+/// vector `direction`.
+/// \param shade Functor `bool(const Eigen::Vector3d &p, Eigen::Vector3d
+/// &normal, Eigen::Vector3d &color)` that computes the unit normal and the
+/// color at surface point \p p. It returns `false` if the normal is
+/// undefined.
+/// \param min_bound Minimum bound of the region where \p sample can succeed.
+/// \param max_bound Maximum bound of the region where \p sample can succeed.
+/// \param voxel_length Length of a voxel.
+/// \param sdf_trunc Truncation value of the signed distance function.
+/// \param color_type Color type of the volume.
+/// \param intrinsic Pinhole camera intrinsic parameters.
+/// \param extrinsic Extrinsic parameters, mapping world to camera.
+/// \param depth_min Minimum depth of the rendered surface.
+/// \param depth_max Maximum depth of the rendered surface.
+template <typename Sample, typename Shade>
+std::shared_ptr<RaycastResult> RaycastTSDF(
+        const Sample &sample,
+        const Shade &shade,
+        const Eigen::Vector3d &min_bound,
+        const Eigen::Vector3d &max_bound,
+        double voxel_length,
+        double sdf_trunc,
+        TSDFVolumeColorType color_type,
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        double depth_min,
+        double depth_max) {
+    auto result = std::make_shared<RaycastResult>();
+    const int width = intrinsic.width_;
+    const int height = intrinsic.height_;
+    result->vertex_map_.Prepare(width, height, 3, 4);
+    result->normal_map_.Prepare(width, height, 3, 4);
+    result->depth_.Prepare(width, height, 1, 4);
+    if (color_type == TSDFVolumeColorType::RGB8) {
+        result->color_.Prepare(width, height, 3, 1);
+    } else if (color_type == TSDFVolumeColorType::Gray32) {
+        result->color_.Prepare(width, height, 1, 4);
+    }
+
+    const double fx = intrinsic.GetFocalLength().first;
+    const double fy = intrinsic.GetFocalLength().second;
+    const double cx = intrinsic.GetPrincipalPoint().first;
+    const double cy = intrinsic.GetPrincipalPoint().second;
+    const Eigen::Matrix3d R = extrinsic.block<3, 3>(0, 0);
+    const Eigen::Matrix3d R_inv = R.transpose();
+    const Eigen::Vector3d camera_center =
+            -R_inv * extrinsic.block<3, 1>(0, 3);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int v = 0; v < height; v++) {
+        for (int u = 0; u < width; u++) {
+            // The ray is parameterized by the depth z: p = center + z * ray.
+            const Eigen::Vector3d ray_camera((u - cx) / fx, (v - cy) / fy,
+                                             1.0);
+            const Eigen::Vector3d ray = R_inv * ray_camera;
+            const double ray_length = ray.norm();
+            const Eigen::Vector3d direction = ray / ray_length;
+
+            // Clip the ray to the bounds of the volume.
+            double z_begin = depth_min;
+            double z_end = depth_max;
+            for (int k = 0; k < 3; k++) {
+                if (std::abs(ray(k)) < 1e-12) {
+                    if (camera_center(k) < min_bound(k) ||
+                        camera_center(k) > max_bound(k)) {
+                        z_end = -1.0;
+                    }
+                    continue;
+                }
+                double z0 = (min_bound(k) - camera_center(k)) / ray(k);
+                double z1 = (max_bound(k) - camera_center(k)) / ray(k);
+                z_begin = (std::max)(z_begin, (std::min)(z0, z1));
+                z_end = (std::min)(z_end, (std::max)(z0, z1));
+            }
+
+            double z = z_begin;
+            double z_hit = -1.0;
+            bool prev_valid = false;
+            float prev_tsdf = 0.0f;
+            double prev_z = 0.0;
+            while (z <= z_end) {
+                float tsdf;
+                double skip;
+                if (!sample(camera_center + z * ray, direction, tsdf, skip)) {
+                    prev_valid = false;
+                    z += (std::max)(skip, voxel_length) / ray_length;
+                    continue;
+                }
+                if (prev_valid && prev_tsdf > 0.0f && tsdf <= 0.0f) {
+                    z_hit = prev_z +
+                            (z - prev_z) * prev_tsdf / (prev_tsdf - tsdf);
+                    break;
+                }
+                prev_valid = true;
+                prev_tsdf = tsdf;
+                prev_z = z;
+                z += (std::max)(voxel_length, tsdf * sdf_trunc) / ray_length;
+            }
+            if (z_hit < 0.0) {
+                continue;
+            }
+
+            Eigen::Vector3d normal, color;
+            if (!shade(camera_center + z_hit * ray, normal, color)) {
+                continue;
+            }
+            const Eigen::Vector3d vertex_camera = z_hit * ray_camera;
+            const Eigen::Vector3d normal_camera = R * normal;
+            float *vertex_ptr = result->vertex_map_.PointerAt<float>(u, v, 0);
+            float *normal_ptr = result->normal_map_.PointerAt<float>(u, v, 0);
+            for (int k = 0; k < 3; k++) {
+                vertex_ptr[k] = float(vertex_camera(k));
+                normal_ptr[k] = float(normal_camera(k));
+            }
+            *result->depth_.PointerAt<float>(u, v) = float(z_hit);
+            if (color_type == TSDFVolumeColorType::RGB8) {
+                uint8_t *rgb = result->color_.PointerAt<uint8_t>(u, v, 0);
+                for (int k = 0; k < 3; k++) {
+                    rgb[k] = uint8_t(color(k) * 255.0 + 0.5);
+                }
+            } else if (color_type == TSDFVolumeColorType::Gray32) {
+                *result->color_.PointerAt<float>(u, v) = float(color(0));
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace integration
+}  // namespace open3d
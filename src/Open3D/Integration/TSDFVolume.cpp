@@ -0,0 +1,122 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/TSDFVolume.h"
+
+#include <functional>
+#include <future>
+#include <utility>
+#include <vector>
+
+#include "Open3D/Utility/Console.h"
+
+namespace open3d {
+namespace integration {
+
+void TSDFVolume::IntegrateSequence(
+        const std::function<std::shared_ptr<geometry::RGBDImage>(size_t)>
+                &frame_source,
+        const camera::PinholeCameraTrajectory &trajectory) {
+    const size_t num_frames = trajectory.parameters_.size();
+    if (num_frames == 0) {
+        return;
+    }
+    // Trajectories usually hold one or a few distinct intrinsics, the
+    // multiplier tables are cached in a list.
+    std::vector<std::pair<camera::PinholeCameraIntrinsic,
+                          std::shared_ptr<geometry::Image>>>
+            multipliers;
+
+    // std::async copies its arguments, so frame_source is wrapped in a
+    // reference instead of being copied, with whatever it captures, for
+    // every frame. A pending future blocks on destruction, so frame_source
+    // outlives every call.
+    std::future<std::shared_ptr<geometry::RGBDImage>> next_frame = std::async(
+            std::launch::async, std::cref(frame_source), size_t(0));
+    for (size_t i = 0; i < num_frames; i++) {
+        std::shared_ptr<geometry::RGBDImage> image = next_frame.get();
+        if (i + 1 < num_frames) {
+            next_frame = std::async(std::launch::async,
+                                    std::cref(frame_source), i + 1);
+        }
+        if (!image) {
+            utility::LogWarning(
+                    "[TSDFVolume::IntegrateSequence] Frame {:d} is missing, "
+                    "skipped.",
+                    i);
+            continue;
+        }
+        const auto &parameters = trajectory.parameters_[i];
+        if (!IsImageFormatSupported(*image, parameters.intrinsic_)) {
+            utility::LogError(
+                    "[TSDFVolume::IntegrateSequence] Unsupported image format "
+                    "of frame {:d}.",
+                    i);
+        }
+        const geometry::Image *multiplier = nullptr;
+        for (const auto &cached : multipliers) {
+            if (cached.first.width_ == parameters.intrinsic_.width_ &&
+                cached.first.height_ == parameters.intrinsic_.height_ &&
+                cached.first.intrinsic_matrix_ ==
+                        parameters.intrinsic_.intrinsic_matrix_) {
+                multiplier = cached.second.get();
+                break;
+            }
+        }
+        if (multiplier == nullptr) {
+            multipliers.push_back(std::make_pair(
+                    parameters.intrinsic_,
+                    geometry::Image::
+                            CreateDepthToCameraDistanceMultiplierFloatImage(
+                                    parameters.intrinsic_)));
+            multiplier = multipliers.back().second.get();
+        }
+        IntegrateWithDepthToCameraDistanceMultiplier(
+                *image, parameters.intrinsic_, parameters.extrinsic_,
+                *multiplier);
+    }
+}
+
+bool TSDFVolume::IsImageFormatSupported(
+        const geometry::RGBDImage &image,
+        const camera::PinholeCameraIntrinsic &intrinsic) const {
+    return image.depth_.num_of_channels_ == 1 &&
+           image.depth_.bytes_per_channel_ == 4 &&
+           image.depth_.width_ == intrinsic.width_ &&
+           image.depth_.height_ == intrinsic.height_ &&
+           !(color_type_ == TSDFVolumeColorType::RGB8 &&
+             (image.color_.num_of_channels_ != 3 ||
+              image.color_.bytes_per_channel_ != 1)) &&
+           !(color_type_ == TSDFVolumeColorType::Gray32 &&
+             (image.color_.num_of_channels_ != 1 ||
+              image.color_.bytes_per_channel_ != 4)) &&
+           !(color_type_ != TSDFVolumeColorType::NoColor &&
+             (image.color_.width_ != intrinsic.width_ ||
+              image.color_.height_ != intrinsic.height_));
+}
+
+}  // namespace integration
+}  // namespace open3d
@@ -26,7 +26,12 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
+#include "Open3D/Camera/PinholeCameraTrajectory.h"
+#include "Open3D/Geometry/Image.h"
 #include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Geometry/RGBDImage.h"
 #include "Open3D/Geometry/TriangleMesh.h"
@@ -46,6 +51,27 @@ enum class TSDFVolumeColorType {
     Gray32 = 2,
 };
 
+/// \class RaycastResult
+///
+/// \brief Images rendered from a TSDFVolume by TSDFVolume::Raycast().
+///
+/// All images have the size of the camera intrinsic. Pixels whose ray does not
+/// hit the surface have zero depth, vertex and normal.
+class RaycastResult {
+public:
+    /// Surface points in the camera frame, 3 channels of float.
+    geometry::Image vertex_map_;
+    /// Unit surface normals in the camera frame, facing the camera, 3
+    /// channels of float.
+    geometry::Image normal_map_;
+    /// Depth along the camera z axis in meters, 1 channel of float.
+    geometry::Image depth_;
+    /// Surface color, 3 channels of uint8_t for TSDFVolumeColorType::RGB8, 1
+    /// channel of float for TSDFVolumeColorType::Gray32, and empty for
+    /// TSDFVolumeColorType::NoColor.
+    geometry::Image color_;
+};
+
 /// \class TSDFVolume
 ///
 /// \brief Base class of the Truncated Signed Distance Function (TSDF) volume.
@@ -81,6 +107,31 @@ public:
                            const camera::PinholeCameraIntrinsic &intrinsic,
                            const Eigen::Matrix4d &extrinsic) = 0;
 
+    /// \brief Function to integrate an RGB-D image, with the depth to camera
+    /// distance multiplier precomputed from the camera intrinsic by
+    /// geometry::Image::CreateDepthToCameraDistanceMultiplierFloatImage().
+    virtual void IntegrateWithDepthToCameraDistanceMultiplier(
+            const geometry::RGBDImage &image,
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            const geometry::Image &depth_to_camera_distance_multiplier) = 0;
+
+    /// \brief Function to integrate a sequence of RGB-D images.
+    ///
+    /// Frame i + 1 is loaded by \p frame_source on a worker thread while
+    /// frame i is integrated, so that image decoding and depth conversion
+    /// overlap with integration. The depth to camera distance multiplier is
+    /// computed once per distinct camera intrinsic of \p trajectory.
+    ///
+    /// \param frame_source Function returning the RGB-D image of frame i.
+    /// Frames for which it returns `nullptr` are skipped. It is called on
+    /// one thread at a time, in frame order.
+    /// \param trajectory Camera intrinsic and extrinsic of every frame.
+    void IntegrateSequence(
+            const std::function<std::shared_ptr<geometry::RGBDImage>(size_t)>
+                    &frame_source,
+            const camera::PinholeCameraTrajectory &trajectory);
+
     /// Function to extract a point cloud with normals.
     virtual std::shared_ptr<geometry::PointCloud> ExtractPointCloud() = 0;
 
@@ -88,6 +139,27 @@ public:
     /// algorithm. (https://en.wikipedia.org/wiki/Marching_cubes)
     virtual std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() = 0;
 
+    /// \brief Function to render the surface seen by a camera, by marching a
+    /// ray through every pixel until the TSDF changes sign.
+    ///
+    /// \param intrinsic Pinhole camera intrinsic parameters.
+    /// \param extrinsic Extrinsic parameters, mapping world to camera.
+    /// \param depth_min Minimum depth of the rendered surface.
+    /// \param depth_max Maximum depth of the rendered surface.
+    virtual std::shared_ptr<RaycastResult> Raycast(
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            double depth_min = 0.1,
+            double depth_max = 3.0) = 0;
+
+protected:
+    /// \brief Returns `true` if \p image can be integrated: a float depth
+    /// image and a color image matching color_type_, both of the size of
+    /// \p intrinsic.
+    bool IsImageFormatSupported(
+            const geometry::RGBDImage &image,
+            const camera::PinholeCameraIntrinsic &intrinsic) const;
+
 public:
     /// Length of the voxel in meters.
     double voxel_length_;
@@ -0,0 +1,124 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/TSDFVoxelArray.h"
+
+#include <algorithm>
+
+namespace open3d {
+namespace integration {
+
+TSDFVoxelArray::TSDFVoxelArray(
+        TSDFVolumeColorType color_type /* = TSDFVolumeColorType::NoColor*/,
+        size_t size /* = 0*/)
+    : color_type_(color_type) {
+    Resize(size);
+}
+
+void TSDFVoxelArray::Resize(size_t size) {
+    tsdf_.resize(size, 0.0f);
+    weight_.resize(size, 0);
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        color_rgb_.resize(3 * size, 0);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        color_gray_.resize(size, 0.0f);
+    }
+}
+
+void TSDFVoxelArray::Reset() {
+    std::fill(tsdf_.begin(), tsdf_.end(), 0.0f);
+    std::fill(weight_.begin(), weight_.end(), 0);
+    std::fill(color_rgb_.begin(), color_rgb_.end(), 0);
+    std::fill(color_gray_.begin(), color_gray_.end(), 0.0f);
+}
+
+void TSDFVoxelArray::Reset(size_t begin, size_t count) {
+    std::fill_n(tsdf_.begin() + begin, count, 0.0f);
+    std::fill_n(weight_.begin() + begin, count, 0);
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        std::fill_n(color_rgb_.begin() + 3 * begin, 3 * count, 0);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        std::fill_n(color_gray_.begin() + begin, count, 0.0f);
+    }
+}
+
+size_t TSDFVoxelArray::BytesPerVoxel() const {
+    size_t bytes = sizeof(float) + sizeof(uint16_t);
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        bytes += 3 * sizeof(uint8_t);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        bytes += sizeof(float);
+    }
+    return bytes;
+}
+
+namespace {
+
+template <typename T>
+bool WriteArray(FILE *file,
+                const std::vector<T> &array,
+                size_t begin,
+                size_t count) {
+    return fwrite(array.data() + begin, sizeof(T), count, file) == count;
+}
+
+template <typename T>
+bool ReadArray(FILE *file, std::vector<T> &array, size_t begin, size_t count) {
+    return fread(array.data() + begin, sizeof(T), count, file) == count;
+}
+
+}  // unnamed namespace
+
+bool TSDFVoxelArray::WriteToBinary(FILE *file,
+                                   size_t begin,
+                                   size_t count) const {
+    if (!WriteArray(file, tsdf_, begin, count) ||
+        !WriteArray(file, weight_, begin, count)) {
+        return false;
+    }
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        return WriteArray(file, color_rgb_, 3 * begin, 3 * count);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        return WriteArray(file, color_gray_, begin, count);
+    }
+    return true;
+}
+
+bool TSDFVoxelArray::ReadFromBinary(FILE *file, size_t begin, size_t count) {
+    if (!ReadArray(file, tsdf_, begin, count) ||
+        !ReadArray(file, weight_, begin, count)) {
+        return false;
+    }
+    if (color_type_ == TSDFVolumeColorType::RGB8) {
+        return ReadArray(file, color_rgb_, 3 * begin, 3 * count);
+    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+        return ReadArray(file, color_gray_, begin, count);
+    }
+    return true;
+}
+
+}  // namespace integration
+}  // namespace open3d
@@ -0,0 +1,145 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+#include "Open3D/Geometry/Image.h"
+#include "Open3D/Integration/TSDFVolume.h"
+
+namespace open3d {
+namespace integration {
+
+/// \class TSDFVoxelArray
+///
+/// \brief Compact storage of the voxels of a TSDF volume.
+///
+/// The voxels are stored as a structure of arrays. Every voxel has a float
+/// TSDF value and a uint16_t integration weight. Depending on the color type,
+/// it also has three uint8_t channels (TSDFVolumeColorType::RGB8) or a float
+/// intensity (TSDFVolumeColorType::Gray32), i.e. 6, 9 or 10 bytes per voxel.
+/// The grid index of a voxel is implied by its position in the arrays.
+class TSDFVoxelArray {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param color_type Color type of the voxels.
+    /// \param size Number of voxels, all initialized with zero weight.
+    TSDFVoxelArray(
+            TSDFVolumeColorType color_type = TSDFVolumeColorType::NoColor,
+            size_t size = 0);
+    ~TSDFVoxelArray() {}
+
+public:
+    /// Returns the number of voxels.
+    size_t size() const { return tsdf_.size(); }
+    /// Returns `true` if there are no voxels.
+    bool empty() const { return tsdf_.empty(); }
+    /// Resizes the arrays, new voxels are initialized with zero weight.
+    void Resize(size_t size);
+    /// Sets the TSDF value, weight and color of all voxels to zero.
+    void Reset();
+    /// Sets the TSDF value, weight and color of the voxels
+    /// [\p begin, \p begin + \p count) to zero.
+    void Reset(size_t begin, size_t count);
+    /// Returns the number of bytes used per voxel.
+    size_t BytesPerVoxel() const;
+
+    /// \brief Writes the voxels [\p begin, \p begin + \p count) to a binary
+    /// file, array by array and without header.
+    ///
+    /// \return `false` if the write failed.
+    bool WriteToBinary(FILE *file, size_t begin, size_t count) const;
+    /// \brief Reads \p count voxels written by WriteToBinary() with the same
+    /// color type into [\p begin, \p begin + \p count).
+    ///
+    /// \return `false` on unexpected end of file.
+    bool ReadFromBinary(FILE *file, size_t begin, size_t count);
+
+    /// Returns the color of voxel \p i, in range [0, 1]. Gray32 intensities
+    /// are replicated to the three channels, NoColor returns zero.
+    Eigen::Vector3d GetColor(size_t i) const {
+        if (color_type_ == TSDFVolumeColorType::RGB8) {
+            const uint8_t *rgb = &color_rgb_[3 * i];
+            return Eigen::Vector3d(rgb[0], rgb[1], rgb[2]) / 255.0;
+        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+            return Eigen::Vector3d::Constant(color_gray_[i]);
+        }
+        return Eigen::Vector3d::Zero();
+    }
+
+    /// \brief Averages a new observation into voxel \p i.
+    ///
+    /// \param i Index of the voxel.
+    /// \param tsdf Truncated signed distance of the observation.
+    /// \param color Color image of the observation, ignored for NoColor.
+    /// \param u Column of the observed pixel.
+    /// \param v Row of the observed pixel.
+    void IntegrateVoxel(size_t i,
+                        float tsdf,
+                        const geometry::Image &color,
+                        int u,
+                        int v) {
+        const float w = weight_[i];
+        tsdf_[i] = (tsdf_[i] * w + tsdf) / (w + 1.0f);
+        if (color_type_ == TSDFVolumeColorType::RGB8) {
+            const uint8_t *rgb = color.PointerAt<uint8_t>(u, v, 0);
+            uint8_t *voxel_rgb = &color_rgb_[3 * i];
+            for (int c = 0; c < 3; c++) {
+                voxel_rgb[c] = static_cast<uint8_t>(
+                        (voxel_rgb[c] * w + rgb[c]) / (w + 1.0f) + 0.5f);
+            }
+        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
+            const float intensity = *color.PointerAt<float>(u, v, 0);
+            color_gray_[i] = (color_gray_[i] * w + intensity) / (w + 1.0f);
+        }
+        // The weight saturates, further observations keep being averaged in
+        // with the maximum weight.
+        if (weight_[i] < std::numeric_limits<uint16_t>::max()) {
+            weight_[i]++;
+        }
+    }
+
+public:
+    /// Color type of the voxels.
+    TSDFVolumeColorType color_type_;
+    /// Truncated signed distance of each voxel, in range [-1, 1].
+    std::vector<float> tsdf_;
+    /// Integration weight of each voxel, zero if never observed.
+    std::vector<uint16_t> weight_;
+    /// Three channels per voxel, only used for TSDFVolumeColorType::RGB8.
+    std::vector<uint8_t> color_rgb_;
+    /// Intensity of each voxel, only used for TSDFVolumeColorType::Gray32.
+    std::vector<float> color_gray_;
+};
+
+}  // namespace integration
+}  // namespace open3d
@@ -26,17 +26,27 @@
 
 #include "Open3D/Integration/UniformTSDFVolume.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <thread>
-#include <unordered_map>
 
 #include "Open3D/Geometry/VoxelGrid.h"
-#include "Open3D/Integration/MarchingCubesConst.h"
+#include "Open3D/Integration/MarchingCubes.h"
+#include "Open3D/Integration/TSDFIntegration.h"
+#include "Open3D/Integration/TSDFRaycast.h"
 #include "Open3D/Utility/Helper.h"
 
 namespace open3d {
 namespace integration {
 
+namespace {
+
+/// Number of cubes along each side of the blocks meshed in parallel.
+const int MARCHING_CUBES_BLOCK_SIZE = 16;
+
+}  // unnamed namespace
+
 UniformTSDFVolume::UniformTSDFVolume(
         double length,
         int resolution,
@@ -44,16 +54,15 @@ UniformTSDFVolume::UniformTSDFVolume(
         TSDFVolumeColorType color_type,
         const Eigen::Vector3d &origin /* = Eigen::Vector3d::Zero()*/)
     : TSDFVolume(length / (double)resolution, sdf_trunc, color_type),
+      voxels_(color_type, resolution * resolution * resolution),
       origin_(origin),
       length_(length),
       resolution_(resolution),
-      voxel_num_(resolution * resolution * resolution) {
-    voxels_.resize(voxel_num_);
-}
+      voxel_num_(resolution * resolution * resolution) {}
 
 UniformTSDFVolume::~UniformTSDFVolume() {}
 
-void UniformTSDFVolume::Reset() { voxels_.clear(); }
+void UniformTSDFVolume::Reset() { voxels_.Reset(); }
 
 void UniformTSDFVolume::Integrate(
         const geometry::RGBDImage &image,
@@ -62,22 +71,7 @@ void UniformTSDFVolume::Integrate(
     // This function goes through the voxels, and scan convert the relative
     // depth/color value into the voxel.
     // The following implementation is a highly optimized version.
-    if ((image.depth_.num_of_channels_ != 1) ||
-        (image.depth_.bytes_per_channel_ != 4) ||
-        (image.depth_.width_ != intrinsic.width_) ||
-        (image.depth_.height_ != intrinsic.height_) ||
-        (color_type_ == TSDFVolumeColorType::RGB8 &&
-         image.color_.num_of_channels_ != 3) ||
-        (color_type_ == TSDFVolumeColorType::RGB8 &&
-         image.color_.bytes_per_channel_ != 1) ||
-        (color_type_ == TSDFVolumeColorType::Gray32 &&
-         image.color_.num_of_channels_ != 1) ||
-        (color_type_ == TSDFVolumeColorType::Gray32 &&
-         image.color_.bytes_per_channel_ != 4) ||
-        (color_type_ != TSDFVolumeColorType::NoColor &&
-         image.color_.width_ != intrinsic.width_) ||
-        (color_type_ != TSDFVolumeColorType::NoColor &&
-         image.color_.height_ != intrinsic.height_)) {
+    if (!IsImageFormatSupported(image, intrinsic)) {
         utility::LogError(
                 "[UniformTSDFVolume::Integrate] Unsupported image format.");
     }
@@ -95,9 +89,9 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
         for (int y = 1; y < resolution_ - 1; y++) {
             for (int z = 1; z < resolution_ - 1; z++) {
                 Eigen::Vector3i idx0(x, y, z);
-                float w0 = voxels_[IndexOf(idx0)].weight_;
-                float f0 = voxels_[IndexOf(idx0)].tsdf_;
-                const Eigen::Vector3d &c0 = voxels_[IndexOf(idx0)].color_;
+                int ind0 = IndexOf(idx0);
+                float w0 = voxels_.weight_[ind0];
+                float f0 = voxels_.tsdf_[ind0];
 
                 if (!(w0 != 0.0f && f0 < 0.98f && f0 >= -0.98f)) {
                     continue;
@@ -111,10 +105,9 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
                     Eigen::Vector3i idx1 = idx0;
                     idx1(i) += 1;
                     if (idx1(i) < resolution_ - 1) {
-                        float w1 = voxels_[IndexOf(idx1)].weight_;
-                        float f1 = voxels_[IndexOf(idx1)].tsdf_;
-                        const Eigen::Vector3d &c1 =
-                                voxels_[IndexOf(idx1)].color_;
+                        int ind1 = IndexOf(idx1);
+                        float w1 = voxels_.weight_[ind1];
+                        float f1 = voxels_.tsdf_[ind1];
                         if (w1 != 0.0f && f1 < 0.98f && f1 >= -0.98f &&
                             f0 * f1 < 0) {
                             float r0 = std::fabs(f0);
@@ -122,16 +115,11 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
                             Eigen::Vector3d p = p0;
                             p(i) = (p0(i) * r1 + p1(i) * r0) / (r0 + r1);
                             pointcloud->points_.push_back(p + origin_);
-                            if (color_type_ == TSDFVolumeColorType::RGB8) {
-                                pointcloud->colors_.push_back(
-                                        ((c0 * r1 + c1 * r0) / (r0 + r1) /
-                                         255.0f)
-                                                .cast<double>());
-                            } else if (color_type_ ==
-                                       TSDFVolumeColorType::Gray32) {
+                            if (color_type_ != TSDFVolumeColorType::NoColor) {
+                                Eigen::Vector3d c0 = voxels_.GetColor(ind0);
+                                Eigen::Vector3d c1 = voxels_.GetColor(ind1);
                                 pointcloud->colors_.push_back(
-                                        ((c0 * r1 + c1 * r0) / (r0 + r1))
-                                                .cast<double>());
+                                        (c0 * r1 + c1 * r0) / (r0 + r1));
                             }
                             // has_normal
                             pointcloud->normals_.push_back(GetNormalAt(p));
@@ -146,88 +134,84 @@ std::shared_ptr<geometry::PointCloud> UniformTSDFVolume::ExtractPointCloud() {
 
 std::shared_ptr<geometry::TriangleMesh>
 UniformTSDFVolume::ExtractTriangleMesh() {
-    // implementation of marching cubes, based on
-    // http://paulbourke.net/geometry/polygonise/
-    auto mesh = std::make_shared<geometry::TriangleMesh>();
-    double half_voxel_length = voxel_length_ * 0.5;
-    // Map of "edge_index = (x, y, z, 0) + edge_shift" to "global vertex index"
-    std::unordered_map<
-            Eigen::Vector4i, int, utility::hash_eigen::hash<Eigen::Vector4i>,
-            std::equal_to<Eigen::Vector4i>,
-            Eigen::aligned_allocator<std::pair<const Eigen::Vector4i, int>>>
-            edgeindex_to_vertexindex;
-    int edge_to_index[12];
-    for (int x = 0; x < resolution_ - 1; x++) {
-        for (int y = 0; y < resolution_ - 1; y++) {
-            for (int z = 0; z < resolution_ - 1; z++) {
-                int cube_index = 0;
-                float f[8];
-                Eigen::Vector3d c[8];
-                for (int i = 0; i < 8; i++) {
-                    Eigen::Vector3i idx = Eigen::Vector3i(x, y, z) + shift[i];
-
-                    if (voxels_[IndexOf(idx)].weight_ == 0.0f) {
-                        cube_index = 0;
-                        break;
-                    } else {
-                        f[i] = voxels_[IndexOf(idx)].tsdf_;
-                        if (f[i] < 0.0f) {
-                            cube_index |= (1 << i);
-                        }
-                        if (color_type_ == TSDFVolumeColorType::RGB8) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>() /
-                                   255.0;
-                        } else if (color_type_ == TSDFVolumeColorType::Gray32) {
-                            c[i] = voxels_[IndexOf(idx)].color_.cast<double>();
-                        }
-                    }
-                }
-                if (cube_index == 0 || cube_index == 255) {
-                    continue;
-                }
-                for (int i = 0; i < 12; i++) {
-                    if (edge_table[cube_index] & (1 << i)) {
-                        Eigen::Vector4i edge_index =
-                                Eigen::Vector4i(x, y, z, 0) + edge_shift[i];
-                        if (edgeindex_to_vertexindex.find(edge_index) ==
-                            edgeindex_to_vertexindex.end()) {
-                            edge_to_index[i] = (int)mesh->vertices_.size();
-                            edgeindex_to_vertexindex[edge_index] =
-                                    (int)mesh->vertices_.size();
-                            Eigen::Vector3d pt(
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(0),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(1),
-                                    half_voxel_length +
-                                            voxel_length_ * edge_index(2));
-                            double f0 = std::abs((double)f[edge_to_vert[i][0]]);
-                            double f1 = std::abs((double)f[edge_to_vert[i][1]]);
-                            pt(edge_index(3)) += f0 * voxel_length_ / (f0 + f1);
-                            mesh->vertices_.push_back(pt + origin_);
-                            if (color_type_ != TSDFVolumeColorType::NoColor) {
-                                const auto &c0 = c[edge_to_vert[i][0]];
-                                const auto &c1 = c[edge_to_vert[i][1]];
-                                mesh->vertex_colors_.push_back(
-                                        (f1 * c0 + f0 * c1) / (f0 + f1));
-                            }
-                        } else {
-                            edge_to_index[i] =
-                                    edgeindex_to_vertexindex.find(edge_index)
-                                            ->second;
-                        }
-                    }
+    // The cubes are split into blocks that are meshed in parallel with
+    // block-local edge tables, and stitched afterwards.
+    const int num_cubes = resolution_ - 1;
+    const int num_blocks =
+            (std::max)(0, (num_cubes + MARCHING_CUBES_BLOCK_SIZE - 1) /
+                                  MARCHING_CUBES_BLOCK_SIZE);
+    const bool with_color = color_type_ != TSDFVolumeColorType::NoColor;
+    std::vector<MarchingCubesChunk> chunks(num_blocks * num_blocks *
+                                           num_blocks);
+#ifdef _OPENMP
+#pragma omp parallel
+    {
+#endif
+        std::vector<int> edge_to_vertex;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (int b = 0; b < (int)chunks.size(); b++) {
+            const Eigen::Vector3i cube_begin =
+                    Eigen::Vector3i(b / (num_blocks * num_blocks),
+                                    b / num_blocks % num_blocks,
+                                    b % num_blocks) *
+                    MARCHING_CUBES_BLOCK_SIZE;
+            const Eigen::Vector3i cube_end =
+                    (cube_begin + Eigen::Vector3i::Constant(
+                                          MARCHING_CUBES_BLOCK_SIZE))
+                            .cwiseMin(Eigen::Vector3i::Constant(num_cubes));
+            auto get_voxel = [&](int x, int y, int z, float &tsdf,
+                                 Eigen::Vector3d &color) -> bool {
+                const int ind = IndexOf(cube_begin(0) + x, cube_begin(1) + y,
+                                        cube_begin(2) + z);
+                if (voxels_.weight_[ind] == 0) {
+                    return false;
                 }
-                for (int i = 0; tri_table[cube_index][i] != -1; i += 3) {
-                    mesh->triangles_.push_back(Eigen::Vector3i(
-                            edge_to_index[tri_table[cube_index][i]],
-                            edge_to_index[tri_table[cube_index][i + 2]],
-                            edge_to_index[tri_table[cube_index][i + 1]]));
+                tsdf = voxels_.tsdf_[ind];
+                if (with_color) {
+                    color = voxels_.GetColor(ind);
                 }
-            }
+                return true;
+            };
+            ExtractMarchingCubesChunk(get_voxel, cube_begin, cube_end,
+                                      voxel_length_, origin_, with_color,
+                                      edge_to_vertex, chunks[b]);
         }
+#ifdef _OPENMP
     }
-    return mesh;
+#endif
+    return MergeMarchingCubesChunks(chunks);
+}
+
+std::shared_ptr<RaycastResult> UniformTSDFVolume::Raycast(
+        const camera::PinholeCameraIntrinsic &intrinsic,
+        const Eigen::Matrix4d &extrinsic,
+        double depth_min /* = 0.1*/,
+        double depth_max /* = 3.0*/) {
+    // Unobserved voxels are mostly behind the observed surfaces or outside
+    // of the camera frustums, they are skipped by the truncation distance.
+    auto sample = [&](const Eigen::Vector3d &p, const Eigen::Vector3d &,
+                      float &tsdf, double &skip) -> bool {
+        skip = sdf_trunc_;
+        return InterpolateTSDF(p - origin_, tsdf, nullptr);
+    };
+    auto shade = [&](const Eigen::Vector3d &p, Eigen::Vector3d &normal,
+                     Eigen::Vector3d &color) -> bool {
+        float tsdf;
+        if (!InterpolateTSDF(p - origin_, tsdf, &color)) {
+            color.setZero();
+        }
+        normal = GetNormalAt(p - origin_);
+        return std::isfinite(normal(0)) && std::isfinite(normal(1)) &&
+               std::isfinite(normal(2));
+    };
+    const double half_voxel_length = voxel_length_ * 0.5;
+    return RaycastTSDF(
+            sample, shade, origin_.array() + half_voxel_length,
+            origin_.array() + (length_ - half_voxel_length), voxel_length_,
+            sdf_trunc_, color_type_, intrinsic, extrinsic, depth_min,
+            depth_max);
 }
 
 std::shared_ptr<geometry::PointCloud>
@@ -244,11 +228,11 @@ UniformTSDFVolume::ExtractVoxelPointCloud() const {
                                    half_voxel_length + voxel_length_ * y,
                                    half_voxel_length + voxel_length_ * z);
                 int ind = IndexOf(x, y, z);
-                if (voxels_[ind].weight_ != 0.0f &&
-                    voxels_[ind].tsdf_ < 0.98f &&
-                    voxels_[ind].tsdf_ >= -0.98f) {
+                const float w = voxels_.weight_[ind];
+                const float f = voxels_.tsdf_[ind];
+                if (w != 0.0f && f < 0.98f && f >= -0.98f) {
                     voxel->points_.push_back(pt + origin_);
-                    double c = (voxels_[ind].tsdf_ + 1.0) * 0.5;
+                    double c = (f + 1.0) * 0.5;
                     voxel->colors_.push_back(Eigen::Vector3d(c, c, c));
                 }
             }
@@ -267,8 +251,8 @@ std::shared_ptr<geometry::VoxelGrid> UniformTSDFVolume::ExtractVoxelGrid()
         for (int y = 0; y < resolution_; y++) {
             for (int z = 0; z < resolution_; z++) {
                 const int ind = IndexOf(x, y, z);
-                const float w = voxels_[ind].weight_;
-                const float f = voxels_[ind].tsdf_;
+                const float w = voxels_.weight_[ind];
+                const float f = voxels_.tsdf_[ind];
                 if (w != 0.0f && f < 0.98f && f >= -0.98f) {
                     double c = (f + 1.0) * 0.5;
                     Eigen::Vector3d color = Eigen::Vector3d(c, c, c);
@@ -286,92 +270,14 @@ void UniformTSDFVolume::IntegrateWithDepthToCameraDistanceMultiplier(
         const camera::PinholeCameraIntrinsic &intrinsic,
         const Eigen::Matrix4d &extrinsic,
         const geometry::Image &depth_to_camera_distance_multiplier) {
-    const float fx = static_cast<float>(intrinsic.GetFocalLength().first);
-    const float fy = static_cast<float>(intrinsic.GetFocalLength().second);
-    const float cx = static_cast<float>(intrinsic.GetPrincipalPoint().first);
-    const float cy = static_cast<float>(intrinsic.GetPrincipalPoint().second);
-    const Eigen::Matrix4f extrinsic_f = extrinsic.cast<float>();
-    const float voxel_length_f = static_cast<float>(voxel_length_);
-    const float half_voxel_length_f = voxel_length_f * 0.5f;
-    const float sdf_trunc_f = static_cast<float>(sdf_trunc_);
-    const float sdf_trunc_inv_f = 1.0f / sdf_trunc_f;
-    const Eigen::Matrix4f extrinsic_scaled_f = extrinsic_f * voxel_length_f;
-    const float safe_width_f = intrinsic.width_ - 0.0001f;
-    const float safe_height_f = intrinsic.height_ - 0.0001f;
-
 #ifdef _OPENMP
-#ifdef _WIN32
 #pragma omp parallel for schedule(static)
-#else
-#pragma omp parallel for collapse(2) schedule(static)
-#endif
 #endif
     for (int x = 0; x < resolution_; x++) {
-        for (int y = 0; y < resolution_; y++) {
-            Eigen::Vector4f pt_3d_homo(float(half_voxel_length_f +
-                                             voxel_length_f * x + origin_(0)),
-                                       float(half_voxel_length_f +
-                                             voxel_length_f * y + origin_(1)),
-                                       float(half_voxel_length_f + origin_(2)),
-                                       1.f);
-            Eigen::Vector4f pt_camera = extrinsic_f * pt_3d_homo;
-            for (int z = 0; z < resolution_; z++,
-                     pt_camera(0) += extrinsic_scaled_f(0, 2),
-                     pt_camera(1) += extrinsic_scaled_f(1, 2),
-                     pt_camera(2) += extrinsic_scaled_f(2, 2)) {
-                // Skip if negative depth after projection
-                if (pt_camera(2) <= 0) {
-                    continue;
-                }
-                // Skip if x-y coordinate not in range
-                float u_f = pt_camera(0) * fx / pt_camera(2) + cx + 0.5f;
-                float v_f = pt_camera(1) * fy / pt_camera(2) + cy + 0.5f;
-                if (!(u_f >= 0.0001f && u_f < safe_width_f && v_f >= 0.0001f &&
-                      v_f < safe_height_f)) {
-                    continue;
-                }
-                // Skip if negative depth in depth image
-                int u = (int)u_f;
-                int v = (int)v_f;
-                float d = *image.depth_.PointerAt<float>(u, v);
-                if (d <= 0.0f) {
-                    continue;
-                }
-
-                int v_ind = IndexOf(x, y, z);
-                float sdf =
-                        (d - pt_camera(2)) *
-                        (*depth_to_camera_distance_multiplier.PointerAt<float>(
-                                u, v));
-                if (sdf > -sdf_trunc_f) {
-                    // integrate
-                    float tsdf = std::min(1.0f, sdf * sdf_trunc_inv_f);
-                    voxels_[v_ind].tsdf_ =
-                            (voxels_[v_ind].tsdf_ * voxels_[v_ind].weight_ +
-                             tsdf) /
-                            (voxels_[v_ind].weight_ + 1.0f);
-                    if (color_type_ == TSDFVolumeColorType::RGB8) {
-                        const uint8_t *rgb =
-                                image.color_.PointerAt<uint8_t>(u, v, 0);
-                        Eigen::Vector3d rgb_f(rgb[0], rgb[1], rgb[2]);
-                        voxels_[v_ind].color_ =
-                                (voxels_[v_ind].color_ *
-                                         voxels_[v_ind].weight_ +
-                                 rgb_f) /
-                                (voxels_[v_ind].weight_ + 1.0f);
-                    } else if (color_type_ == TSDFVolumeColorType::Gray32) {
-                        const float *intensity =
-                                image.color_.PointerAt<float>(u, v, 0);
-                        voxels_[v_ind].color_ =
-                                (voxels_[v_ind].color_.array() *
-                                         voxels_[v_ind].weight_ +
-                                 (*intensity)) /
-                                (voxels_[v_ind].weight_ + 1.0f);
-                    }
-                    voxels_[v_ind].weight_ += 1.0f;
-                }
-            }
-        }
+        IntegrateTSDFColumns(image, intrinsic, extrinsic,
+                             depth_to_camera_distance_multiplier, voxel_length_,
+                             sdf_trunc_, origin_, resolution_, 0,
+                             x * resolution_, (x + 1) * resolution_, voxels_);
     }
 }
 
@@ -394,27 +300,66 @@ double UniformTSDFVolume::GetTSDFAt(const Eigen::Vector3d &p) {
     for (int i = 0; i < 3; i++) {
         idx(i) = (int)std::floor(p_grid(i));
     }
+    for (int i = 0; i < 3; i++) {
+        if (idx(i) < 0 || idx(i) >= resolution_ - 1) {
+            return 0.0;
+        }
+    }
     Eigen::Vector3d r = p_grid - idx.cast<double>();
 
     double tsdf = 0;
     tsdf += (1 - r(0)) * (1 - r(1)) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 0, 0))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(0, 0, 0))];
     tsdf += (1 - r(0)) * (1 - r(1)) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 0, 1))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(0, 0, 1))];
     tsdf += (1 - r(0)) * r(1) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 1, 0))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(0, 1, 0))];
     tsdf += (1 - r(0)) * r(1) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(0, 1, 1))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(0, 1, 1))];
     tsdf += r(0) * (1 - r(1)) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 0, 0))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(1, 0, 0))];
     tsdf += r(0) * (1 - r(1)) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 0, 1))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(1, 0, 1))];
     tsdf += r(0) * r(1) * (1 - r(2)) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 1, 0))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(1, 1, 0))];
     tsdf += r(0) * r(1) * r(2) *
-            voxels_[IndexOf(idx + Eigen::Vector3i(1, 1, 1))].tsdf_;
+            voxels_.tsdf_[IndexOf(idx + Eigen::Vector3i(1, 1, 1))];
     return tsdf;
 }
 
+bool UniformTSDFVolume::InterpolateTSDF(const Eigen::Vector3d &p,
+                                        float &tsdf,
+                                        Eigen::Vector3d *color) const {
+    Eigen::Vector3d p_grid = p / voxel_length_ - Eigen::Vector3d(0.5, 0.5, 0.5);
+    Eigen::Vector3i idx;
+    for (int i = 0; i < 3; i++) {
+        idx(i) = (int)std::floor(p_grid(i));
+        if (idx(i) < 0 || idx(i) >= resolution_ - 1) {
+            return false;
+        }
+    }
+    Eigen::Vector3d r = p_grid - idx.cast<double>();
+    double sum = 0.0;
+    Eigen::Vector3d color_sum(0, 0, 0);
+    for (int i = 0; i < 8; i++) {
+        const int ind = IndexOf(idx + shift[i]);
+        if (voxels_.weight_[ind] == 0) {
+            return false;
+        }
+        double w = (shift[i](0) ? r(0) : 1 - r(0)) *
+                   (shift[i](1) ? r(1) : 1 - r(1)) *
+                   (shift[i](2) ? r(2) : 1 - r(2));
+        sum += w * voxels_.tsdf_[ind];
+        if (color != nullptr) {
+            color_sum += w * voxels_.GetColor(ind);
+        }
+    }
+    tsdf = float(sum);
+    if (color != nullptr) {
+        *color = color_sum;
+    }
+    return true;
+}
+
 }  // namespace integration
 }  // namespace open3d
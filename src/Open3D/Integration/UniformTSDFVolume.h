@@ -28,26 +28,9 @@
 
 #include "Open3D/Geometry/VoxelGrid.h"
 #include "Open3D/Integration/TSDFVolume.h"
+#include "Open3D/Integration/TSDFVoxelArray.h"
 
 namespace open3d {
-
-namespace geometry {
-
-class TSDFVoxel : public Voxel {
-public:
-    TSDFVoxel() : Voxel() {}
-    TSDFVoxel(const Eigen::Vector3i &grid_index) : Voxel(grid_index) {}
-    TSDFVoxel(const Eigen::Vector3i &grid_index, const Eigen::Vector3d &color)
-        : Voxel(grid_index, color) {}
-    ~TSDFVoxel() {}
-
-public:
-    float tsdf_ = 0;
-    float weight_ = 0;
-};
-
-}  // namespace geometry
-
 namespace integration {
 
 /// \class UniformTSDFVolume
@@ -70,6 +53,11 @@ public:
                    const Eigen::Matrix4d &extrinsic) override;
     std::shared_ptr<geometry::PointCloud> ExtractPointCloud() override;
     std::shared_ptr<geometry::TriangleMesh> ExtractTriangleMesh() override;
+    std::shared_ptr<RaycastResult> Raycast(
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            double depth_min = 0.1,
+            double depth_max = 3.0) override;
 
     /// Debug function to extract the voxel data into a VoxelGrid
     std::shared_ptr<geometry::PointCloud> ExtractVoxelPointCloud() const;
@@ -82,7 +70,8 @@ public:
             const geometry::RGBDImage &image,
             const camera::PinholeCameraIntrinsic &intrinsic,
             const Eigen::Matrix4d &extrinsic,
-            const geometry::Image &depth_to_camera_distance_multiplier);
+            const geometry::Image &depth_to_camera_distance_multiplier)
+            override;
 
     inline int IndexOf(int x, int y, int z) const {
         return x * resolution_ * resolution_ + y * resolution_ + z;
@@ -93,7 +82,8 @@ public:
     }
 
 public:
-    std::vector<geometry::TSDFVoxel> voxels_;
+    /// Voxel data, voxel (x, y, z) is stored at IndexOf(x, y, z).
+    TSDFVoxelArray voxels_;
     Eigen::Vector3d origin_;
     /// Total length, where voxel_length = length / resolution.
     double length_;
@@ -107,6 +97,15 @@ private:
     Eigen::Vector3d GetNormalAt(const Eigen::Vector3d &p);
 
     double GetTSDFAt(const Eigen::Vector3d &p);
+
+    /// \brief Trilinearly interpolates the TSDF, and the color if \p color is
+    /// not null, at \p p relative to origin_.
+    ///
+    /// Returns `false` if one of the eight voxels is unobserved or outside the
+    /// volume.
+    bool InterpolateTSDF(const Eigen::Vector3d &p,
+                         float &tsdf,
+                         Eigen::Vector3d *color) const;
 };
 
 }  // namespace integration
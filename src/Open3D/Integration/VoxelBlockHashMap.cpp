@@ -0,0 +1,141 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/VoxelBlockHashMap.h"
+
+namespace open3d {
+namespace integration {
+
+namespace {
+
+/// Smallest table, so that probing always finds an empty slot.
+const size_t kMinNumSlots = 16;
+
+size_t NumSlotsFor(size_t capacity) {
+    size_t num_slots = kMinNumSlots;
+    while (num_slots < 2 * capacity) {
+        num_slots <<= 1;
+    }
+    return num_slots;
+}
+
+}  // unnamed namespace
+
+VoxelBlockHashMap::VoxelBlockHashMap(size_t capacity /* = 0*/) : size_(0) {
+    Allocate(NumSlotsFor(capacity));
+}
+
+VoxelBlockHashMap::VoxelBlockHashMap(const VoxelBlockHashMap &other)
+    : size_(0) {
+    *this = other;
+}
+
+VoxelBlockHashMap &VoxelBlockHashMap::operator=(
+        const VoxelBlockHashMap &other) {
+    if (this == &other) {
+        return *this;
+    }
+    Allocate(other.num_slots_);
+    for (size_t i = 0; i < num_slots_; i++) {
+        keys_[i].store(other.keys_[i].load(), std::memory_order_relaxed);
+        handles_[i].store(other.handles_[i].load(), std::memory_order_relaxed);
+    }
+    size_.store(other.size_.load());
+    indices_ = other.indices_;
+    return *this;
+}
+
+void VoxelBlockHashMap::Clear() {
+    for (size_t i = 0; i < num_slots_; i++) {
+        keys_[i].store(ConcurrentIndexSet::kEmptySlot,
+                       std::memory_order_relaxed);
+        handles_[i].store(-1, std::memory_order_relaxed);
+    }
+    size_.store(0);
+}
+
+void VoxelBlockHashMap::Reserve(size_t capacity) {
+    const size_t num_slots = NumSlotsFor(capacity);
+    if (num_slots <= num_slots_) {
+        return;
+    }
+    // Handles stay valid: the blocks are placed again with their handles.
+    std::vector<Eigen::Vector3i> indices(indices_.begin(),
+                                         indices_.begin() + size());
+    const size_t size = indices.size();
+    Allocate(num_slots);
+    for (size_t handle = 0; handle < size; handle++) {
+        Place(ConcurrentIndexSet::Pack(indices[handle]), int(handle));
+        indices_[handle] = indices[handle];
+    }
+    size_.store(size);
+}
+
+int VoxelBlockHashMap::Insert(const Eigen::Vector3i &index, bool &inserted) {
+    inserted = false;
+    const uint64_t key = ConcurrentIndexSet::Pack(index);
+    size_t slot = ConcurrentIndexSet::Hash(key) & (num_slots_ - 1);
+    for (size_t probe = 0; probe < num_slots_; probe++) {
+        uint64_t current = keys_[slot].load(std::memory_order_acquire);
+        if (current == ConcurrentIndexSet::kEmptySlot) {
+            if (keys_[slot].compare_exchange_strong(
+                        current, key, std::memory_order_acq_rel)) {
+                const int handle = int(size_.fetch_add(1));
+                indices_[handle] = index;
+                handles_[slot].store(handle, std::memory_order_release);
+                inserted = true;
+                return handle;
+            }
+            // Another thread claimed the slot, possibly for this key.
+        }
+        if (current == key) {
+            return WaitForHandle(slot);
+        }
+        slot = (slot + 1) & (num_slots_ - 1);
+    }
+    return -1;
+}
+
+void VoxelBlockHashMap::Allocate(size_t num_slots) {
+    num_slots_ = num_slots;
+    keys_.reset(new std::atomic<uint64_t>[num_slots_]);
+    handles_.reset(new std::atomic<int>[num_slots_]);
+    indices_.assign(num_slots_, Eigen::Vector3i::Zero());
+    Clear();
+}
+
+void VoxelBlockHashMap::Place(uint64_t key, int handle) {
+    size_t slot = ConcurrentIndexSet::Hash(key) & (num_slots_ - 1);
+    while (keys_[slot].load(std::memory_order_relaxed) !=
+           ConcurrentIndexSet::kEmptySlot) {
+        slot = (slot + 1) & (num_slots_ - 1);
+    }
+    keys_[slot].store(key, std::memory_order_relaxed);
+    handles_[slot].store(handle, std::memory_order_relaxed);
+}
+
+}  // namespace integration
+}  // namespace open3d
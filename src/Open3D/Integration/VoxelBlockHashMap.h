@@ -0,0 +1,131 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Open3D/Integration/ConcurrentIndexSet.h"
+
+namespace open3d {
+namespace integration {
+
+/// \class VoxelBlockHashMap
+///
+/// \brief Spatial hash from 3D block indices to dense integer handles.
+///
+/// The map is an open addressing hash table with linear probing over packed
+/// keys, see ConcurrentIndexSet::Pack(). The blocks are numbered 0, 1, 2, ...
+/// in insertion order, so that their data can live in contiguous arrays
+/// indexed by handle. Handles are never reused until Clear().
+///
+/// Find() and Insert() are lock free and may run concurrently, as long as
+/// the table does not fill up: Reserve() for the expected number of blocks
+/// before inserting from several threads.
+class VoxelBlockHashMap {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param capacity Number of blocks to reserve space for.
+    explicit VoxelBlockHashMap(size_t capacity = 0);
+    VoxelBlockHashMap(const VoxelBlockHashMap &other);
+    VoxelBlockHashMap &operator=(const VoxelBlockHashMap &other);
+    ~VoxelBlockHashMap() {}
+
+public:
+    /// Returns the number of blocks.
+    size_t size() const { return size_.load(); }
+    /// Returns `true` if there are no blocks.
+    bool empty() const { return size() == 0; }
+    /// Removes all blocks.
+    void Clear();
+    /// \brief Grows the table to hold \p capacity blocks at a load factor of
+    /// at most 0.5. Handles are kept. Must not run concurrently with other
+    /// functions.
+    void Reserve(size_t capacity);
+
+    /// Returns the handle of block \p index, or -1 if it is not in the map.
+    int Find(const Eigen::Vector3i &index) const {
+        const uint64_t key = ConcurrentIndexSet::Pack(index);
+        size_t slot = ConcurrentIndexSet::Hash(key) & (num_slots_ - 1);
+        for (size_t probe = 0; probe < num_slots_; probe++) {
+            const uint64_t current =
+                    keys_[slot].load(std::memory_order_acquire);
+            if (current == key) {
+                return WaitForHandle(slot);
+            }
+            if (current == ConcurrentIndexSet::kEmptySlot) {
+                return -1;
+            }
+            slot = (slot + 1) & (num_slots_ - 1);
+        }
+        return -1;
+    }
+
+    /// \brief Inserts block \p index if it is not in the map.
+    ///
+    /// \param index Index of the block.
+    /// \param inserted Set to `true` if the block was inserted by this call.
+    /// \return The handle of the block, or -1 if the table is full.
+    int Insert(const Eigen::Vector3i &index, bool &inserted);
+
+    /// Returns the index of the block with handle \p handle.
+    const Eigen::Vector3i &GetIndex(int handle) const {
+        return indices_[handle];
+    }
+
+private:
+    /// A key is published before its handle, readers that find the key wait
+    /// for the inserting thread to store the handle.
+    int WaitForHandle(size_t slot) const {
+        int handle;
+        while ((handle = handles_[slot].load(std::memory_order_acquire)) < 0) {
+        }
+        return handle;
+    }
+
+    /// Allocates an empty table of \p num_slots slots, a power of two.
+    void Allocate(size_t num_slots);
+
+    /// Stores \p key with \p handle, single threaded.
+    void Place(uint64_t key, int handle);
+
+private:
+    size_t num_slots_;
+    std::unique_ptr<std::atomic<uint64_t>[]> keys_;
+    std::unique_ptr<std::atomic<int>[]> handles_;
+    std::atomic<size_t> size_;
+    /// Block index of each handle, with one entry per slot so that
+    /// concurrent insertions never reallocate it.
+    std::vector<Eigen::Vector3i> indices_;
+};
+
+}  // namespace integration
+}  // namespace open3d
@@ -76,26 +76,29 @@ private:
 };
 
 std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
-        const geometry::PointCloud &target,
-        const geometry::KDTreeSearchParamHybrid &search_param) {
+        const geometry::PointCloud &target) {
     utility::LogDebug("InitializePointCloudForColoredICP");
 
-    geometry::KDTreeFlann tree;
-    tree.SetGeometry(target);
-
     auto output = std::make_shared<PointCloudForColoredICP>();
     output->colors_ = target.colors_;
     output->normals_ = target.normals_;
     output->points_ = target.points_;
+    return output;
+}
 
-    size_t n_points = output->points_.size();
-    output->color_gradient_.resize(n_points, Eigen::Vector3d::Zero());
+/// Estimates the color gradients of output, tree is a KDTree on its points.
+void ComputeColorGradients(
+        PointCloudForColoredICP &output,
+        const geometry::KDTreeFlann &tree,
+        const geometry::KDTreeSearchParamHybrid &search_param) {
+    size_t n_points = output.points_.size();
+    output.color_gradient_.resize(n_points, Eigen::Vector3d::Zero());
 
     for (size_t k = 0; k < n_points; k++) {
-        const Eigen::Vector3d &vt = output->points_[k];
-        const Eigen::Vector3d &nt = output->normals_[k];
-        double it = (output->colors_[k](0) + output->colors_[k](1) +
-                     output->colors_[k](2)) /
+        const Eigen::Vector3d &vt = output.points_[k];
+        const Eigen::Vector3d &nt = output.normals_[k];
+        double it = (output.colors_[k](0) + output.colors_[k](1) +
+                     output.colors_[k](2)) /
                     3.0;
 
         std::vector<int> point_idx;
@@ -111,11 +114,11 @@ std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
             b.setZero();
             for (size_t i = 1; i < nn; i++) {
                 int P_adj_idx = point_idx[i];
-                Eigen::Vector3d vt_adj = output->points_[P_adj_idx];
+                Eigen::Vector3d vt_adj = output.points_[P_adj_idx];
                 Eigen::Vector3d vt_proj = vt_adj - (vt_adj - vt).dot(nt) * nt;
-                double it_adj = (output->colors_[P_adj_idx](0) +
-                                 output->colors_[P_adj_idx](1) +
-                                 output->colors_[P_adj_idx](2)) /
+                double it_adj = (output.colors_[P_adj_idx](0) +
+                                 output.colors_[P_adj_idx](1) +
+                                 output.colors_[P_adj_idx](2)) /
                                 3.0;
                 A(i - 1, 0) = (vt_proj(0) - vt(0));
                 A(i - 1, 1) = (vt_proj(1) - vt(1));
@@ -133,11 +136,10 @@ std::shared_ptr<PointCloudForColoredICP> InitializePointCloudForColoredICP(
             std::tie(is_success, x) = utility::SolveLinearSystemPSD(
                     A.transpose() * A, A.transpose() * b);
             if (is_success) {
-                output->color_gradient_[k] = x;
+                output.color_gradient_[k] = x;
             }
         }
     }
-    return output;
 }
 
 Eigen::Matrix4d TransformationEstimationForColoredICP::ComputeTransformation(
@@ -248,6 +250,18 @@ double TransformationEstimationForColoredICP::ComputeRMSE(
 
 namespace registration {
 
+std::shared_ptr<RegistrationContext> CreateRegistrationContextForColoredICP(
+        const geometry::PointCloud &target, double max_distance) {
+    auto target_c = InitializePointCloudForColoredICP(target);
+    auto context = std::make_shared<RegistrationContext>(
+            std::shared_ptr<const geometry::PointCloud>(target_c));
+    // The color gradients are estimated with the KDTree of the context.
+    ComputeColorGradients(
+            *target_c, context->GetTargetKDTree(),
+            geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
+    return context;
+}
+
 RegistrationResult RegistrationColoredICP(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
@@ -255,10 +269,26 @@ RegistrationResult RegistrationColoredICP(
         const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
         const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
         double lambda_geometric /* = 0.968*/) {
-    auto target_c = InitializePointCloudForColoredICP(
-            target, geometry::KDTreeSearchParamHybrid(max_distance * 2.0, 30));
+    auto context = CreateRegistrationContextForColoredICP(target, max_distance);
+    return RegistrationColoredICP(source, *context, max_distance, init,
+                                  criteria, lambda_geometric);
+}
+
+RegistrationResult RegistrationColoredICP(
+        const geometry::PointCloud &source,
+        RegistrationContext &context,
+        double max_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const ICPConvergenceCriteria &criteria /* = ICPConvergenceCriteria()*/,
+        double lambda_geometric /* = 0.968*/) {
+    if (dynamic_cast<const PointCloudForColoredICP *>(&context.GetTarget()) ==
+        nullptr) {
+        utility::LogError(
+                "RegistrationColoredICP requires a context created by "
+                "CreateRegistrationContextForColoredICP.");
+    }
     return RegistrationICP(
-            source, *target_c, max_distance, init,
+            source, context, max_distance, init,
             TransformationEstimationForColoredICP(lambda_geometric), criteria);
 }
 
@@ -27,6 +27,7 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <memory>
 
 #include "Open3D/Registration/Registration.h"
 
@@ -39,6 +40,18 @@ class PointCloud;
 namespace registration {
 class RegistrationResult;
 
+/// \brief Creates a RegistrationContext for RegistrationColoredICP().
+///
+/// The target is copied once and its color gradients are estimated with the
+/// KDTree of the context, so that repeated colored ICP registrations against
+/// the same target do not recompute them.
+///
+/// \param target The target point cloud, with normals and colors.
+/// \param max_distance Maximum correspondence points-pair distance. The color
+/// gradients are estimated in a neighborhood of radius 2 * max_distance.
+std::shared_ptr<RegistrationContext> CreateRegistrationContextForColoredICP(
+        const geometry::PointCloud &target, double max_distance);
+
 /// \brief Function for Colored ICP registration.
 ///
 /// This is implementation of following paper
@@ -60,5 +73,22 @@ RegistrationResult RegistrationColoredICP(
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
         double lambda_geometric = 0.968);
 
+/// \brief Function for Colored ICP registration against the target of a
+/// RegistrationContext.
+///
+/// \param source The source point cloud.
+/// \param context Context created by CreateRegistrationContextForColoredICP().
+/// \param max_distance Maximum correspondence points-pair distance.
+/// \param init Initial transformation estimation.
+/// \param criteria Convergence criteria.
+/// \param lambda_geometric lambda_geometric value.
+RegistrationResult RegistrationColoredICP(
+        const geometry::PointCloud &source,
+        RegistrationContext &context,
+        double max_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria(),
+        double lambda_geometric = 0.968);
+
 }  // namespace registration
 }  // namespace open3d
@@ -57,8 +57,12 @@ std::vector<std::pair<int, int>> AdvancedMatching(
     // STEP 1) Initial matching
     int nPti = int(point_cloud_vec[fi].points_.size());
     int nPtj = int(point_cloud_vec[fj].points_.size());
-    geometry::KDTreeFlann feature_tree_i(features_vec[fi]);
-    geometry::KDTreeFlann feature_tree_j(features_vec[fj]);
+    // Descriptors are matched with float indices, which halve the memory
+    // traffic of the search.
+    geometry::KDTreeFlann feature_tree_i(
+            features_vec[fi], geometry::KDTreeFlann::Precision::Float32);
+    geometry::KDTreeFlann feature_tree_j(
+            features_vec[fj], geometry::KDTreeFlann::Precision::Float32);
     std::vector<int> corresK;
     std::vector<double> dis;
     std::vector<std::pair<int, int>> corres;
@@ -73,8 +73,8 @@ Eigen::Vector4d ComputePairFeatures(const Eigen::Vector3d &p1,
 
 std::shared_ptr<Feature> ComputeSPFHFeature(
         const geometry::PointCloud &input,
-        const geometry::KDTreeFlann &kdtree,
-        const geometry::KDTreeSearchParam &search_param) {
+        const std::vector<int> &offsets,
+        const std::vector<int> &indices) {
     auto feature = std::make_shared<Feature>();
     feature->Resize(33, (int)input.points_.size());
 #ifdef _OPENMP
@@ -83,12 +83,12 @@ std::shared_ptr<Feature> ComputeSPFHFeature(
     for (int i = 0; i < (int)input.points_.size(); i++) {
         const auto &point = input.points_[i];
         const auto &normal = input.normals_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
+        int begin = offsets[i];
+        int end = offsets[i + 1];
+        if (end - begin > 1) {
             // only compute SPFH feature when a point has neighbors
-            double hist_incr = 100.0 / (double)(indices.size() - 1);
-            for (size_t k = 1; k < indices.size(); k++) {
+            double hist_incr = 100.0 / (double)(end - begin - 1);
+            for (int k = begin + 1; k < end; k++) {
                 // skip the point itself, compute histogram
                 auto pf = ComputePairFeatures(point, normal,
                                               input.points_[indices[k]],
@@ -125,18 +125,27 @@ std::shared_ptr<Feature> ComputeFPFHFeature(
                 "[ComputeFPFHFeature] Failed because input point cloud has no "
                 "normal.");
     }
+    // The neighborhoods are searched once and shared by the SPFH and the FPFH
+    // passes, in compressed sparse row layout: the neighbors of point i are
+    // indices[offsets[i]:offsets[i + 1]].
     geometry::KDTreeFlann kdtree(input);
-    auto spfh = ComputeSPFHFeature(input, kdtree, search_param);
+    std::vector<int> offsets;
+    std::vector<int> indices;
+    std::vector<double> distance2;
+    if (kdtree.BatchSearch(input.points_, search_param, offsets, indices,
+                           distance2) < 0) {
+        return feature;
+    }
+    auto spfh = ComputeSPFHFeature(input, offsets, indices);
 #ifdef _OPENMP
 #pragma omp parallel for schedule(static)
 #endif
     for (int i = 0; i < (int)input.points_.size(); i++) {
-        const auto &point = input.points_[i];
-        std::vector<int> indices;
-        std::vector<double> distance2;
-        if (kdtree.Search(point, search_param, indices, distance2) > 1) {
+        int begin = offsets[i];
+        int end = offsets[i + 1];
+        if (end - begin > 1) {
             double sum[3] = {0.0, 0.0, 0.0};
-            for (size_t k = 1; k < indices.size(); k++) {
+            for (int k = begin + 1; k < end; k++) {
                 // skip the point itself
                 double dist = distance2[k];
                 if (dist == 0.0) continue;
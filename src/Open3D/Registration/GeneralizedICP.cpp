@@ -0,0 +1,183 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/GeneralizedICP.h"
+
+#include <Eigen/Dense>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Eigen.h"
+
+namespace open3d {
+
+namespace {
+using namespace registration;
+
+/// Copies cloud and prepares the covariances of the copy, see
+/// PreparePointCloudForGeneralizedICP().
+std::shared_ptr<geometry::PointCloud> InitializePointCloudForGeneralizedICP(
+        const geometry::PointCloud &cloud, double epsilon) {
+    utility::LogDebug("InitializePointCloudForGeneralizedICP");
+
+    // Generalized ICP only reads the points and the covariances, so normals
+    // and colors are not copied.
+    auto output = std::make_shared<geometry::PointCloud>();
+    output->points_ = cloud.points_;
+    output->covariances_ = cloud.covariances_;
+    PreparePointCloudForGeneralizedICP(*output, epsilon);
+    return output;
+}
+
+/// Returns W with W^T * W = (Cs + Ct)^-1, which whitens the residual vs - vt.
+/// W is the inverse of the Cholesky factor of Cs + Ct, which is much cheaper
+/// than its inverse square root and gives the same Mahalanobis distance and
+/// normal equations.
+Eigen::Matrix3d GetWhiteningMatrix(const Eigen::Matrix3d &Cs,
+                                   const Eigen::Matrix3d &Ct) {
+    const Eigen::Matrix3d C = Cs + Ct;
+    Eigen::LLT<Eigen::Matrix3d> llt(C);
+    if (llt.info() == Eigen::Success) {
+        return llt.matrixL().solve(Eigen::Matrix3d::Identity());
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(C);
+    return solver.operatorInverseSqrt();
+}
+
+}  // unnamed namespace
+
+namespace registration {
+
+double TransformationEstimationForGeneralizedICP::ComputeRMSE(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    if (corres.empty() || !target.HasCovariances() ||
+        !source.HasCovariances()) {
+        return 0.0;
+    }
+    double err = 0.0;
+    for (const auto &c : corres) {
+        const Eigen::Vector3d d = source.points_[c[0]] - target.points_[c[1]];
+        const Eigen::Matrix3d W = GetWhiteningMatrix(
+                source.covariances_[c[0]], target.covariances_[c[1]]);
+        err += (W * d).squaredNorm();
+    }
+    return std::sqrt(err / (double)corres.size());
+}
+
+Eigen::Matrix4d
+TransformationEstimationForGeneralizedICP::ComputeTransformation(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    if (corres.empty() || !target.HasCovariances() ||
+        !source.HasCovariances()) {
+        return Eigen::Matrix4d::Identity();
+    }
+
+    // Each correspondence contributes the three rows of W * [-[vs]x | I],
+    // with W the whitening matrix of its combined covariance. The robust
+    // weight of the Mahalanobis distance is folded into the rows as sqrt(w).
+    auto compute_jacobian_and_residual =
+            [&](int i,
+                std::vector<Eigen::Vector6d, utility::Vector6d_allocator> &J_r,
+                std::vector<double> &r) {
+                const Eigen::Vector3d &vs = source.points_[corres[i][0]];
+                const Eigen::Vector3d &vt = target.points_[corres[i][1]];
+                const Eigen::Matrix3d W =
+                        GetWhiteningMatrix(source.covariances_[corres[i][0]],
+                                           target.covariances_[corres[i][1]]);
+                const Eigen::Vector3d residual = W * (vs - vt);
+                const double sqrt_w =
+                        std::sqrt(kernel_->Weight(residual.norm()));
+
+                J_r.resize(3);
+                r.resize(3);
+                for (int k = 0; k < 3; k++) {
+                    const Eigen::Vector3d w_k = sqrt_w * W.row(k).transpose();
+                    J_r[k].block<3, 1>(0, 0) = vs.cross(w_k);
+                    J_r[k].block<3, 1>(3, 0) = w_k;
+                    r[k] = sqrt_w * residual(k);
+                }
+            };
+
+    Eigen::Matrix6d JTJ;
+    Eigen::Vector6d JTr;
+    double r2;
+    std::tie(JTJ, JTr, r2) =
+            utility::ComputeJTJandJTr<Eigen::Matrix6d, Eigen::Vector6d>(
+                    compute_jacobian_and_residual, (int)corres.size());
+
+    bool is_success;
+    Eigen::Matrix4d extrinsic;
+    std::tie(is_success, extrinsic) =
+            utility::SolveJacobianSystemAndObtainExtrinsicMatrix(JTJ, JTr);
+
+    return is_success ? extrinsic : Eigen::Matrix4d::Identity();
+}
+
+void PreparePointCloudForGeneralizedICP(
+        geometry::PointCloud &cloud,
+        double epsilon /* = 1e-3*/,
+        const geometry::KDTreeSearchParam &search_param
+        /* = geometry::KDTreeSearchParamKNN(20)*/) {
+    if (!cloud.HasCovariances()) {
+        cloud.EstimateCovariances(search_param);
+    }
+
+    const Eigen::Vector3d values(1.0, 1.0, epsilon);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < (int)cloud.covariances_.size(); i++) {
+        Eigen::JacobiSVD<Eigen::Matrix3d> svd(cloud.covariances_[i],
+                                              Eigen::ComputeFullU);
+        const Eigen::Matrix3d &U = svd.matrixU();
+        cloud.covariances_[i] = U * values.asDiagonal() * U.transpose();
+    }
+}
+
+RegistrationResult RegistrationGeneralizedICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimationForGeneralizedICP &estimation
+        /* = TransformationEstimationForGeneralizedICP()*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    auto source_c =
+            InitializePointCloudForGeneralizedICP(source, estimation.epsilon_);
+    auto target_c =
+            InitializePointCloudForGeneralizedICP(target, estimation.epsilon_);
+    return RegistrationICP(*source_c, *target_c, max_correspondence_distance,
+                           init, estimation, criteria);
+}
+
+}  // namespace registration
+}  // namespace open3d
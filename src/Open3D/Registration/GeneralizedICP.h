@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <memory>
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Registration/Registration.h"
+#include "Open3D/Registration/RobustKernel.h"
+#include "Open3D/Registration/TransformationEstimation.h"
+
+namespace open3d {
+
+namespace geometry {
+class PointCloud;
+}
+
+namespace registration {
+
+class RegistrationResult;
+
+/// \class TransformationEstimationForGeneralizedICP
+///
+/// Class to estimate a transformation for Generalized ICP (plane to plane).
+///
+/// The residual of a correspondence (p, q) is the Mahalanobis distance of
+/// p - q under the combined covariance C_p + C_q, so both point clouds must
+/// have per-point covariances. See A. Segal, D. Haehnel, S. Thrun,
+/// Generalized-ICP, RSS 2009.
+class TransformationEstimationForGeneralizedICP
+    : public TransformationEstimation {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param epsilon Smallest eigenvalue of the regularized covariances,
+    /// relative to the other two which are set to 1.
+    /// \param kernel The robust loss function applied to the Mahalanobis
+    /// distance of each correspondence.
+    explicit TransformationEstimationForGeneralizedICP(
+            double epsilon = 1e-3,
+            std::shared_ptr<RobustKernel> kernel = std::make_shared<L2Loss>())
+        : epsilon_(epsilon), kernel_(std::move(kernel)) {}
+    ~TransformationEstimationForGeneralizedICP() override {}
+
+public:
+    TransformationEstimationType GetTransformationEstimationType()
+            const override {
+        return type_;
+    };
+    double ComputeRMSE(const geometry::PointCloud &source,
+                       const geometry::PointCloud &target,
+                       const CorrespondenceSet &corres) const override;
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::PointCloud &source,
+            const geometry::PointCloud &target,
+            const CorrespondenceSet &corres) const override;
+
+public:
+    /// Smallest eigenvalue of the regularized covariances.
+    double epsilon_ = 1e-3;
+    /// The robust loss function used in the optimization.
+    std::shared_ptr<RobustKernel> kernel_ = std::make_shared<L2Loss>();
+
+private:
+    const TransformationEstimationType type_ =
+            TransformationEstimationType::GeneralizedICP;
+};
+
+/// \brief Function to prepare the covariances of a point cloud for
+/// Generalized ICP, in place.
+///
+/// Covariances are estimated with \p search_param if the point cloud has
+/// none, then regularized to the eigenvalues (1, 1, epsilon) so that each one
+/// describes a local plane.
+///
+/// \param cloud The point cloud.
+/// \param epsilon Smallest eigenvalue of the regularized covariances.
+/// \param search_param The KDTree search parameters used to estimate missing
+/// covariances.
+void PreparePointCloudForGeneralizedICP(
+        geometry::PointCloud &cloud,
+        double epsilon = 1e-3,
+        const geometry::KDTreeSearchParam &search_param =
+                geometry::KDTreeSearchParamKNN(20));
+
+/// \brief Function for Generalized ICP registration.
+///
+/// Point clouds without covariances get them estimated from their 20 nearest
+/// neighbors. The covariances are then regularized to the eigenvalues
+/// (1, 1, epsilon) of \p estimation, so that each one describes a local plane.
+/// Both steps work on copies, the inputs are not modified. Covariances
+/// estimated once with geometry::PointCloud::EstimateCovariances() are reused
+/// across calls.
+///
+/// \param source The source point cloud.
+/// \param target The target point cloud.
+/// \param max_correspondence_distance Maximum correspondence points-pair
+/// distance.
+/// \param init Initial transformation estimation.
+/// \param estimation Estimation method.
+/// \param criteria Convergence criteria.
+RegistrationResult RegistrationGeneralizedICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimationForGeneralizedICP &estimation =
+                TransformationEstimationForGeneralizedICP(),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+
+}  // namespace registration
+}  // namespace open3d
@@ -28,6 +28,7 @@
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <algorithm>
 #include <tuple>
 #include <vector>
 
@@ -192,6 +193,67 @@ Eigen::VectorXd ComputeZeta(const PoseGraph &pose_graph) {
     return output;
 }
 
+/// Function to create the sparsity pattern of H. H is block sparse with 6x6
+/// blocks: one diagonal block per node and one off-diagonal block per pair of
+/// nodes connected by an edge. Only the lower triangular half is stored, as
+/// this is all the sparse Cholesky solver reads. The pattern does not change
+/// while optimizing a given pose graph, so it is built once and the symbolic
+/// analysis of the solver is reused in every iteration.
+Eigen::SparseMatrix<double> CreateLinearSystemPattern(
+        const PoseGraph &pose_graph) {
+    int n_nodes = (int)pose_graph.nodes_.size();
+    int n_edges = (int)pose_graph.edges_.size();
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(n_nodes * 21 + n_edges * 36);
+    for (int iter_node = 0; iter_node < n_nodes; iter_node++) {
+        int id = iter_node * 6;
+        for (int c = 0; c < 6; c++) {
+            for (int r = c; r < 6; r++) {
+                triplets.emplace_back(id + r, id + c, 0.0);
+            }
+        }
+    }
+    for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
+        const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
+        if (t.source_node_id_ == t.target_node_id_) continue;
+        int id_r = (std::max)(t.source_node_id_, t.target_node_id_) * 6;
+        int id_c = (std::min)(t.source_node_id_, t.target_node_id_) * 6;
+        for (int c = 0; c < 6; c++) {
+            for (int r = 0; r < 6; r++) {
+                triplets.emplace_back(id_r + r, id_c + c, 0.0);
+            }
+        }
+    }
+    Eigen::SparseMatrix<double> H(n_nodes * 6, n_nodes * 6);
+    H.setFromTriplets(triplets.begin(), triplets.end());
+    H.makeCompressed();
+    return H;
+}
+
+/// Function to add a 6x6 block to the lower triangular part of H at block
+/// position (id_r, id_c), id_r >= id_c. The block must be part of the pattern
+/// created by CreateLinearSystemPattern(). If the block is on the diagonal
+/// only its lower triangular part is added.
+void AddBlockToLinearSystem(Eigen::SparseMatrix<double> &H,
+                            int id_r,
+                            int id_c,
+                            const Eigen::Matrix6d &block) {
+    const int *outer = H.outerIndexPtr();
+    const int *inner = H.innerIndexPtr();
+    double *values = H.valuePtr();
+    for (int c = 0; c < 6; c++) {
+        int col = id_c + c;
+        int r_begin = (id_r == id_c) ? c : 0;
+        // Rows of a block column are stored contiguously and sorted.
+        const int *it = std::lower_bound(
+                inner + outer[col], inner + outer[col + 1], id_r + r_begin);
+        double *v = values + (it - inner);
+        for (int r = r_begin; r < 6; r++) {
+            *v++ += block(r, c);
+        }
+    }
+}
+
 /// The information matrix used here is consistent with [Choi et al 2015].
 /// It is [-p_x | I]^T[-p_x | I]. \zeta is [\alpha \beta \gamma a b c]
 /// Another definition of information matrix used for [Kümmerle et al 2011] is
@@ -205,14 +267,17 @@ Eigen::VectorXd ComputeZeta(const PoseGraph &pose_graph) {
 ///
 /// This function focuses the case that every edge has two nodes (not hyper
 /// graph) so we have two Jacobian matrices from one constraint.
-std::tuple<Eigen::MatrixXd, Eigen::VectorXd> ComputeLinearSystem(
-        const PoseGraph &pose_graph, const Eigen::VectorXd &zeta) {
+///
+/// H must have the pattern created by CreateLinearSystemPattern(). Its values
+/// are overwritten; only the lower triangular part is filled.
+void ComputeLinearSystem(const PoseGraph &pose_graph,
+                         const Eigen::VectorXd &zeta,
+                         Eigen::SparseMatrix<double> &H,
+                         Eigen::VectorXd &b) {
     int n_nodes = (int)pose_graph.nodes_.size();
     int n_edges = (int)pose_graph.edges_.size();
-    Eigen::MatrixXd H(n_nodes * 6, n_nodes * 6);
-    Eigen::VectorXd b(n_nodes * 6);
-    H.setZero();
-    b.setZero();
+    std::fill(H.valuePtr(), H.valuePtr() + H.nonZeros(), 0.0);
+    b.setZero(n_nodes * 6);
 
     for (int iter_edge = 0; iter_edge < n_edges; iter_edge++) {
         const PoseGraphEdge &t = pose_graph.edges_[iter_edge];
@@ -230,20 +295,87 @@ std::tuple<Eigen::MatrixXd, Eigen::VectorXd> ComputeLinearSystem(
 
         int id_i = t.source_node_id_ * 6;
         int id_j = t.target_node_id_ * 6;
-        H.block<6, 6>(id_i, id_i).noalias() +=
-                line_process_iter * JsT_Info * Js;
-        H.block<6, 6>(id_i, id_j).noalias() +=
-                line_process_iter * JsT_Info * Jt;
-        H.block<6, 6>(id_j, id_i).noalias() +=
-                line_process_iter * JtT_Info * Js;
-        H.block<6, 6>(id_j, id_j).noalias() +=
-                line_process_iter * JtT_Info * Jt;
+        Eigen::Matrix6d H_ii, H_ij, H_jj;
+        H_ii.noalias() = line_process_iter * JsT_Info * Js;
+        H_ij.noalias() = line_process_iter * JsT_Info * Jt;
+        H_jj.noalias() = line_process_iter * JtT_Info * Jt;
+        if (id_i == id_j) {
+            Eigen::Matrix6d H_sum = H_ii + H_ij + H_ij.transpose() + H_jj;
+            AddBlockToLinearSystem(H, id_i, id_i, H_sum);
+        } else {
+            AddBlockToLinearSystem(H, id_i, id_i, H_ii);
+            AddBlockToLinearSystem(H, id_j, id_j, H_jj);
+            if (id_i > id_j) {
+                AddBlockToLinearSystem(H, id_i, id_j, H_ij);
+            } else {
+                Eigen::Matrix6d H_ji = H_ij.transpose();
+                AddBlockToLinearSystem(H, id_j, id_i, H_ji);
+            }
+        }
         b.block<6, 1>(id_i, 0).noalias() -=
                 line_process_iter * eT_Info.transpose() * Js;
         b.block<6, 1>(id_j, 0).noalias() -=
                 line_process_iter * eT_Info.transpose() * Jt;
     }
-    return std::make_tuple(std::move(H), std::move(b));
+}
+
+/// Function to add lambda to the diagonal of H_LM, which must share the
+/// pattern created by CreateLinearSystemPattern().
+void AddToDiagonal(Eigen::SparseMatrix<double> &H_LM, double lambda) {
+    const int *outer = H_LM.outerIndexPtr();
+    double *values = H_LM.valuePtr();
+    // The diagonal coefficient is the first stored entry of each column of
+    // the lower triangular pattern.
+    for (int col = 0; col < H_LM.cols(); col++) {
+        values[outer[col]] += lambda;
+    }
+}
+
+/// Function to fix the gauge freedom of H. The residuals only depend on the
+/// relative poses, so H has a 6 dimensional null space and the first node is
+/// anchored by adding a prior on the diagonal of its block. The prior does not
+/// change the step of the other nodes relative to the first one.
+void AnchorFirstNode(Eigen::SparseMatrix<double> &H) {
+    if (H.cols() < 6) {
+        return;
+    }
+    const int *outer = H.outerIndexPtr();
+    double *values = H.valuePtr();
+    double weight = 0.0;
+    for (int col = 0; col < H.cols(); col++) {
+        weight = (std::max)(weight, values[outer[col]]);
+    }
+    if (weight <= 0.0) {
+        weight = 1.0;
+    }
+    for (int col = 0; col < 6; col++) {
+        values[outer[col]] += weight;
+    }
+}
+
+/// Sparse Cholesky solver for H. It reads the lower triangular part of H
+/// only. analyzePattern() is called once per optimization, and numerical
+/// factorization is repeated in each iteration.
+using SparseSolver = Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>,
+                                           Eigen::Lower,
+                                           Eigen::AMDOrdering<int>>;
+
+/// Function to solve H @ x == b with a solver whose symbolic analysis has
+/// already been done on the pattern of H. H must be positive definite, see
+/// AnchorFirstNode().
+std::tuple<bool, Eigen::VectorXd> SolveLinearSystem(
+        SparseSolver &solver,
+        const Eigen::SparseMatrix<double> &H,
+        const Eigen::VectorXd &b) {
+    solver.factorize(H);
+    if (solver.info() != Eigen::Success) {
+        return std::make_tuple(false, Eigen::VectorXd::Zero(b.rows()));
+    }
+    Eigen::VectorXd x = solver.solve(b);
+    if (solver.info() != Eigen::Success || !x.allFinite()) {
+        return std::make_tuple(false, Eigen::VectorXd::Zero(b.rows()));
+    }
+    return std::make_tuple(true, std::move(x));
 }
 
 Eigen::VectorXd UpdatePoseVector(const PoseGraph &pose_graph) {
@@ -511,11 +643,15 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
     valid_edges_num =
             UpdateConfidence(pose_graph, zeta, line_process_weight, option);
 
-    Eigen::MatrixXd H;
+    Eigen::SparseMatrix<double> H = CreateLinearSystemPattern(pose_graph);
     Eigen::VectorXd b;
     Eigen::VectorXd x = UpdatePoseVector(pose_graph);
 
-    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+    ComputeLinearSystem(pose_graph, zeta, H, b);
+    AnchorFirstNode(H);
+
+    SparseSolver solver;
+    solver.analyzePattern(H);
 
     utility::LogDebug("[Initial     ] residual : {:e}", current_residual);
 
@@ -532,10 +668,14 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
         Eigen::VectorXd delta(H.cols());
         bool solver_success = false;
 
-        // Solve H_LM @ delta == b using a sparse solver
-        std::tie(solver_success, delta) = utility::SolveLinearSystemPSD(
-                H, b, /*prefer_sparse=*/true, /*check_symmetric=*/false,
-                /*check_det=*/false, /*check_psd=*/false);
+        // Solve H @ delta == b using a sparse solver
+        std::tie(solver_success, delta) = SolveLinearSystem(solver, H, b);
+        if (!solver_success) {
+            utility::LogWarning(
+                    "[GlobalOptimizationGaussNewton] Failed to solve the "
+                    "linear system.");
+            break;
+        }
 
         stop = stop || CheckRelativeIncrement(delta, x, criteria);
         if (stop) {
@@ -558,7 +698,8 @@ void GlobalOptimizationGaussNewton::OptimizePoseGraph(
             x = UpdatePoseVector(pose_graph);
             valid_edges_num = UpdateConfidence(pose_graph, zeta,
                                                line_process_weight, option);
-            std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+            ComputeLinearSystem(pose_graph, zeta, H, b);
+            AnchorFirstNode(H);
 
             stop = stop || CheckRightTerm(b, criteria);
             if (stop) break;
@@ -602,12 +743,15 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
     int valid_edges_num =
             UpdateConfidence(pose_graph, zeta, line_process_weight, option);
 
-    Eigen::MatrixXd H_I = Eigen::MatrixXd::Identity(n_nodes * 6, n_nodes * 6);
-    Eigen::MatrixXd H;
+    Eigen::SparseMatrix<double> H = CreateLinearSystemPattern(pose_graph);
+    Eigen::SparseMatrix<double> H_LM = H;
     Eigen::VectorXd b;
     Eigen::VectorXd x = UpdatePoseVector(pose_graph);
 
-    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+    ComputeLinearSystem(pose_graph, zeta, H, b);
+
+    SparseSolver solver;
+    solver.analyzePattern(H);
 
     Eigen::VectorXd H_diag = H.diagonal();
     double tau = 1e-5;
@@ -629,17 +773,30 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
         timer_iter.Start();
         int lm_count = 0;
         do {
-            Eigen::MatrixXd H_LM = H + current_lambda * H_I;
+            // H and H_LM share the same pattern, so only the values are
+            // copied here.
+            std::copy(H.valuePtr(), H.valuePtr() + H.nonZeros(),
+                      H_LM.valuePtr());
+            AddToDiagonal(H_LM, current_lambda);
             Eigen::VectorXd delta(H_LM.cols());
             bool solver_success = false;
 
             // Solve H_LM @ delta == b using a sparse solver
-            std::tie(solver_success, delta) = utility::SolveLinearSystemPSD(
-                    H_LM, b, /*prefer_sparse=*/true, /*check_symmetric=*/false,
-                    /*check_det=*/false, /*check_psd=*/false);
-
-            stop = stop || CheckRelativeIncrement(delta, x, criteria);
-            if (!stop) {
+            std::tie(solver_success, delta) =
+                    SolveLinearSystem(solver, H_LM, b);
+
+            if (!solver_success) {
+                // Treat a failed factorization as a rejected step.
+                utility::LogDebug(
+                        "[GlobalOptimizationLM] Failed to solve the linear "
+                        "system, increasing lambda.");
+                rho = 0.0;
+                current_lambda *= ni;
+                ni *= 2;
+            } else {
+                stop = stop || CheckRelativeIncrement(delta, x, criteria);
+            }
+            if (solver_success && !stop) {
                 std::shared_ptr<PoseGraph> pose_graph_new =
                         UpdatePoseGraph(pose_graph, delta);
 
@@ -667,7 +824,7 @@ void GlobalOptimizationLevenbergMarquardt::OptimizePoseGraph(
                     x = UpdatePoseVector(pose_graph);
                     valid_edges_num = UpdateConfidence(
                             pose_graph, zeta, line_process_weight, option);
-                    std::tie(H, b) = ComputeLinearSystem(pose_graph, zeta);
+                    ComputeLinearSystem(pose_graph, zeta, H, b);
 
                     stop = stop || CheckRightTerm(b, criteria);
                     if (stop) break;
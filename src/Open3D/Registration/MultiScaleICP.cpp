@@ -0,0 +1,177 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/MultiScaleICP.h"
+
+#include "Open3D/Geometry/KDTreeSearchParam.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/GeneralizedICP.h"
+#include "Open3D/Utility/Console.h"
+#include "Open3D/Utility/Timer.h"
+
+namespace open3d {
+namespace registration {
+
+PointCloudPyramid::PointCloudPyramid(
+        const geometry::PointCloud &cloud,
+        const std::vector<double> &voxel_sizes,
+        bool estimate_normals /* = true*/,
+        bool estimate_covariances /* = false*/,
+        double covariance_epsilon /* = 1e-3*/)
+    : voxel_sizes_(voxel_sizes), contexts_(voxel_sizes.size()) {
+    for (double voxel_size : voxel_sizes_) {
+        std::shared_ptr<geometry::PointCloud> level;
+        if (voxel_size > 0.0) {
+            level = cloud.VoxelDownSample(voxel_size);
+        } else {
+            level = std::make_shared<geometry::PointCloud>(cloud);
+        }
+        if (estimate_normals && !level->HasNormals()) {
+            if (voxel_size > 0.0) {
+                level->EstimateNormals(geometry::KDTreeSearchParamHybrid(
+                        voxel_size * 2.0, 30));
+            } else {
+                level->EstimateNormals(geometry::KDTreeSearchParamKNN(30));
+            }
+        }
+        if (estimate_covariances) {
+            // Covariances are estimated after downsampling, so that they
+            // describe the surface at the resolution of the level.
+            if (voxel_size > 0.0) {
+                PreparePointCloudForGeneralizedICP(
+                        *level, covariance_epsilon,
+                        geometry::KDTreeSearchParamHybrid(voxel_size * 2.0,
+                                                          20));
+            } else {
+                PreparePointCloudForGeneralizedICP(
+                        *level, covariance_epsilon,
+                        geometry::KDTreeSearchParamKNN(20));
+            }
+        }
+        levels_.push_back(level);
+    }
+}
+
+RegistrationContext &PointCloudPyramid::GetContext(size_t level) {
+    if (!contexts_[level]) {
+        contexts_[level] = std::make_shared<RegistrationContext>(
+                std::shared_ptr<const geometry::PointCloud>(levels_[level]));
+    }
+    return *contexts_[level];
+}
+
+std::tuple<RegistrationResult, std::vector<MultiScaleICPLevelResult>>
+RegistrationMultiScaleICP(
+        const PointCloudPyramid &source,
+        PointCloudPyramid &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/) {
+    size_t num_levels = source.NumLevels();
+    if (target.NumLevels() != num_levels ||
+        max_correspondence_distances.size() != num_levels ||
+        criteria.size() != num_levels) {
+        utility::LogError(
+                "[RegistrationMultiScaleICP] The pyramids, distances and "
+                "criteria must have the same number of levels.");
+    }
+
+    if (estimation.GetTransformationEstimationType() ==
+        TransformationEstimationType::GeneralizedICP) {
+        for (size_t i = 0; i < num_levels; i++) {
+            if (!source.GetLevel(i).HasCovariances() ||
+                !target.GetLevel(i).HasCovariances()) {
+                utility::LogError(
+                        "[RegistrationMultiScaleICP] Generalized ICP needs "
+                        "pyramids built with estimate_covariances.");
+            }
+        }
+    }
+
+    RegistrationResult result(init);
+    std::vector<MultiScaleICPLevelResult> level_results(num_levels);
+    for (size_t i = 0; i < num_levels; i++) {
+        utility::Timer timer;
+        timer.Start();
+        result = RegistrationICP(source.GetLevel(i), target.GetContext(i),
+                                 max_correspondence_distances[i],
+                                 result.transformation_, estimation,
+                                 criteria[i]);
+        timer.Stop();
+        MultiScaleICPLevelResult &level_result = level_results[i];
+        level_result.voxel_size_ = source.GetVoxelSize(i);
+        level_result.max_correspondence_distance_ =
+                max_correspondence_distances[i];
+        level_result.fitness_ = result.fitness_;
+        level_result.inlier_rmse_ = result.inlier_rmse_;
+        level_result.time_ = timer.GetDuration();
+        utility::LogDebug(
+                "Multi-scale ICP level #{:d}: Fitness {:.4f}, RMSE {:.4f}, "
+                "{:.2f} ms",
+                i, result.fitness_, result.inlier_rmse_, level_result.time_);
+    }
+    return std::make_tuple(result, level_results);
+}
+
+std::tuple<RegistrationResult, std::vector<MultiScaleICPLevelResult>>
+RegistrationMultiScaleICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const std::vector<double> &voxel_sizes,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/) {
+    // Normals and covariances are only needed by the estimations that use
+    // them.
+    TransformationEstimationType type =
+            estimation.GetTransformationEstimationType();
+    bool estimate_normals =
+            type != TransformationEstimationType::PointToPoint &&
+            type != TransformationEstimationType::GeneralizedICP;
+    bool estimate_covariances =
+            type == TransformationEstimationType::GeneralizedICP;
+    double covariance_epsilon = 1e-3;
+    if (estimate_covariances) {
+        covariance_epsilon =
+                static_cast<const TransformationEstimationForGeneralizedICP &>(
+                        estimation)
+                        .epsilon_;
+    }
+    PointCloudPyramid source_pyramid(source, voxel_sizes, estimate_normals,
+                                     estimate_covariances, covariance_epsilon);
+    PointCloudPyramid target_pyramid(target, voxel_sizes, estimate_normals,
+                                     estimate_covariances, covariance_epsilon);
+    return RegistrationMultiScaleICP(source_pyramid, target_pyramid,
+                                     max_correspondence_distances, criteria,
+                                     init, estimation);
+}
+
+}  // namespace registration
+}  // namespace open3d
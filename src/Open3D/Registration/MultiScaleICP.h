@@ -0,0 +1,164 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <Eigen/Core>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+#include "Open3D/Registration/Registration.h"
+
+namespace open3d {
+
+namespace geometry {
+class PointCloud;
+}
+
+namespace registration {
+
+/// \class PointCloudPyramid
+///
+/// \brief Point cloud downsampled at a list of voxel sizes, for multi-scale
+/// registration.
+///
+/// Each level is downsampled and, if requested, gets normals and Generalized
+/// ICP covariances once at construction. The KDTree of a level is built the
+/// first time the pyramid is used as a target at that level, and reused by
+/// later registrations.
+class PointCloudPyramid {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param cloud The full resolution point cloud.
+    /// \param voxel_sizes Voxel size of each level, usually from coarse to
+    /// fine. A voxel size <= 0 keeps the full resolution.
+    /// \param estimate_normals If true, normals are estimated for the levels
+    /// without normals, in a radius of twice the voxel size.
+    /// \param estimate_covariances If true, the levels get the covariances
+    /// used by Generalized ICP, see PreparePointCloudForGeneralizedICP().
+    /// Missing covariances are estimated in a radius of twice the voxel size.
+    /// \param covariance_epsilon Smallest eigenvalue of the regularized
+    /// covariances.
+    PointCloudPyramid(const geometry::PointCloud &cloud,
+                      const std::vector<double> &voxel_sizes,
+                      bool estimate_normals = true,
+                      bool estimate_covariances = false,
+                      double covariance_epsilon = 1e-3);
+    ~PointCloudPyramid() {}
+    PointCloudPyramid(const PointCloudPyramid &) = delete;
+    PointCloudPyramid &operator=(const PointCloudPyramid &) = delete;
+
+public:
+    /// Returns the number of levels.
+    size_t NumLevels() const { return levels_.size(); }
+    /// Returns the voxel size of \p level.
+    double GetVoxelSize(size_t level) const { return voxel_sizes_[level]; }
+    /// Returns the point cloud of \p level.
+    const geometry::PointCloud &GetLevel(size_t level) const {
+        return *levels_[level];
+    }
+    /// Returns the registration context of \p level, with the level as
+    /// target. The context is built on first use.
+    RegistrationContext &GetContext(size_t level);
+
+protected:
+    std::vector<double> voxel_sizes_;
+    std::vector<std::shared_ptr<geometry::PointCloud>> levels_;
+    std::vector<std::shared_ptr<RegistrationContext>> contexts_;
+};
+
+/// \class MultiScaleICPLevelResult
+///
+/// \brief Class that contains the result of one level of multi-scale ICP.
+class MultiScaleICPLevelResult {
+public:
+    /// Voxel size of the level.
+    double voxel_size_ = 0.0;
+    /// Maximum correspondence points-pair distance of the level.
+    double max_correspondence_distance_ = 0.0;
+    /// Fitness after the level.
+    double fitness_ = 0.0;
+    /// RMSE of all inlier correspondences after the level.
+    double inlier_rmse_ = 0.0;
+    /// Time spent on the level, in milliseconds.
+    double time_ = 0.0;
+};
+
+/// \brief Function for coarse-to-fine ICP registration.
+///
+/// ICP runs on each level in order, starting from the transformation found on
+/// the previous level. Most iterations run on the cheap coarse levels, and the
+/// fine levels only refine the alignment.
+///
+/// \param source The source point cloud pyramid.
+/// \param target The target point cloud pyramid, with the same number of
+/// levels.
+/// \param max_correspondence_distances Maximum correspondence points-pair
+/// distance of each level.
+/// \param criteria Convergence criteria of each level.
+/// \param init Initial transformation estimation.
+/// \param estimation Estimation method.
+/// \return The registration result of the last level, and the result of
+/// each level.
+std::tuple<RegistrationResult, std::vector<MultiScaleICPLevelResult>>
+RegistrationMultiScaleICP(
+        const PointCloudPyramid &source,
+        PointCloudPyramid &target,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false));
+
+/// \brief Function for coarse-to-fine ICP registration of point clouds.
+///
+/// Builds the pyramids of \p source and \p target and calls
+/// RegistrationMultiScaleICP() on them. Build the pyramids once with
+/// PointCloudPyramid to reuse them across registrations.
+///
+/// \param source The source point cloud.
+/// \param target The target point cloud.
+/// \param voxel_sizes Voxel size of each level.
+/// \param max_correspondence_distances Maximum correspondence points-pair
+/// distance of each level.
+/// \param criteria Convergence criteria of each level.
+/// \param init Initial transformation estimation.
+/// \param estimation Estimation method.
+std::tuple<RegistrationResult, std::vector<MultiScaleICPLevelResult>>
+RegistrationMultiScaleICP(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const std::vector<double> &voxel_sizes,
+        const std::vector<double> &max_correspondence_distances,
+        const std::vector<ICPConvergenceCriteria> &criteria,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false));
+
+}  // namespace registration
+}  // namespace open3d
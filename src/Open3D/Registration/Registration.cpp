@@ -26,7 +26,11 @@
 
 #include "Open3D/Registration/Registration.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <cstdlib>
+#include <random>
 
 #include "Open3D/Geometry/KDTreeFlann.h"
 #include "Open3D/Geometry/PointCloud.h"
@@ -50,41 +54,57 @@ RegistrationResult GetRegistrationResultAndCorrespondences(
         return result;
     }
 
-    double error2 = 0.0;
+    // The nearest neighbor of source point i is written into slot i, so the
+    // search needs neither per-point allocations nor synchronization.
+    std::vector<int> indices;
+    std::vector<double> dists;
+    std::vector<int> counts;
+    if (target_kdtree.BatchSearchHybrid(source.points_,
+                                        max_correspondence_distance, 1,
+                                        indices, dists, counts) < 0) {
+        return result;
+    }
 
+    // The slots are compacted in blocks of fixed size. The block boundaries
+    // do not depend on the number of threads, so the correspondences are
+    // ordered by source index and error2 is summed in the same order on every
+    // run.
+    const int block_size = 4096;
+    int num_points = (int)source.points_.size();
+    int num_blocks = (num_points + block_size - 1) / block_size;
+    std::vector<int> block_offsets(num_blocks + 1, 0);
+    std::vector<double> block_error2(num_blocks, 0.0);
 #ifdef _OPENMP
-#pragma omp parallel
-    {
+#pragma omp parallel for schedule(static)
 #endif
-        double error2_private = 0.0;
-        CorrespondenceSet correspondence_set_private;
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int i = 0; i < (int)source.points_.size(); i++) {
-            std::vector<int> indices(1);
-            std::vector<double> dists(1);
-            const auto &point = source.points_[i];
-            if (target_kdtree.SearchHybrid(point, max_correspondence_distance,
-                                           1, indices, dists) > 0) {
-                error2_private += dists[0];
-                correspondence_set_private.push_back(
-                        Eigen::Vector2i(i, indices[0]));
+    for (int b = 0; b < num_blocks; b++) {
+        int end = (std::min)(num_points, (b + 1) * block_size);
+        for (int i = b * block_size; i < end; i++) {
+            if (counts[i] > 0) {
+                block_offsets[b + 1]++;
+                block_error2[b] += dists[i];
             }
         }
+    }
+    double error2 = 0.0;
+    for (int b = 0; b < num_blocks; b++) {
+        block_offsets[b + 1] += block_offsets[b];
+        error2 += block_error2[b];
+    }
+    result.correspondence_set_.resize(block_offsets[num_blocks]);
 #ifdef _OPENMP
-#pragma omp critical
+#pragma omp parallel for schedule(static)
 #endif
-        {
-            for (int i = 0; i < (int)correspondence_set_private.size(); i++) {
-                result.correspondence_set_.push_back(
-                        correspondence_set_private[i]);
+    for (int b = 0; b < num_blocks; b++) {
+        int end = (std::min)(num_points, (b + 1) * block_size);
+        int k = block_offsets[b];
+        for (int i = b * block_size; i < end; i++) {
+            if (counts[i] > 0) {
+                result.correspondence_set_[k++] =
+                        Eigen::Vector2i(i, indices[i]);
             }
-            error2 += error2_private;
         }
-#ifdef _OPENMP
     }
-#endif
 
     if (result.correspondence_set_.empty()) {
         result.fitness_ = 0.0;
@@ -126,23 +146,111 @@ RegistrationResult EvaluateRANSACBasedOnCorrespondence(
     return result;
 }
 
+/// Returns the fraction of the feature matches (i, corres_target[i]) that
+/// agree with the transformation that brought source into place, i.e. whose
+/// transformed source point lies within max_correspondence_distance of the
+/// matched target point. This is the inlier ratio of the sampled matches, as
+/// opposed to the geometric overlap reported by the fitness.
+double ComputeFeatureMatchInlierRatio(const geometry::PointCloud &source,
+                                      const geometry::PointCloud &target,
+                                      const std::vector<int> &corres_target,
+                                      double max_correspondence_distance) {
+    if (corres_target.empty()) {
+        return 0.0;
+    }
+    double max_dis2 = max_correspondence_distance * max_correspondence_distance;
+    int good = 0;
+    for (size_t i = 0; i < corres_target.size(); i++) {
+        if ((source.points_[i] - target.points_[corres_target[i]])
+                    .squaredNorm() < max_dis2) {
+            good++;
+        }
+    }
+    return (double)good / (double)corres_target.size();
+}
+
+/// Returns the number of RANSAC iterations needed to draw, with probability
+/// confidence, at least one sample of ransac_n inliers when a fraction
+/// inlier_ratio of the correspondences are inliers. The bound is clamped to
+/// max_iteration.
+int GetRANSACIterationBound(double inlier_ratio,
+                            int ransac_n,
+                            double confidence,
+                            int max_iteration) {
+    if (confidence >= 1.0 || inlier_ratio <= 0.0) {
+        return max_iteration;
+    }
+    double sample_inlier_probability = std::pow(inlier_ratio, ransac_n);
+    if (sample_inlier_probability >= 1.0) {
+        return 0;
+    }
+    double bound = std::log(1.0 - confidence) /
+                   std::log(1.0 - sample_inlier_probability);
+    return bound < max_iteration ? int(std::ceil(bound)) : max_iteration;
+}
+
 }  // unnamed namespace
 
 namespace registration {
+
+RegistrationContext::RegistrationContext(
+        const geometry::PointCloud &target,
+        geometry::KDTreeFlann::Precision
+                precision /* = geometry::KDTreeFlann::Precision::Float64*/)
+    : target_(&target), target_kdtree_(precision) {
+    target_kdtree_.SetGeometry(target);
+}
+
+RegistrationContext::RegistrationContext(
+        std::shared_ptr<const geometry::PointCloud> target,
+        geometry::KDTreeFlann::Precision
+                precision /* = geometry::KDTreeFlann::Precision::Float64*/)
+    : target_holder_(target),
+      target_(target.get()),
+      target_kdtree_(precision) {
+    target_kdtree_.SetGeometry(*target);
+}
+
+geometry::PointCloud &RegistrationContext::PrepareSource(
+        const geometry::PointCloud &source,
+        const Eigen::Matrix4d &transformation) {
+    // assign() reuses the capacity of the buffer.
+    source_buffer_.points_.assign(source.points_.begin(),
+                                  source.points_.end());
+    source_buffer_.normals_.assign(source.normals_.begin(),
+                                   source.normals_.end());
+    source_buffer_.colors_.assign(source.colors_.begin(),
+                                  source.colors_.end());
+    source_buffer_.covariances_.assign(source.covariances_.begin(),
+                                       source.covariances_.end());
+    if (transformation.isIdentity() == false) {
+        source_buffer_.Transform(transformation);
+    }
+    return source_buffer_;
+}
+
 RegistrationResult EvaluateRegistration(
         const geometry::PointCloud &source,
         const geometry::PointCloud &target,
         double max_correspondence_distance,
         const Eigen::Matrix4d
                 &transformation /* = Eigen::Matrix4d::Identity()*/) {
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
-    geometry::PointCloud pcd = source;
-    if (transformation.isIdentity() == false) {
-        pcd.Transform(transformation);
-    }
+    RegistrationContext context(target);
+    return EvaluateRegistration(source, context, max_correspondence_distance,
+                                transformation);
+}
+
+RegistrationResult EvaluateRegistration(
+        const geometry::PointCloud &source,
+        RegistrationContext &context,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d
+                &transformation /* = Eigen::Matrix4d::Identity()*/) {
+    const geometry::PointCloud &pcd =
+            context.PrepareSource(source, transformation);
     return GetRegistrationResultAndCorrespondences(
-            pcd, target, kdtree, max_correspondence_distance, transformation);
+            pcd, context.GetTarget(), context.GetTargetKDTree(),
+            max_correspondence_distance, transformation);
 }
 
 RegistrationResult RegistrationICP(
@@ -157,6 +265,24 @@ RegistrationResult RegistrationICP(
     if (max_correspondence_distance <= 0.0) {
         utility::LogError("Invalid max_correspondence_distance.");
     }
+    RegistrationContext context(target);
+    return RegistrationICP(source, context, max_correspondence_distance, init,
+                           estimation, criteria);
+}
+
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        RegistrationContext &context,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init /* = Eigen::Matrix4d::Identity()*/,
+        const TransformationEstimation &estimation
+        /* = TransformationEstimationPointToPoint(false)*/,
+        const ICPConvergenceCriteria
+                &criteria /* = ICPConvergenceCriteria()*/) {
+    const geometry::PointCloud &target = context.GetTarget();
+    if (max_correspondence_distance <= 0.0) {
+        utility::LogError("Invalid max_correspondence_distance.");
+    }
     if ((estimation.GetTransformationEstimationType() ==
                  TransformationEstimationType::PointToPlane ||
          estimation.GetTransformationEstimationType() ==
@@ -167,14 +293,17 @@ RegistrationResult RegistrationICP(
                 "TransformationEstimationColoredICP "
                 "require pre-computed normal vectors.");
     }
+    if (estimation.GetTransformationEstimationType() ==
+                TransformationEstimationType::GeneralizedICP &&
+        (!source.HasCovariances() || !target.HasCovariances())) {
+        utility::LogError(
+                "TransformationEstimationForGeneralizedICP requires "
+                "pre-computed covariances.");
+    }
 
     Eigen::Matrix4d transformation = init;
-    geometry::KDTreeFlann kdtree;
-    kdtree.SetGeometry(target);
-    geometry::PointCloud pcd = source;
-    if (init.isIdentity() == false) {
-        pcd.Transform(init);
-    }
+    const geometry::KDTreeFlann &kdtree = context.GetTargetKDTree();
+    geometry::PointCloud &pcd = context.PrepareSource(source, init);
     RegistrationResult result;
     result = GetRegistrationResultAndCorrespondences(
             pcd, target, kdtree, max_correspondence_distance, transformation);
@@ -216,10 +345,10 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
     Eigen::Matrix4d transformation;
     CorrespondenceSet ransac_corres(ransac_n);
     RegistrationResult result;
+    int iteration_bound =
+            (std::min)(criteria.max_iteration_, criteria.max_validation_);
 
-    for (int itr = 0;
-         itr < criteria.max_iteration_ && itr < criteria.max_validation_;
-         itr++) {
+    for (int itr = 0; itr < iteration_bound; itr++) {
         for (int j = 0; j < ransac_n; j++) {
             ransac_corres[j] = corres[utility::UniformRandInt(
                     0, static_cast<int>(corres.size()) - 1)];
@@ -235,6 +364,11 @@ RegistrationResult RegistrationRANSACBasedOnCorrespondence(
             (this_result.fitness_ == result.fitness_ &&
              this_result.inlier_rmse_ < result.inlier_rmse_)) {
             result = this_result;
+            iteration_bound = (std::min)(
+                    iteration_bound,
+                    GetRANSACIterationBound(result.fitness_, ransac_n,
+                                            criteria.confidence_,
+                                            criteria.max_iteration_));
         }
     }
     utility::LogDebug("RANSAC: Fitness {:e}, RMSE {:e}", result.fitness_,
@@ -255,98 +389,100 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
                 &checkers /* = {}*/,
         const RANSACConvergenceCriteria &criteria
         /* = RANSACConvergenceCriteria()*/) {
-    if (ransac_n < 3 || max_correspondence_distance <= 0.0) {
+    if (ransac_n < 3 || max_correspondence_distance <= 0.0 ||
+        source.points_.empty()) {
+        return RegistrationResult();
+    }
+
+    // Each source point is matched to its nearest target feature once, up
+    // front and in parallel, so that the hypotheses only sample this table.
+    // A float index is precise enough to match descriptors and halves the
+    // memory traffic of the search.
+    std::vector<int> corres_target;
+    std::vector<double> dists;
+    geometry::KDTreeFlann kdtree_feature(
+            target_feature, geometry::KDTreeFlann::Precision::Float32);
+    if (kdtree_feature.BatchSearchKNN(source_feature.data_, 1, corres_target,
+                                      dists) <= 0 ||
+        corres_target.size() != source.points_.size()) {
         return RegistrationResult();
     }
 
+    geometry::KDTreeFlann kdtree(target);
     RegistrationResult result;
-    int total_validation = 0;
-    bool finished_validation = false;
-    int num_similar_features = 1;
-    std::vector<std::vector<int>> similar_features(source.points_.size());
+    // Hypotheses are handed out through a shared counter. A thread that finds
+    // a better hypothesis lowers the shared iteration bound, so all threads
+    // stop once the best inlier ratio makes further sampling pointless.
+    std::atomic<int> next_iteration(0);
+    std::atomic<int> iteration_bound(criteria.max_iteration_);
+    std::atomic<int> total_validation(0);
 
 #ifdef _OPENMP
 #pragma omp parallel
     {
 #endif
         CorrespondenceSet ransac_corres(ransac_n);
-        geometry::KDTreeFlann kdtree(target);
-        geometry::KDTreeFlann kdtree_feature(target_feature);
         RegistrationResult result_private;
+        geometry::PointCloud pcd;
+        std::mt19937 generator(std::random_device{}());
+        std::uniform_int_distribution<int> distribution(
+                0, static_cast<int>(source.points_.size()) - 1);
 
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int itr = 0; itr < criteria.max_iteration_; itr++) {
-            if (!finished_validation) {
-                std::vector<double> dists(num_similar_features);
-                Eigen::Matrix4d transformation;
-                for (int j = 0; j < ransac_n; j++) {
-                    int source_sample_id = utility::UniformRandInt(
-                            0, static_cast<int>(source.points_.size()) - 1);
-                    if (similar_features[source_sample_id].empty()) {
-                        std::vector<int> indices(num_similar_features);
-                        kdtree_feature.SearchKNN(
-                                Eigen::VectorXd(source_feature.data_.col(
-                                        source_sample_id)),
-                                num_similar_features, indices, dists);
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-                        { similar_features[source_sample_id] = indices; }
-                    }
-                    ransac_corres[j](0) = source_sample_id;
-                    if (num_similar_features == 1)
-                        ransac_corres[j](1) =
-                                similar_features[source_sample_id][0];
-                    else {
-                        ransac_corres[j](1) = similar_features
-                                [source_sample_id][utility::UniformRandInt(
-                                        0, num_similar_features - 1)];
-                    }
-                }
-                bool check = true;
-                for (const auto &checker : checkers) {
-                    if (checker.get().require_pointcloud_alignment_ == false &&
-                        checker.get().Check(source, target, ransac_corres,
-                                            transformation) == false) {
-                        check = false;
-                        break;
-                    }
-                }
-                if (check == false) continue;
-                transformation = estimation.ComputeTransformation(
-                        source, target, ransac_corres);
-                check = true;
-                for (const auto &checker : checkers) {
-                    if (checker.get().require_pointcloud_alignment_ == true &&
-                        checker.get().Check(source, target, ransac_corres,
-                                            transformation) == false) {
-                        check = false;
-                        break;
-                    }
+        while (next_iteration++ < iteration_bound &&
+               total_validation < criteria.max_validation_) {
+            Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+            for (int j = 0; j < ransac_n; j++) {
+                int source_sample_id = distribution(generator);
+                ransac_corres[j](0) = source_sample_id;
+                ransac_corres[j](1) = corres_target[source_sample_id];
+            }
+            bool check = true;
+            for (const auto &checker : checkers) {
+                if (checker.get().require_pointcloud_alignment_ == false &&
+                    checker.get().Check(source, target, ransac_corres,
+                                        transformation) == false) {
+                    check = false;
+                    break;
                 }
-                if (check == false) continue;
-                geometry::PointCloud pcd = source;
-                pcd.Transform(transformation);
-                auto this_result = GetRegistrationResultAndCorrespondences(
-                        pcd, target, kdtree, max_correspondence_distance,
-                        transformation);
-                if (this_result.fitness_ > result_private.fitness_ ||
-                    (this_result.fitness_ == result_private.fitness_ &&
-                     this_result.inlier_rmse_ < result_private.inlier_rmse_)) {
-                    result_private = this_result;
+            }
+            if (check == false) continue;
+            transformation = estimation.ComputeTransformation(source, target,
+                                                              ransac_corres);
+            check = true;
+            for (const auto &checker : checkers) {
+                if (checker.get().require_pointcloud_alignment_ == true &&
+                    checker.get().Check(source, target, ransac_corres,
+                                        transformation) == false) {
+                    check = false;
+                    break;
                 }
-#ifdef _OPENMP
-#pragma omp critical
-#endif
-                {
-                    total_validation = total_validation + 1;
-                    if (total_validation >= criteria.max_validation_)
-                        finished_validation = true;
+            }
+            if (check == false) continue;
+            // Only the points are needed for validation, the copy reuses the
+            // capacity of the buffer.
+            pcd.points_ = source.points_;
+            pcd.Transform(transformation);
+            auto this_result = GetRegistrationResultAndCorrespondences(
+                    pcd, target, kdtree, max_correspondence_distance,
+                    transformation);
+            if (this_result.fitness_ > result_private.fitness_ ||
+                (this_result.fitness_ == result_private.fitness_ &&
+                 this_result.inlier_rmse_ < result_private.inlier_rmse_)) {
+                result_private = this_result;
+                double inlier_ratio = ComputeFeatureMatchInlierRatio(
+                        pcd, target, corres_target,
+                        max_correspondence_distance);
+                int bound = GetRANSACIterationBound(
+                        inlier_ratio, ransac_n, criteria.confidence_,
+                        criteria.max_iteration_);
+                int current_bound = iteration_bound;
+                while (bound < current_bound &&
+                       !iteration_bound.compare_exchange_weak(current_bound,
+                                                              bound)) {
                 }
-            }  // end of if statement
-        }      // end of for-loop
+            }
+            total_validation++;
+        }
 #ifdef _OPENMP
 #pragma omp critical
 #endif
@@ -360,7 +496,9 @@ RegistrationResult RegistrationRANSACBasedOnFeatureMatching(
 #ifdef _OPENMP
     }
 #endif
-    utility::LogDebug("total_validation : {:d}", total_validation);
+    utility::LogDebug("RANSAC: {:d} iterations, {:d} validations",
+                      (std::min)(int(next_iteration), criteria.max_iteration_),
+                      int(total_validation));
     utility::LogDebug("RANSAC: Fitness {:e}, RMSE {:e}", result.fitness_,
                       result.inlier_rmse_);
     return result;
@@ -27,19 +27,17 @@
 #pragma once
 
 #include <Eigen/Core>
+#include <memory>
 #include <tuple>
 #include <vector>
 
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
 #include "Open3D/Registration/CorrespondenceChecker.h"
 #include "Open3D/Registration/TransformationEstimation.h"
 #include "Open3D/Utility/Eigen.h"
 
 namespace open3d {
-
-namespace geometry {
-class PointCloud;
-}
-
 namespace registration {
 class Feature;
 
@@ -83,7 +81,8 @@ public:
 /// \brief Class that defines the convergence criteria of RANSAC.
 ///
 /// RANSAC algorithm stops if the iteration number hits max_iteration_, or the
-/// validation has been run for max_validation_ times.
+/// validation has been run for max_validation_ times, or enough iterations
+/// have been run to find the best hypothesis with probability confidence_.
 /// Note that the validation is the most computational expensive operator in an
 /// iteration. Most iterations do not do full validation. It is crucial to
 /// control max_validation_ so that the computation time is acceptable.
@@ -94,9 +93,14 @@ public:
     /// \param max_iteration Maximum iteration before iteration stops.
     /// \param max_validation Maximum times the validation has been run before
     /// the iteration stops.
+    /// \param confidence Desired probability of drawing at least one sample
+    /// of inliers. 1.0 disables the adaptive termination.
     RANSACConvergenceCriteria(int max_iteration = 1000,
-                              int max_validation = 1000)
-        : max_iteration_(max_iteration), max_validation_(max_validation) {}
+                              int max_validation = 1000,
+                              double confidence = 1.0)
+        : max_iteration_(max_iteration),
+          max_validation_(max_validation),
+          confidence_(confidence) {}
     ~RANSACConvergenceCriteria() {}
 
 public:
@@ -104,6 +108,11 @@ public:
     int max_iteration_;
     /// Maximum times the validation has been run before the iteration stops.
     int max_validation_;
+    /// Desired probability of drawing at least one sample of inliers. The
+    /// iteration stops once log(1 - confidence) / log(1 - w^n) iterations have
+    /// been run, w being the inlier ratio of the best hypothesis so far and n
+    /// the sample size.
+    double confidence_;
 };
 
 /// \class RegistrationResult
@@ -131,6 +140,62 @@ public:
     double fitness_;
 };
 
+/// \class RegistrationContext
+///
+/// \brief Target state of ICP registration that is reused across calls.
+///
+/// RegistrationICP() and EvaluateRegistration() build a KDTree on the target
+/// and copy the source on every call. A RegistrationContext builds the target
+/// KDTree once and keeps a source buffer whose capacity is reused. Repeated
+/// registrations against the same target then do no rebuilds and, once the
+/// buffer has grown, no full point cloud allocations. A context is not thread
+/// safe, use one context per thread.
+class RegistrationContext {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param target The target point cloud. It is referenced, not copied, and
+    /// must outlive the context.
+    /// \param precision Precision of the target KDTree.
+    explicit RegistrationContext(
+            const geometry::PointCloud &target,
+            geometry::KDTreeFlann::Precision precision =
+                    geometry::KDTreeFlann::Precision::Float64);
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param target The target point cloud, owned by the context.
+    /// \param precision Precision of the target KDTree.
+    explicit RegistrationContext(
+            std::shared_ptr<const geometry::PointCloud> target,
+            geometry::KDTreeFlann::Precision precision =
+                    geometry::KDTreeFlann::Precision::Float64);
+    ~RegistrationContext() {}
+    RegistrationContext(const RegistrationContext &) = delete;
+    RegistrationContext &operator=(const RegistrationContext &) = delete;
+
+public:
+    /// Returns the target point cloud.
+    const geometry::PointCloud &GetTarget() const { return *target_; }
+    /// Returns the KDTree built on the target point cloud.
+    const geometry::KDTreeFlann &GetTargetKDTree() const {
+        return target_kdtree_;
+    }
+    /// \brief Copies \p source into the source buffer and transforms it.
+    ///
+    /// \param source The source point cloud.
+    /// \param transformation The 4x4 transformation matrix applied to the
+    /// copy.
+    /// \return The source buffer, valid until the next call.
+    geometry::PointCloud &PrepareSource(const geometry::PointCloud &source,
+                                        const Eigen::Matrix4d &transformation);
+
+protected:
+    std::shared_ptr<const geometry::PointCloud> target_holder_;
+    const geometry::PointCloud *target_;
+    geometry::KDTreeFlann target_kdtree_;
+    geometry::PointCloud source_buffer_;
+};
+
 /// \brief Function for evaluating registration between point clouds.
 ///
 /// \param source The source point cloud.
@@ -164,6 +229,43 @@ RegistrationResult RegistrationICP(
                 TransformationEstimationPointToPoint(false),
         const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
 
+/// \brief Function for evaluating registration against the target of a
+/// RegistrationContext.
+///
+/// \param source The source point cloud.
+/// \param context Context holding the target point cloud and its KDTree.
+/// \param max_correspondence_distance Maximum correspondence points-pair
+/// distance.
+/// \param transformation The 4x4 transformation matrix to transform source to
+/// target.
+RegistrationResult EvaluateRegistration(
+        const geometry::PointCloud &source,
+        RegistrationContext &context,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &transformation = Eigen::Matrix4d::Identity());
+
+/// \brief Functions for ICP registration against the target of a
+/// RegistrationContext.
+///
+/// To warm-start from a previous registration, pass its transformation as
+/// \p init.
+///
+/// \param source The source point cloud.
+/// \param context Context holding the target point cloud and its KDTree.
+/// \param max_correspondence_distance Maximum correspondence points-pair
+/// distance.
+/// \param init Initial transformation estimation.
+/// \param estimation Estimation method.
+/// \param criteria Convergence criteria.
+RegistrationResult RegistrationICP(
+        const geometry::PointCloud &source,
+        RegistrationContext &context,
+        double max_correspondence_distance,
+        const Eigen::Matrix4d &init = Eigen::Matrix4d::Identity(),
+        const TransformationEstimation &estimation =
+                TransformationEstimationPointToPoint(false),
+        const ICPConvergenceCriteria &criteria = ICPConvergenceCriteria());
+
 /// \brief Function for global RANSAC registration based on a given set of
 /// correspondences.
 ///
@@ -0,0 +1,127 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+namespace open3d {
+namespace registration {
+
+/// \class RobustKernel
+///
+/// Base class that models a robust kernel for outlier rejection. The robust
+/// loss rho(r) of a residual r is minimized by iteratively reweighted least
+/// squares: each iteration solves a weighted least squares problem with the
+/// weight w(r) = rho'(r) / r of every residual, computed from the residuals
+/// of the previous iteration. The virtual function Weight() must be
+/// implemented in subclasses.
+class RobustKernel {
+public:
+    virtual ~RobustKernel() = default;
+    /// Returns the weight w(r) of the residual r.
+    ///
+    /// \param residual Residual value obtained during the optimization.
+    virtual double Weight(double residual) const = 0;
+};
+
+/// \class L2Loss
+///
+/// The loss is rho(r) = r^2 / 2, every residual has weight 1. This is plain
+/// least squares.
+class L2Loss : public RobustKernel {
+public:
+    double Weight(double residual) const override;
+};
+
+/// \class HuberLoss
+///
+/// The loss is quadratic for |r| <= k and linear beyond, so large residuals
+/// are down-weighted by k / |r|.
+class HuberLoss : public RobustKernel {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param k Threshold between the quadratic and the linear part.
+    explicit HuberLoss(double k) : k_(k) {}
+    double Weight(double residual) const override;
+
+public:
+    /// Threshold between the quadratic and the linear part.
+    double k_;
+};
+
+/// \class CauchyLoss
+///
+/// The loss is rho(r) = k^2 / 2 * log(1 + (r / k)^2), with weight
+/// 1 / (1 + (r / k)^2).
+class CauchyLoss : public RobustKernel {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param k Scale parameter.
+    explicit CauchyLoss(double k) : k_(k) {}
+    double Weight(double residual) const override;
+
+public:
+    /// Scale parameter.
+    double k_;
+};
+
+/// \class GMLoss
+///
+/// Geman-McClure loss rho(r) = k * r^2 / (2 * (k + r^2)), with weight
+/// k^2 / (k + r^2)^2.
+class GMLoss : public RobustKernel {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param k Scale parameter.
+    explicit GMLoss(double k) : k_(k) {}
+    double Weight(double residual) const override;
+
+public:
+    /// Scale parameter.
+    double k_;
+};
+
+/// \class TukeyLoss
+///
+/// Tukey biweight loss, with weight (1 - (r / k)^2)^2 for |r| <= k. Residuals
+/// beyond k have weight 0 and are ignored.
+class TukeyLoss : public RobustKernel {
+public:
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param k Residuals beyond k are ignored.
+    explicit TukeyLoss(double k) : k_(k) {}
+    double Weight(double residual) const override;
+
+public:
+    /// Residuals beyond k are ignored.
+    double k_;
+};
+
+}  // namespace registration
+}  // namespace open3d
@@ -29,64 +29,97 @@
 #include <Eigen/Geometry>
 
 #include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/SoAPointCloud.h"
 #include "Open3D/Utility/Eigen.h"
 
 namespace open3d {
 namespace registration {
 
-double TransformationEstimationPointToPoint::ComputeRMSE(
-        const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
-        const CorrespondenceSet &corres) const {
+namespace {
+
+const Eigen::Vector3d &GetPoint(const geometry::PointCloud &pointcloud,
+                                int i) {
+    return pointcloud.points_[i];
+}
+
+const Eigen::Vector3d &GetNormal(const geometry::PointCloud &pointcloud,
+                                 int i) {
+    return pointcloud.normals_[i];
+}
+
+template <typename Scalar>
+Eigen::Vector3d GetPoint(const geometry::SoAPointCloud<Scalar> &pointcloud,
+                         int i) {
+    const Scalar *point = pointcloud.points_.data() + 3 * size_t(i);
+    return Eigen::Vector3d(point[0], point[1], point[2]);
+}
+
+template <typename Scalar>
+Eigen::Vector3d GetNormal(const geometry::SoAPointCloud<Scalar> &pointcloud,
+                          int i) {
+    const Scalar *normal = pointcloud.normals_.data() + 3 * size_t(i);
+    return Eigen::Vector3d(normal[0], normal[1], normal[2]);
+}
+
+template <typename PointCloudT>
+double ComputePointToPointRMSE(const PointCloudT &source,
+                               const PointCloudT &target,
+                               const CorrespondenceSet &corres) {
     if (corres.empty()) return 0.0;
     double err = 0.0;
     for (const auto &c : corres) {
-        err += (source.points_[c[0]] - target.points_[c[1]]).squaredNorm();
+        err += (GetPoint(source, c[0]) - GetPoint(target, c[1]))
+                       .squaredNorm();
     }
     return std::sqrt(err / (double)corres.size());
 }
 
-Eigen::Matrix4d TransformationEstimationPointToPoint::ComputeTransformation(
-        const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
-        const CorrespondenceSet &corres) const {
+template <typename PointCloudT>
+Eigen::Matrix4d ComputePointToPointTransformation(
+        const PointCloudT &source,
+        const PointCloudT &target,
+        const CorrespondenceSet &corres,
+        bool with_scaling) {
     if (corres.empty()) return Eigen::Matrix4d::Identity();
     Eigen::MatrixXd source_mat(3, corres.size());
     Eigen::MatrixXd target_mat(3, corres.size());
     for (size_t i = 0; i < corres.size(); i++) {
-        source_mat.block<3, 1>(0, i) = source.points_[corres[i][0]];
-        target_mat.block<3, 1>(0, i) = target.points_[corres[i][1]];
+        source_mat.block<3, 1>(0, i) = GetPoint(source, corres[i][0]);
+        target_mat.block<3, 1>(0, i) = GetPoint(target, corres[i][1]);
     }
-    return Eigen::umeyama(source_mat, target_mat, with_scaling_);
+    return Eigen::umeyama(source_mat, target_mat, with_scaling);
 }
 
-double TransformationEstimationPointToPlane::ComputeRMSE(
-        const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
-        const CorrespondenceSet &corres) const {
+template <typename PointCloudT>
+double ComputePointToPlaneRMSE(const PointCloudT &source,
+                               const PointCloudT &target,
+                               const CorrespondenceSet &corres) {
     if (corres.empty() || target.HasNormals() == false) return 0.0;
     double err = 0.0, r;
     for (const auto &c : corres) {
-        r = (source.points_[c[0]] - target.points_[c[1]])
-                    .dot(target.normals_[c[1]]);
+        r = (GetPoint(source, c[0]) - GetPoint(target, c[1]))
+                    .dot(GetNormal(target, c[1]));
         err += r * r;
     }
     return std::sqrt(err / (double)corres.size());
 }
 
-Eigen::Matrix4d TransformationEstimationPointToPlane::ComputeTransformation(
-        const geometry::PointCloud &source,
-        const geometry::PointCloud &target,
-        const CorrespondenceSet &corres) const {
+template <typename PointCloudT>
+Eigen::Matrix4d ComputePointToPlaneTransformation(
+        const PointCloudT &source,
+        const PointCloudT &target,
+        const CorrespondenceSet &corres,
+        const RobustKernel &kernel) {
     if (corres.empty() || target.HasNormals() == false)
         return Eigen::Matrix4d::Identity();
 
     auto compute_jacobian_and_residual = [&](int i, Eigen::Vector6d &J_r,
-                                             double &r) {
-        const Eigen::Vector3d &vs = source.points_[corres[i][0]];
-        const Eigen::Vector3d &vt = target.points_[corres[i][1]];
-        const Eigen::Vector3d &nt = target.normals_[corres[i][1]];
+                                             double &r, double &w) {
+        const Eigen::Vector3d vs = GetPoint(source, corres[i][0]);
+        const Eigen::Vector3d vt = GetPoint(target, corres[i][1]);
+        const Eigen::Vector3d nt = GetNormal(target, corres[i][1]);
         r = (vs - vt).dot(nt);
+        w = kernel.Weight(r);
         J_r.block<3, 1>(0, 0) = vs.cross(nt);
         J_r.block<3, 1>(3, 0) = nt;
     };
@@ -106,5 +139,106 @@ Eigen::Matrix4d TransformationEstimationPointToPlane::ComputeTransformation(
     return is_success ? extrinsic : Eigen::Matrix4d::Identity();
 }
 
+}  // unnamed namespace
+
+double TransformationEstimationPointToPoint::ComputeRMSE(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPointRMSE(source, target, corres);
+}
+
+Eigen::Matrix4d TransformationEstimationPointToPoint::ComputeTransformation(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPointTransformation(source, target, corres,
+                                             with_scaling_);
+}
+
+template <typename Scalar>
+double TransformationEstimationPointToPoint::ComputeRMSE(
+        const geometry::SoAPointCloud<Scalar> &source,
+        const geometry::SoAPointCloud<Scalar> &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPointRMSE(source, target, corres);
+}
+
+template <typename Scalar>
+Eigen::Matrix4d TransformationEstimationPointToPoint::ComputeTransformation(
+        const geometry::SoAPointCloud<Scalar> &source,
+        const geometry::SoAPointCloud<Scalar> &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPointTransformation(source, target, corres,
+                                             with_scaling_);
+}
+
+double TransformationEstimationPointToPlane::ComputeRMSE(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPlaneRMSE(source, target, corres);
+}
+
+Eigen::Matrix4d TransformationEstimationPointToPlane::ComputeTransformation(
+        const geometry::PointCloud &source,
+        const geometry::PointCloud &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPlaneTransformation(source, target, corres, *kernel_);
+}
+
+template <typename Scalar>
+double TransformationEstimationPointToPlane::ComputeRMSE(
+        const geometry::SoAPointCloud<Scalar> &source,
+        const geometry::SoAPointCloud<Scalar> &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPlaneRMSE(source, target, corres);
+}
+
+template <typename Scalar>
+Eigen::Matrix4d TransformationEstimationPointToPlane::ComputeTransformation(
+        const geometry::SoAPointCloud<Scalar> &source,
+        const geometry::SoAPointCloud<Scalar> &target,
+        const CorrespondenceSet &corres) const {
+    return ComputePointToPlaneTransformation(source, target, corres, *kernel_);
+}
+
+template double TransformationEstimationPointToPoint::ComputeRMSE<float>(
+        const geometry::SoAPointCloud<float> &source,
+        const geometry::SoAPointCloud<float> &target,
+        const CorrespondenceSet &corres) const;
+template double TransformationEstimationPointToPoint::ComputeRMSE<double>(
+        const geometry::SoAPointCloud<double> &source,
+        const geometry::SoAPointCloud<double> &target,
+        const CorrespondenceSet &corres) const;
+template Eigen::Matrix4d
+TransformationEstimationPointToPoint::ComputeTransformation<float>(
+        const geometry::SoAPointCloud<float> &source,
+        const geometry::SoAPointCloud<float> &target,
+        const CorrespondenceSet &corres) const;
+template Eigen::Matrix4d
+TransformationEstimationPointToPoint::ComputeTransformation<double>(
+        const geometry::SoAPointCloud<double> &source,
+        const geometry::SoAPointCloud<double> &target,
+        const CorrespondenceSet &corres) const;
+template double TransformationEstimationPointToPlane::ComputeRMSE<float>(
+        const geometry::SoAPointCloud<float> &source,
+        const geometry::SoAPointCloud<float> &target,
+        const CorrespondenceSet &corres) const;
+template double TransformationEstimationPointToPlane::ComputeRMSE<double>(
+        const geometry::SoAPointCloud<double> &source,
+        const geometry::SoAPointCloud<double> &target,
+        const CorrespondenceSet &corres) const;
+template Eigen::Matrix4d
+TransformationEstimationPointToPlane::ComputeTransformation<float>(
+        const geometry::SoAPointCloud<float> &source,
+        const geometry::SoAPointCloud<float> &target,
+        const CorrespondenceSet &corres) const;
+template Eigen::Matrix4d
+TransformationEstimationPointToPlane::ComputeTransformation<double>(
+        const geometry::SoAPointCloud<double> &source,
+        const geometry::SoAPointCloud<double> &target,
+        const CorrespondenceSet &corres) const;
+
 }  // namespace registration
 }  // namespace open3d
@@ -31,11 +31,15 @@
 #include <string>
 #include <vector>
 
+#include "Open3D/Registration/RobustKernel.h"
+
 namespace open3d {
 
 namespace geometry {
 class PointCloud;
-}
+template <typename Scalar>
+class SoAPointCloud;
+}  // namespace geometry
 
 namespace registration {
 
@@ -46,6 +50,7 @@ enum class TransformationEstimationType {
     PointToPoint = 1,
     PointToPlane = 2,
     ColoredICP = 3,
+    GeneralizedICP = 4,
 };
 
 /// \class TransformationEstimation
@@ -108,6 +113,17 @@ public:
             const geometry::PointCloud &source,
             const geometry::PointCloud &target,
             const CorrespondenceSet &corres) const override;
+    /// Same as ComputeRMSE() on SoAPointCloud, read in place.
+    template <typename Scalar>
+    double ComputeRMSE(const geometry::SoAPointCloud<Scalar> &source,
+                       const geometry::SoAPointCloud<Scalar> &target,
+                       const CorrespondenceSet &corres) const;
+    /// Same as ComputeTransformation() on SoAPointCloud, read in place.
+    template <typename Scalar>
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::SoAPointCloud<Scalar> &source,
+            const geometry::SoAPointCloud<Scalar> &target,
+            const CorrespondenceSet &corres) const;
 
 public:
     /// \brief Set to True to estimate scaling, False to force scaling to be 1.
@@ -132,6 +148,15 @@ public:
     TransformationEstimationPointToPlane() {}
     ~TransformationEstimationPointToPlane() override {}
 
+    /// \brief Parameterized Constructor.
+    ///
+    /// \param kernel The robust loss function applied to the point to plane
+    /// residuals. Each ICP iteration is one step of iteratively reweighted
+    /// least squares.
+    explicit TransformationEstimationPointToPlane(
+            std::shared_ptr<RobustKernel> kernel)
+        : kernel_(std::move(kernel)) {}
+
 public:
     TransformationEstimationType GetTransformationEstimationType()
             const override {
@@ -144,6 +169,21 @@ public:
             const geometry::PointCloud &source,
             const geometry::PointCloud &target,
             const CorrespondenceSet &corres) const override;
+    /// Same as ComputeRMSE() on SoAPointCloud, read in place.
+    template <typename Scalar>
+    double ComputeRMSE(const geometry::SoAPointCloud<Scalar> &source,
+                       const geometry::SoAPointCloud<Scalar> &target,
+                       const CorrespondenceSet &corres) const;
+    /// Same as ComputeTransformation() on SoAPointCloud, read in place.
+    template <typename Scalar>
+    Eigen::Matrix4d ComputeTransformation(
+            const geometry::SoAPointCloud<Scalar> &source,
+            const geometry::SoAPointCloud<Scalar> &target,
+            const CorrespondenceSet &corres) const;
+
+public:
+    /// The robust loss function used in the optimization.
+    std::shared_ptr<RobustKernel> kernel_ = std::make_shared<L2Loss>();
 
 private:
     const TransformationEstimationType type_ =
@@ -28,6 +28,7 @@
 
 #include <Eigen/Geometry>
 #include <Eigen/Sparse>
+#include <algorithm>
 
 #include "Open3D/Utility/Console.h"
 
@@ -165,47 +166,100 @@ SolveJacobianSystemAndObtainExtrinsicMatrixArray(const Eigen::MatrixXd &JTJ,
     }
 }
 
+namespace {
+
+/// Number of rows accumulated per block by ComputeJTJandJTr().
+const int JTJ_BLOCK_SIZE = 1024;
+
+/// Accumulates the rows [begin, end) of each block of JTJ_BLOCK_SIZE rows in
+/// parallel, then adds up the block sums in order. The block boundaries do not
+/// depend on the number of threads, so neither does the result.
 template <typename MatType, typename VecType>
-std::tuple<MatType, VecType, double> ComputeJTJandJTr(
-        std::function<void(int, VecType &, double &)> f,
-        int iteration_num,
-        bool verbose /*=true*/) {
+std::tuple<MatType, VecType, double> ReduceJTJandJTr(
+        const std::function<void(int, int, MatType &, VecType &, double &)>
+                &accumulate,
+        int iteration_num) {
+    int num_blocks = (iteration_num + JTJ_BLOCK_SIZE - 1) / JTJ_BLOCK_SIZE;
+    std::vector<MatType, Eigen::aligned_allocator<MatType>> JTJ_blocks(
+            num_blocks);
+    std::vector<VecType, Eigen::aligned_allocator<VecType>> JTr_blocks(
+            num_blocks);
+    std::vector<double> r2_sum_blocks(num_blocks, 0.0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int b = 0; b < num_blocks; b++) {
+        JTJ_blocks[b].setZero();
+        JTr_blocks[b].setZero();
+        accumulate(b * JTJ_BLOCK_SIZE,
+                   (std::min)(iteration_num, (b + 1) * JTJ_BLOCK_SIZE),
+                   JTJ_blocks[b], JTr_blocks[b], r2_sum_blocks[b]);
+    }
     MatType JTJ;
     VecType JTr;
     double r2_sum = 0.0;
     JTJ.setZero();
     JTr.setZero();
-#ifdef _OPENMP
-#pragma omp parallel
-    {
-#endif
-        MatType JTJ_private;
-        VecType JTr_private;
-        double r2_sum_private = 0.0;
-        JTJ_private.setZero();
-        JTr_private.setZero();
+    for (int b = 0; b < num_blocks; b++) {
+        JTJ += JTJ_blocks[b];
+        JTr += JTr_blocks[b];
+        r2_sum += r2_sum_blocks[b];
+    }
+    return std::make_tuple(std::move(JTJ), std::move(JTr), r2_sum);
+}
+
+}  // unnamed namespace
+
+template <typename MatType, typename VecType>
+std::tuple<MatType, VecType, double> ComputeJTJandJTr(
+        std::function<void(int, VecType &, double &)> f,
+        int iteration_num,
+        bool verbose /*=true*/) {
+    auto accumulate = [&](int begin, int end, MatType &JTJ_block,
+                          VecType &JTr_block, double &r2_sum_block) {
         VecType J_r;
         double r;
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int i = 0; i < iteration_num; i++) {
+        for (int i = begin; i < end; i++) {
             f(i, J_r, r);
-            JTJ_private.noalias() += J_r * J_r.transpose();
-            JTr_private.noalias() += J_r * r;
-            r2_sum_private += r * r;
-        }
-#ifdef _OPENMP
-#pragma omp critical
-        {
-#endif
-            JTJ += JTJ_private;
-            JTr += JTr_private;
-            r2_sum += r2_sum_private;
-#ifdef _OPENMP
+            JTJ_block.noalias() += J_r * J_r.transpose();
+            JTr_block.noalias() += J_r * r;
+            r2_sum_block += r * r;
         }
+    };
+    MatType JTJ;
+    VecType JTr;
+    double r2_sum;
+    std::tie(JTJ, JTr, r2_sum) =
+            ReduceJTJandJTr<MatType, VecType>(accumulate, iteration_num);
+    if (verbose) {
+        LogDebug("Residual : {:.2e} (# of elements : {:d})",
+                 r2_sum / (double)iteration_num, iteration_num);
     }
-#endif
+    return std::make_tuple(std::move(JTJ), std::move(JTr), r2_sum);
+}
+
+template <typename MatType, typename VecType>
+std::tuple<MatType, VecType, double> ComputeJTJandJTr(
+        std::function<void(int, VecType &, double &, double &)> f,
+        int iteration_num,
+        bool verbose /*=true*/) {
+    auto accumulate = [&](int begin, int end, MatType &JTJ_block,
+                          VecType &JTr_block, double &r2_sum_block) {
+        VecType J_r;
+        double r;
+        double w;
+        for (int i = begin; i < end; i++) {
+            f(i, J_r, r, w);
+            JTJ_block.noalias() += J_r * w * J_r.transpose();
+            JTr_block.noalias() += J_r * w * r;
+            r2_sum_block += r * r;
+        }
+    };
+    MatType JTJ;
+    VecType JTr;
+    double r2_sum;
+    std::tie(JTJ, JTr, r2_sum) =
+            ReduceJTJandJTr<MatType, VecType>(accumulate, iteration_num);
     if (verbose) {
         LogDebug("Residual : {:.2e} (# of elements : {:d})",
                  r2_sum / (double)iteration_num, iteration_num);
@@ -221,44 +275,24 @@ std::tuple<MatType, VecType, double> ComputeJTJandJTr(
                      std::vector<double> &)> f,
         int iteration_num,
         bool verbose /*=true*/) {
-    MatType JTJ;
-    VecType JTr;
-    double r2_sum = 0.0;
-    JTJ.setZero();
-    JTr.setZero();
-#ifdef _OPENMP
-#pragma omp parallel
-    {
-#endif
-        MatType JTJ_private;
-        VecType JTr_private;
-        double r2_sum_private = 0.0;
-        JTJ_private.setZero();
-        JTr_private.setZero();
+    auto accumulate = [&](int begin, int end, MatType &JTJ_block,
+                          VecType &JTr_block, double &r2_sum_block) {
         std::vector<double> r;
         std::vector<VecType, Eigen::aligned_allocator<VecType>> J_r;
-#ifdef _OPENMP
-#pragma omp for nowait
-#endif
-        for (int i = 0; i < iteration_num; i++) {
+        for (int i = begin; i < end; i++) {
             f(i, J_r, r);
             for (int j = 0; j < (int)r.size(); j++) {
-                JTJ_private.noalias() += J_r[j] * J_r[j].transpose();
-                JTr_private.noalias() += J_r[j] * r[j];
-                r2_sum_private += r[j] * r[j];
+                JTJ_block.noalias() += J_r[j] * J_r[j].transpose();
+                JTr_block.noalias() += J_r[j] * r[j];
+                r2_sum_block += r[j] * r[j];
             }
         }
-#ifdef _OPENMP
-#pragma omp critical
-        {
-#endif
-            JTJ += JTJ_private;
-            JTr += JTr_private;
-            r2_sum += r2_sum_private;
-#ifdef _OPENMP
-        }
-    }
-#endif
+    };
+    MatType JTJ;
+    VecType JTr;
+    double r2_sum;
+    std::tie(JTJ, JTr, r2_sum) =
+            ReduceJTJandJTr<MatType, VecType>(accumulate, iteration_num);
     if (verbose) {
         LogDebug("Residual : {:.2e} (# of elements : {:d})",
                  r2_sum / (double)iteration_num, iteration_num);
@@ -271,6 +305,10 @@ template std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> ComputeJTJandJTr(
         std::function<void(int, Eigen::Vector6d &, double &)> f,
         int iteration_num, bool verbose);
 
+template std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> ComputeJTJandJTr(
+        std::function<void(int, Eigen::Vector6d &, double &, double &)> f,
+        int iteration_num, bool verbose);
+
 template std::tuple<Eigen::Matrix6d, Eigen::Vector6d, double> ComputeJTJandJTr(
         std::function<void(int,
                            std::vector<Eigen::Vector6d, Vector6d_allocator> &,
@@ -99,6 +99,19 @@ std::tuple<MatType, VecType, double> ComputeJTJandJTr(
         int iteration_num,
         bool verbose = true);
 
+/// Function to compute weighted JTJ and Jtr, for iteratively reweighted least
+/// squares
+/// Input: function pointer f and total number of rows of Jacobian matrix
+/// Output: JTJ, JTr, sum of r^2
+/// Note: f takes index of row, and outputs corresponding residual, row vector
+/// and weight w. The row contributes w * J_r * J_r^T to JTJ and w * J_r * r to
+/// JTr.
+template <typename MatType, typename VecType>
+std::tuple<MatType, VecType, double> ComputeJTJandJTr(
+        std::function<void(int, VecType &, double &, double &)> f,
+        int iteration_num,
+        bool verbose = true);
+
 /// Function to compute JTJ and Jtr
 /// Input: function pointer f and total number of rows of Jacobian matrix
 /// Output: JTJ, JTr, sum of r^2
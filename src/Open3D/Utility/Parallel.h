@@ -0,0 +1,99 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace open3d {
+namespace utility {
+
+/// \brief Sorts the range [\p first, \p last) with \p comp on all OpenMP
+/// threads.
+///
+/// The range is cut into one chunk per thread, the chunks are sorted in
+/// parallel, then merged pairwise in log2(#threads) rounds. For a strict
+/// total order the result is the same as std::sort, independently of the
+/// number of threads.
+template <typename RandomIt, typename Compare>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp) {
+    // Below this size, the threads cost more than they save.
+    const int64_t kMinChunkSize = 1 << 14;
+    const int64_t size = last - first;
+    int num_chunks = 1;
+#ifdef _OPENMP
+    num_chunks = (std::min)(omp_get_max_threads(),
+                            int((size + kMinChunkSize - 1) / kMinChunkSize));
+#endif
+    if (num_chunks <= 1) {
+        std::sort(first, last, comp);
+        return;
+    }
+    std::vector<int64_t> bounds(num_chunks + 1);
+    for (int i = 0; i <= num_chunks; i++) {
+        bounds[i] = size * i / num_chunks;
+    }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < num_chunks; i++) {
+        std::sort(first + bounds[i], first + bounds[i + 1], comp);
+    }
+    for (int width = 1; width < num_chunks; width *= 2) {
+        // Chunk i is merged with chunk i + width, for i a multiple of
+        // 2 * width.
+        const int num_merges = (num_chunks + width - 1) / (2 * width);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int m = 0; m < num_merges; m++) {
+            const int i = 2 * width * m;
+            std::inplace_merge(first + bounds[i], first + bounds[i + width],
+                               first + bounds[(std::min)(i + 2 * width,
+                                                         num_chunks)],
+                               comp);
+        }
+    }
+}
+
+/// \brief Sorts the range [\p first, \p last) in ascending order on all
+/// OpenMP threads, see ParallelSort(first, last, comp).
+template <typename RandomIt>
+void ParallelSort(RandomIt first, RandomIt last) {
+    ParallelSort(
+            first, last,
+            std::less<typename std::iterator_traits<RandomIt>::value_type>());
+}
+
+}  // namespace utility
+}  // namespace open3d
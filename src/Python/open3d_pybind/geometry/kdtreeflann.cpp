@@ -114,23 +114,56 @@ void pybind_kdtreeflann(py::module &m) {
     static const std::unordered_map<std::string, std::string>
             map_kd_tree_flann_method_docs = {
                     {"query", "The input query point."},
+                    {"queries",
+                     "The input query points, one query per column."},
                     {"radius", "Search radius."},
                     {"max_nn",
                      "At maximum, ``max_nn`` neighbors will be searched."},
                     {"knn", "``knn`` neighbors will be searched."},
                     {"feature", "Feature data."},
-                    {"data", "Matrix data."}};
+                    {"data", "Matrix data."},
+                    {"precision",
+                     "Floating point precision of the index. ``Float32`` "
+                     "halves the memory footprint of the index."}};
     py::class_<geometry::KDTreeFlann, std::shared_ptr<geometry::KDTreeFlann>>
             kdtreeflann(m, "KDTreeFlann",
                         "KDTree with FLANN for nearest neighbor search.");
-    kdtreeflann.def(py::init<>())
-            .def(py::init<const Eigen::MatrixXd &>(), "data"_a)
+
+    // open3d.geometry.KDTreeFlann.Precision
+    py::enum_<geometry::KDTreeFlann::Precision> kdtreeflann_precision(
+            kdtreeflann, "Precision", py::arithmetic());
+    kdtreeflann_precision
+            .value("Float64", geometry::KDTreeFlann::Precision::Float64)
+            .value("Float32", geometry::KDTreeFlann::Precision::Float32)
+            .export_values();
+    kdtreeflann_precision.attr("__doc__") = docstring::static_property(
+            py::cpp_function([](py::handle arg) -> std::string {
+                return "Enum class for the floating point precision of the "
+                       "KDTree index.";
+            }),
+            py::none(), py::none(), "");
+
+    kdtreeflann
+            .def(py::init<geometry::KDTreeFlann::Precision>(),
+                 "precision"_a = geometry::KDTreeFlann::Precision::Float64)
+            .def(py::init<const Eigen::MatrixXd &,
+                          geometry::KDTreeFlann::Precision>(),
+                 "data"_a,
+                 "precision"_a = geometry::KDTreeFlann::Precision::Float64)
             .def("set_matrix_data", &geometry::KDTreeFlann::SetMatrixData,
                  "Sets the data for the KDTree from a matrix.", "data"_a)
-            .def(py::init<const geometry::Geometry &>(), "geometry"_a)
+            .def(py::init<const geometry::Geometry &,
+                          geometry::KDTreeFlann::Precision>(),
+                 "geometry"_a,
+                 "precision"_a = geometry::KDTreeFlann::Precision::Float64)
             .def("set_geometry", &geometry::KDTreeFlann::SetGeometry,
                  "Sets the data for the KDTree from geometry.", "geometry"_a)
-            .def(py::init<const registration::Feature &>(), "feature"_a)
+            .def(py::init<const registration::Feature &,
+                          geometry::KDTreeFlann::Precision>(),
+                 "feature"_a,
+                 "precision"_a = geometry::KDTreeFlann::Precision::Float64)
+            .def("get_precision", &geometry::KDTreeFlann::GetPrecision,
+                 "Returns the floating point precision of the index.")
             .def("set_feature", &geometry::KDTreeFlann::SetFeature,
                  "Sets the data for the KDTree from the feature data.",
                  "feature"_a)
@@ -250,7 +283,63 @@ void pybind_kdtreeflann(py::module &m) {
                                  "search_hybrid_vector_xd() error!");
                      return std::make_tuple(k, indices, distance2);
                  },
-                 "query"_a, "radius"_a, "max_nn"_a);
+                 "query"_a, "radius"_a, "max_nn"_a)
+            .def("batch_search_knn",
+                 [](const geometry::KDTreeFlann &tree,
+                    const Eigen::MatrixXd &queries, int knn) {
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     int k = tree.BatchSearchKNN(queries, knn, indices,
+                                                 distance2);
+                     if (k < 0)
+                         throw std::runtime_error("batch_search_knn() error!");
+                     return std::make_tuple(k, indices, distance2);
+                 },
+                 "Searches the knn nearest neighbors of all queries in "
+                 "parallel. The neighbors of query i are stored at "
+                 "[i * knn, (i + 1) * knn) of the output lists.",
+                 "queries"_a, "knn"_a)
+            .def("batch_search_radius",
+                 [](const geometry::KDTreeFlann &tree,
+                    const Eigen::MatrixXd &queries, double radius) {
+                     std::vector<int> offsets;
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     int k = tree.BatchSearchRadius(queries, radius, offsets,
+                                                    indices, distance2);
+                     if (k < 0)
+                         throw std::runtime_error(
+                                 "batch_search_radius() error!");
+                     return std::make_tuple(offsets, indices, distance2);
+                 },
+                 "Searches the neighbors within radius of all queries in "
+                 "parallel. The neighbors of query i are stored at "
+                 "[offsets[i], offsets[i + 1]) of the output lists.",
+                 "queries"_a, "radius"_a)
+            .def("batch_search_hybrid",
+                 [](const geometry::KDTreeFlann &tree,
+                    const Eigen::MatrixXd &queries, double radius,
+                    int max_nn) {
+                     std::vector<int> indices;
+                     std::vector<double> distance2;
+                     std::vector<int> counts;
+                     int k = tree.BatchSearchHybrid(queries, radius, max_nn,
+                                                    indices, distance2, counts);
+                     if (k < 0)
+                         throw std::runtime_error(
+                                 "batch_search_hybrid() error!");
+                     return std::make_tuple(counts, indices, distance2);
+                 },
+                 "Searches at most max_nn neighbors within radius of all "
+                 "queries in parallel. The counts[i] neighbors of query i are "
+                 "stored from position i * max_nn of the output lists.",
+                 "queries"_a, "radius"_a, "max_nn"_a);
+    docstring::ClassMethodDocInject(m, "KDTreeFlann", "batch_search_hybrid",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "KDTreeFlann", "batch_search_knn",
+                                    map_kd_tree_flann_method_docs);
+    docstring::ClassMethodDocInject(m, "KDTreeFlann", "batch_search_radius",
+                                    map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "search_hybrid_vector_3d",
                                     map_kd_tree_flann_method_docs);
     docstring::ClassMethodDocInject(m, "KDTreeFlann", "search_hybrid_vector_xd",
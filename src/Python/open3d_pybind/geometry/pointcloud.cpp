@@ -62,6 +62,9 @@ void pybind_pointcloud(py::module &m) {
                  "Returns ``True`` if the point cloud contains point normals.")
             .def("has_colors", &geometry::PointCloud::HasColors,
                  "Returns ``True`` if the point cloud contains point colors.")
+            .def("has_covariances", &geometry::PointCloud::HasCovariances,
+                 "Returns ``True`` if the point cloud contains point "
+                 "covariances.")
             .def("normalize_normals", &geometry::PointCloud::NormalizeNormals,
                  "Normalize point normals to length 1.")
             .def("paint_uniform_color",
@@ -91,6 +94,20 @@ void pybind_pointcloud(py::module &m) {
                  "points with "
                  "the 0-th point always chosen, not at random.",
                  "every_k_points"_a)
+            .def("random_down_sample",
+                 &geometry::PointCloud::RandomDownSample,
+                 "Function to downsample input pointcloud into output "
+                 "pointcloud with a random subset of points. Returns the "
+                 "downsampled pointcloud and the selected point indices.",
+                 "num_samples"_a, "seed"_a = 0)
+            .def("farthest_point_down_sample",
+                 &geometry::PointCloud::FarthestPointDownSample,
+                 "Function to downsample input pointcloud into output "
+                 "pointcloud with farthest point sampling, each selected "
+                 "point being the farthest from the ones selected before. "
+                 "Returns the downsampled pointcloud and the selected point "
+                 "indices in the order of selection.",
+                 "num_samples"_a, "start_index"_a = 0)
             .def("crop",
                  (std::shared_ptr<geometry::PointCloud>(
                          geometry::PointCloud::*)(
@@ -105,6 +122,24 @@ void pybind_pointcloud(py::module &m) {
                          geometry::PointCloud::Crop,
                  "Function to crop input pointcloud into output pointcloud",
                  "bounding_box"_a)
+            .def("crop_and_transform",
+                 (std::shared_ptr<geometry::PointCloud>(
+                         geometry::PointCloud::*)(
+                         const geometry::AxisAlignedBoundingBox &,
+                         const Eigen::Matrix4d &) const) &
+                         geometry::PointCloud::CropAndTransform,
+                 "Function to crop input pointcloud and transform the "
+                 "remaining points in a single pass",
+                 "bounding_box"_a, "transformation"_a)
+            .def("crop_and_transform",
+                 (std::shared_ptr<geometry::PointCloud>(
+                         geometry::PointCloud::*)(
+                         const geometry::OrientedBoundingBox &,
+                         const Eigen::Matrix4d &) const) &
+                         geometry::PointCloud::CropAndTransform,
+                 "Function to crop input pointcloud and transform the "
+                 "remaining points in a single pass",
+                 "bounding_box"_a, "transformation"_a)
             .def("remove_non_finite_points",
                  &geometry::PointCloud::RemoveNonFinitePoints,
                  "Function to remove non-finite points from the PointCloud",
@@ -124,7 +159,13 @@ void pybind_pointcloud(py::module &m) {
                  "are oriented with respect to the input point cloud if "
                  "normals exist",
                  "search_param"_a = geometry::KDTreeSearchParamKNN(),
-                 "fast_normal_computation"_a = true)
+                 "fast_normal_computation"_a = true,
+                 "precision"_a = geometry::KDTreeFlann::Precision::Float64)
+            .def("estimate_covariances",
+                 &geometry::PointCloud::EstimateCovariances,
+                 "Function to compute the covariance matrix of each point "
+                 "from its neighborhood.",
+                 "search_param"_a = geometry::KDTreeSearchParamKNN())
             .def("orient_normals_to_align_with_direction",
                  &geometry::PointCloud::OrientNormalsToAlignWithDirection,
                  "Function to orient the normals of a point cloud",
@@ -175,7 +216,16 @@ void pybind_pointcloud(py::module &m) {
             .def("segment_plane", &geometry::PointCloud::SegmentPlane,
                  "Segments a plane in the point cloud using the RANSAC "
                  "algorithm.",
-                 "distance_threshold"_a, "ransac_n"_a, "num_iterations"_a)
+                 "distance_threshold"_a, "ransac_n"_a, "num_iterations"_a,
+                 "probability"_a = 0.99999999, "seed"_a = 0)
+            .def("segment_planes", &geometry::PointCloud::SegmentPlanes,
+                 "Segments several planes in the point cloud, by running "
+                 "RANSAC on the points that do not belong to the planes "
+                 "found so far.",
+                 "num_planes"_a, "distance_threshold"_a = 0.01,
+                 "ransac_n"_a = 3, "num_iterations"_a = 100,
+                 "min_num_inliers"_a = 3, "probability"_a = 0.99999999,
+                 "seed"_a = 0)
             .def_static(
                     "create_from_depth_image",
                     &geometry::PointCloud::CreateFromDepthImage,
@@ -214,8 +264,12 @@ void pybind_pointcloud(py::module &m) {
                     "colors", &geometry::PointCloud::colors_,
                     "``float64`` array of shape ``(num_points, 3)``, "
                     "range ``[0, 1]`` , use ``numpy.asarray()`` to access "
-                    "data: RGB colors of points.");
+                    "data: RGB colors of points.")
+            .def_readwrite("covariances", &geometry::PointCloud::covariances_,
+                           "List of ``float64`` arrays of shape ``(3, 3)``: "
+                           "Points covariances.");
     docstring::ClassMethodDocInject(m, "PointCloud", "has_colors");
+    docstring::ClassMethodDocInject(m, "PointCloud", "has_covariances");
     docstring::ClassMethodDocInject(m, "PointCloud", "has_normals");
     docstring::ClassMethodDocInject(m, "PointCloud", "has_points");
     docstring::ClassMethodDocInject(m, "PointCloud", "normalize_normals");
@@ -240,9 +294,23 @@ void pybind_pointcloud(py::module &m) {
             m, "PointCloud", "uniform_down_sample",
             {{"every_k_points",
               "Sample rate, the selected point indices are [0, k, 2k, ...]"}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "random_down_sample",
+            {{"num_samples", "Number of points to select"},
+             {"seed", "Seed of the random number generator"}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "farthest_point_down_sample",
+            {{"num_samples", "Number of points to select"},
+             {"start_index", "Index of the first selected point"}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "crop",
             {{"bounding_box", "AxisAlignedBoundingBox to crop points"}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "crop_and_transform",
+            {{"bounding_box", "Bounding box to crop points"},
+             {"transformation",
+              "The 4x4 transformation matrix applied to the cropped "
+              "points"}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "remove_non_finite_points",
             {{"remove_nan", "Remove NaN values from the PointCloud"},
@@ -263,7 +331,14 @@ void pybind_pointcloud(py::module &m) {
              {"fast_normal_computation",
               "If true, the normal estiamtion uses a non-iterative method to "
               "extract the eigenvector from the covariance matrix. This is "
-              "faster, but is not as numerical stable."}});
+              "faster, but is not as numerical stable."},
+             {"precision",
+              "Precision of the KDTree used for the neighborhood search. "
+              "Float32 is faster and usually accurate enough for normals."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "estimate_covariances",
+            {{"search_param",
+              "The KDTree search parameters for neighborhood search."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "orient_normals_to_align_with_direction",
             {{"orientation_reference",
@@ -304,7 +379,31 @@ void pybind_pointcloud(py::module &m) {
              {"ransac_n",
               "Number of initial points to be considered inliers in each "
               "iteration."},
-             {"num_iterations", "Number of iterations."}});
+             {"num_iterations", "Maximum number of iterations."},
+             {"probability",
+              "Stop once a sample of inliers only has been drawn with this "
+              "probability, given the fitness of the best plane so far."},
+             {"seed",
+              "Seed of the random number generator. The same seed gives the "
+              "same result for any number of threads."}});
+    docstring::ClassMethodDocInject(
+            m, "PointCloud", "segment_planes",
+            {{"num_planes", "Maximum number of planes."},
+             {"distance_threshold",
+              "Max distance a point can be from the plane model, and still be "
+              "considered an inlier."},
+             {"ransac_n",
+              "Number of initial points to be considered inliers in each "
+              "iteration."},
+             {"num_iterations", "Maximum number of iterations per plane."},
+             {"min_num_inliers",
+              "The segmentation stops at the first plane with fewer inliers."},
+             {"probability",
+              "Stop once a sample of inliers only has been drawn with this "
+              "probability, given the fitness of the best plane so far."},
+             {"seed",
+              "Seed of the random number generator. The same seed gives the "
+              "same result for any number of threads."}});
     docstring::ClassMethodDocInject(
             m, "PointCloud", "create_from_depth_image",
             {{"depth",
@@ -45,6 +45,15 @@ public:
         PYBIND11_OVERLOAD_PURE(void, TSDFVolumeBase, image, intrinsic,
                                extrinsic);
     }
+    void IntegrateWithDepthToCameraDistanceMultiplier(
+            const geometry::RGBDImage &image,
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            const geometry::Image &depth_to_camera_distance_multiplier)
+            override {
+        PYBIND11_OVERLOAD_PURE(void, TSDFVolumeBase, image, intrinsic,
+                               extrinsic, depth_to_camera_distance_multiplier);
+    }
     std::shared_ptr<geometry::PointCloud> ExtractPointCloud() override {
         PYBIND11_OVERLOAD_PURE(std::shared_ptr<geometry::PointCloud>,
                                TSDFVolumeBase, );
@@ -53,6 +62,15 @@ public:
         PYBIND11_OVERLOAD_PURE(std::shared_ptr<geometry::TriangleMesh>,
                                TSDFVolumeBase, );
     }
+    std::shared_ptr<integration::RaycastResult> Raycast(
+            const camera::PinholeCameraIntrinsic &intrinsic,
+            const Eigen::Matrix4d &extrinsic,
+            double depth_min,
+            double depth_max) override {
+        PYBIND11_OVERLOAD_PURE(std::shared_ptr<integration::RaycastResult>,
+                               TSDFVolumeBase, intrinsic, extrinsic,
+                               depth_min, depth_max);
+    }
 };
 
 void pybind_integration_classes(py::module &m) {
@@ -71,6 +89,29 @@ void pybind_integration_classes(py::module &m) {
             }),
             py::none(), py::none(), "");
 
+    // open3d.integration.RaycastResult
+    py::class_<integration::RaycastResult,
+               std::shared_ptr<integration::RaycastResult>>
+            raycast_result(m, "RaycastResult",
+                           "Images rendered from a TSDFVolume by raycasting.");
+    py::detail::bind_default_constructor<integration::RaycastResult>(
+            raycast_result);
+    raycast_result
+            .def_readwrite("vertex_map",
+                           &integration::RaycastResult::vertex_map_,
+                           "``3`` channels of float: Surface points in the "
+                           "camera frame.")
+            .def_readwrite("normal_map",
+                           &integration::RaycastResult::normal_map_,
+                           "``3`` channels of float: Unit surface normals in "
+                           "the camera frame.")
+            .def_readwrite("depth", &integration::RaycastResult::depth_,
+                           "``1`` channel of float: Depth along the camera z "
+                           "axis, 0 where the ray misses the surface.")
+            .def_readwrite("color", &integration::RaycastResult::color_,
+                           "Surface color, empty for "
+                           "``TSDFVolumeColorType.NoColor``.");
+
     // open3d.integration.TSDFVolume
     py::class_<integration::TSDFVolume, PyTSDFVolume<integration::TSDFVolume>>
             tsdfvolume(m, "TSDFVolume", R"(Base class of the Truncated
@@ -89,12 +130,23 @@ In SIGGRAPH, 1996)");
             .def("integrate", &integration::TSDFVolume::Integrate,
                  "Function to integrate an RGB-D image into the volume",
                  "image"_a, "intrinsic"_a, "extrinsic"_a)
+            .def("integrate_sequence",
+                 &integration::TSDFVolume::IntegrateSequence,
+                 "Function to integrate a sequence of RGB-D images, loading "
+                 "the next frame while the current one is integrated",
+                 "frame_source"_a, "trajectory"_a,
+                 py::call_guard<py::gil_scoped_release>())
             .def("extract_point_cloud",
                  &integration::TSDFVolume::ExtractPointCloud,
                  "Function to extract a point cloud with normals")
             .def("extract_triangle_mesh",
                  &integration::TSDFVolume::ExtractTriangleMesh,
                  "Function to extract a triangle mesh")
+            .def("raycast", &integration::TSDFVolume::Raycast,
+                 "Function to render the surface seen by a camera by "
+                 "raycasting",
+                 "intrinsic"_a, "extrinsic"_a, "depth_min"_a = 0.1,
+                 "depth_max"_a = 3.0)
             .def_readwrite("voxel_length",
                            &integration::TSDFVolume::voxel_length_,
                            "float: Length of the voxel in meters.")
@@ -111,6 +163,19 @@ In SIGGRAPH, 1996)");
             {{"image", "RGBD image."},
              {"intrinsic", "Pinhole camera intrinsic parameters."},
              {"extrinsic", "Extrinsic parameters."}});
+    docstring::ClassMethodDocInject(
+            m, "TSDFVolume", "integrate_sequence",
+            {{"frame_source",
+              "Function returning the RGBD image of frame i, or None to skip "
+              "the frame. It is called on a worker thread."},
+             {"trajectory",
+              "Camera intrinsic and extrinsic parameters of every frame."}});
+    docstring::ClassMethodDocInject(
+            m, "TSDFVolume", "raycast",
+            {{"intrinsic", "Pinhole camera intrinsic parameters."},
+             {"extrinsic", "Extrinsic parameters, mapping world to camera."},
+             {"depth_min", "Minimum depth of the rendered surface."},
+             {"depth_max", "Maximum depth of the rendered surface."}});
     docstring::ClassMethodDocInject(m, "TSDFVolume", "reset");
 
     // open3d.integration.UniformTSDFVolume: open3d.integration.TSDFVolume
@@ -205,9 +270,59 @@ In SIGGRAPH, 2013)");
             .def("extract_voxel_point_cloud",
                  &integration::ScalableTSDFVolume::ExtractVoxelPointCloud,
                  "Debug function to extract the voxel data into a point "
-                 "cloud.");
+                 "cloud.")
+            .def("extract_dirty_triangle_meshes",
+                 &integration::ScalableTSDFVolume::ExtractDirtyTriangleMeshes,
+                 "Function to extract the meshes of the volume units "
+                 "modified since the previous call, as a list of (unit "
+                 "index, mesh) pairs.")
+            .def("enable_paging",
+                 &integration::ScalableTSDFVolume::EnablePaging,
+                 "Function to page the volume units out to disk, keeping "
+                 "the units within working_radius of the camera and at most "
+                 "memory_budget bytes of voxels in memory.",
+                 "directory"_a, "memory_budget"_a, "working_radius"_a = 0.0)
+            .def("disable_paging",
+                 &integration::ScalableTSDFVolume::DisablePaging,
+                 "Function to load the paged out units back to memory and "
+                 "disable paging.")
+            .def("is_paging_enabled",
+                 &integration::ScalableTSDFVolume::IsPagingEnabled,
+                 "Returns ``True`` if paging is enabled.")
+            .def("get_resident_memory_size",
+                 &integration::ScalableTSDFVolume::GetResidentMemorySize,
+                 "Returns the size in bytes of the voxels in memory.")
+            .def("write_to_file",
+                 &integration::ScalableTSDFVolume::WriteToFile,
+                 "Function to write the volume to a binary file.",
+                 "filename"_a)
+            .def("read_from_file",
+                 &integration::ScalableTSDFVolume::ReadFromFile,
+                 "Function to replace the volume by a binary file written "
+                 "with write_to_file.",
+                 "filename"_a);
     docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
                                     "extract_voxel_point_cloud");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "extract_dirty_triangle_meshes");
+    docstring::ClassMethodDocInject(
+            m, "ScalableTSDFVolume", "enable_paging",
+            {{"directory", "Directory of the page files."},
+             {"memory_budget",
+              "Maximum size in bytes of the voxels in memory, 0 for no "
+              "limit."},
+             {"working_radius",
+              "Radius around the camera center of the units kept in memory, "
+              "0 for no limit."}});
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume", "disable_paging");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "is_paging_enabled");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume",
+                                    "get_resident_memory_size");
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume", "write_to_file",
+                                    {{"filename", "Path of the file."}});
+    docstring::ClassMethodDocInject(m, "ScalableTSDFVolume", "read_from_file",
+                                    {{"filename", "Path of the file."}});
 }
 
 void pybind_integration_methods(py::module &m) {
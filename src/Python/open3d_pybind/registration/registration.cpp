@@ -30,6 +30,9 @@
 #include "Open3D/Registration/CorrespondenceChecker.h"
 #include "Open3D/Registration/FastGlobalRegistration.h"
 #include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/GeneralizedICP.h"
+#include "Open3D/Registration/MultiScaleICP.h"
+#include "Open3D/Registration/RobustKernel.h"
 #include "Open3D/Registration/TransformationEstimation.h"
 #include "Open3D/Utility/Console.h"
 
@@ -64,6 +67,15 @@ public:
     }
 };
 
+template <class RobustKernelBase = registration::RobustKernel>
+class PyRobustKernel : public RobustKernelBase {
+public:
+    using RobustKernelBase::RobustKernelBase;
+    double Weight(double residual) const override {
+        PYBIND11_OVERLOAD_PURE(double, RobustKernelBase, residual);
+    }
+};
+
 template <class CorrespondenceCheckerBase = registration::CorrespondenceChecker>
 class PyCorrespondenceChecker : public CorrespondenceCheckerBase {
 public:
@@ -122,7 +134,9 @@ void pybind_registration_classes(py::module &m) {
             m, "RANSACConvergenceCriteria",
             "Class that defines the convergence criteria of RANSAC. RANSAC "
             "algorithm stops if the iteration number hits ``max_iteration``, "
-            "or the validation has been run for ``max_validation`` times. Note "
+            "or the validation has been run for ``max_validation`` times, or "
+            "enough iterations have been run to find the best hypothesis with "
+            "probability ``confidence``. Note "
             "that the validation is the most computational expensive operator "
             "in an iteration. Most iterations do not do full validation. It is "
             "crucial to control ``max_validation`` so that the computation "
@@ -130,11 +144,13 @@ void pybind_registration_classes(py::module &m) {
     py::detail::bind_copy_functions<registration::RANSACConvergenceCriteria>(
             ransac_criteria);
     ransac_criteria
-            .def(py::init([](int max_iteration, int max_validation) {
+            .def(py::init([](int max_iteration, int max_validation,
+                             double confidence) {
                      return new registration::RANSACConvergenceCriteria(
-                             max_iteration, max_validation);
+                             max_iteration, max_validation, confidence);
                  }),
-                 "max_iteration"_a = 1000, "max_validation"_a = 1000)
+                 "max_iteration"_a = 1000, "max_validation"_a = 1000,
+                 "confidence"_a = 1.0)
             .def_readwrite(
                     "max_iteration",
                     &registration::RANSACConvergenceCriteria::max_iteration_,
@@ -144,13 +160,19 @@ void pybind_registration_classes(py::module &m) {
                     &registration::RANSACConvergenceCriteria::max_validation_,
                     "Maximum times the validation has been run before the "
                     "iteration stops.")
+            .def_readwrite(
+                    "confidence",
+                    &registration::RANSACConvergenceCriteria::confidence_,
+                    "Desired probability of drawing at least one sample of "
+                    "inliers. 1.0 disables the adaptive termination.")
             .def("__repr__",
                  [](const registration::RANSACConvergenceCriteria &c) {
                      return fmt::format(
                              "registration::RANSACConvergenceCriteria "
                              "class with max_iteration={:d}, "
-                             "and max_validation={:d}",
-                             c.max_iteration_, c.max_validation_);
+                             "max_validation={:d}, and confidence={:e}",
+                             c.max_iteration_, c.max_validation_,
+                             c.confidence_);
                  });
 
     // open3d.registration.TransformationEstimation
@@ -223,6 +245,83 @@ The homogeneous transformation is given by
 Sets :math:`c = 1` if ``with_scaling`` is ``False``.
 )");
 
+    // open3d.registration.RobustKernel
+    py::class_<registration::RobustKernel,
+               std::shared_ptr<registration::RobustKernel>,
+               PyRobustKernel<registration::RobustKernel>>
+            robust_kernel(m, "RobustKernel",
+                          "Base class that models a robust kernel for outlier "
+                          "rejection, applied as iteratively reweighted least "
+                          "squares.");
+    robust_kernel.def(py::init<>())
+            .def("weight", &registration::RobustKernel::Weight,
+                 "Returns the weight of a residual.", "residual"_a);
+
+    // open3d.registration.L2Loss: RobustKernel
+    py::class_<registration::L2Loss, std::shared_ptr<registration::L2Loss>,
+               registration::RobustKernel>
+            l2_loss(m, "L2Loss",
+                    "Plain least squares, every residual has weight 1.");
+    l2_loss.def(py::init<>()).def("__repr__", [](const registration::L2Loss &) {
+        return std::string("registration::L2Loss");
+    });
+
+    // open3d.registration.HuberLoss: RobustKernel
+    py::class_<registration::HuberLoss,
+               std::shared_ptr<registration::HuberLoss>,
+               registration::RobustKernel>
+            huber_loss(m, "HuberLoss",
+                       "Huber loss, residuals beyond ``k`` are down-weighted "
+                       "by ``k / |r|``.");
+    huber_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::HuberLoss::k_,
+                           "Threshold between the quadratic and the linear "
+                           "part.")
+            .def("__repr__", [](const registration::HuberLoss &l) {
+                return fmt::format("registration::HuberLoss with k={:e}",
+                                   l.k_);
+            });
+
+    // open3d.registration.CauchyLoss: RobustKernel
+    py::class_<registration::CauchyLoss,
+               std::shared_ptr<registration::CauchyLoss>,
+               registration::RobustKernel>
+            cauchy_loss(m, "CauchyLoss",
+                        "Cauchy loss, with weight ``1 / (1 + (r / k)^2)``.");
+    cauchy_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::CauchyLoss::k_,
+                           "Scale parameter.")
+            .def("__repr__", [](const registration::CauchyLoss &l) {
+                return fmt::format("registration::CauchyLoss with k={:e}",
+                                   l.k_);
+            });
+
+    // open3d.registration.GMLoss: RobustKernel
+    py::class_<registration::GMLoss, std::shared_ptr<registration::GMLoss>,
+               registration::RobustKernel>
+            gm_loss(m, "GMLoss",
+                    "Geman-McClure loss, with weight ``k^2 / (k + r^2)^2``.");
+    gm_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::GMLoss::k_, "Scale parameter.")
+            .def("__repr__", [](const registration::GMLoss &l) {
+                return fmt::format("registration::GMLoss with k={:e}", l.k_);
+            });
+
+    // open3d.registration.TukeyLoss: RobustKernel
+    py::class_<registration::TukeyLoss,
+               std::shared_ptr<registration::TukeyLoss>,
+               registration::RobustKernel>
+            tukey_loss(m, "TukeyLoss",
+                       "Tukey biweight loss, residuals beyond ``k`` are "
+                       "ignored.");
+    tukey_loss.def(py::init<double>(), "k"_a)
+            .def_readwrite("k", &registration::TukeyLoss::k_,
+                           "Residuals beyond k are ignored.")
+            .def("__repr__", [](const registration::TukeyLoss &l) {
+                return fmt::format("registration::TukeyLoss with k={:e}",
+                                   l.k_);
+            });
+
     // open3d.registration.TransformationEstimationPointToPlane:
     // TransformationEstimation
     py::class_<registration::TransformationEstimationPointToPlane,
@@ -236,11 +335,64 @@ Sets :math:`c = 1` if ``with_scaling`` is ``False``.
             registration::TransformationEstimationPointToPlane>(te_p2l);
     py::detail::bind_copy_functions<
             registration::TransformationEstimationPointToPlane>(te_p2l);
-    te_p2l.def(
-            "__repr__",
-            [](const registration::TransformationEstimationPointToPlane &te) {
-                return std::string("TransformationEstimationPointToPlane");
-            });
+    te_p2l.def(py::init([](std::shared_ptr<registration::RobustKernel>
+                                   kernel) {
+                   return new registration::
+                           TransformationEstimationPointToPlane(
+                                   std::move(kernel));
+               }),
+               "kernel"_a)
+            .def("__repr__",
+                 [](const registration::TransformationEstimationPointToPlane
+                            &te) {
+                     return std::string("TransformationEstimationPointToPlane");
+                 })
+            .def_readwrite("kernel",
+                           &registration::TransformationEstimationPointToPlane::
+                                   kernel_,
+                           "Robust kernel applied to the point to plane "
+                           "residuals.");
+
+    // open3d.registration.TransformationEstimationForGeneralizedICP:
+    // TransformationEstimation
+    py::class_<registration::TransformationEstimationForGeneralizedICP,
+               PyTransformationEstimation<
+                       registration::TransformationEstimationForGeneralizedICP>,
+               registration::TransformationEstimation>
+            te_gicp(m, "TransformationEstimationForGeneralizedICP",
+                    "Class to estimate a transformation for Generalized ICP "
+                    "(plane to plane), using per-point covariances.");
+    py::detail::bind_copy_functions<
+            registration::TransformationEstimationForGeneralizedICP>(te_gicp);
+    te_gicp.def(py::init([](double epsilon,
+                            std::shared_ptr<registration::RobustKernel>
+                                    kernel) {
+                    return new registration::
+                            TransformationEstimationForGeneralizedICP(
+                                    epsilon, std::move(kernel));
+                }),
+                "epsilon"_a = 1e-3,
+                "kernel"_a = std::make_shared<registration::L2Loss>())
+            .def("__repr__",
+                 [](const registration::
+                            TransformationEstimationForGeneralizedICP &te) {
+                     return fmt::format(
+                             "TransformationEstimationForGeneralizedICP "
+                             "with epsilon={:e}",
+                             te.epsilon_);
+                 })
+            .def_readwrite("epsilon",
+                           &registration::
+                                   TransformationEstimationForGeneralizedICP::
+                                           epsilon_,
+                           "Smallest eigenvalue of the regularized "
+                           "covariances.")
+            .def_readwrite("kernel",
+                           &registration::
+                                   TransformationEstimationForGeneralizedICP::
+                                           kernel_,
+                           "Robust kernel applied to the Mahalanobis "
+                           "distances.");
 
     // open3d.registration.CorrespondenceChecker
     py::class_<registration::CorrespondenceChecker,
@@ -505,6 +657,9 @@ static const std::unordered_map<std::string, std::string>
                 {"lambda_geometric", "lambda_geometric value"},
                 {"max_correspondence_distance",
                  "Maximum correspondence points-pair distance."},
+                {"max_correspondence_distances",
+                 "Maximum correspondence points-pair distance of each "
+                 "level."},
                 {"option", "Registration option"},
                 {"ransac_n", "Fit ransac with ``ransac_n`` correspondences"},
                 {"source_feature", "Source point cloud feature."},
@@ -516,14 +671,24 @@ static const std::unordered_map<std::string, std::string>
                  "``target``"}};
 
 void pybind_registration_methods(py::module &m) {
-    m.def("evaluate_registration", &registration::EvaluateRegistration,
+    m.def("evaluate_registration",
+          static_cast<registration::RegistrationResult (*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &)>(
+                  &registration::EvaluateRegistration),
           "Function for evaluating registration between point clouds",
           "source"_a, "target"_a, "max_correspondence_distance"_a,
           "transformation"_a = Eigen::Matrix4d::Identity());
     docstring::FunctionDocInject(m, "evaluate_registration",
                                  map_shared_argument_docstrings);
 
-    m.def("registration_icp", &registration::RegistrationICP,
+    m.def("registration_icp",
+          static_cast<registration::RegistrationResult (*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &,
+                  const registration::TransformationEstimation &,
+                  const registration::ICPConvergenceCriteria &)>(
+                  &registration::RegistrationICP),
           "Function for ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
           "init"_a = Eigen::Matrix4d::Identity(),
@@ -533,7 +698,12 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_icp",
                                  map_shared_argument_docstrings);
 
-    m.def("registration_colored_icp", &registration::RegistrationColoredICP,
+    m.def("registration_colored_icp",
+          static_cast<registration::RegistrationResult (*)(
+                  const geometry::PointCloud &, const geometry::PointCloud &,
+                  double, const Eigen::Matrix4d &,
+                  const registration::ICPConvergenceCriteria &, double)>(
+                  &registration::RegistrationColoredICP),
           "Function for Colored ICP registration", "source"_a, "target"_a,
           "max_correspondence_distance"_a,
           "init"_a = Eigen::Matrix4d::Identity(),
@@ -542,6 +712,187 @@ void pybind_registration_methods(py::module &m) {
     docstring::FunctionDocInject(m, "registration_colored_icp",
                                  map_shared_argument_docstrings);
 
+    m.def("registration_generalized_icp",
+          &registration::RegistrationGeneralizedICP,
+          "Function for Generalized ICP registration", "source"_a, "target"_a,
+          "max_correspondence_distance"_a,
+          "init"_a = Eigen::Matrix4d::Identity(),
+          "estimation_method"_a =
+                  registration::TransformationEstimationForGeneralizedICP(),
+          "criteria"_a = registration::ICPConvergenceCriteria());
+    docstring::FunctionDocInject(m, "registration_generalized_icp",
+                                 map_shared_argument_docstrings);
+
+    // open3d.registration.RegistrationContext
+    py::class_<registration::RegistrationContext,
+               std::shared_ptr<registration::RegistrationContext>>
+            registration_context(
+                    m, "RegistrationContext",
+                    "Target of ICP registration with a prebuilt KDTree, "
+                    "reused across registrations of many sources.");
+    registration_context
+            .def(py::init([](std::shared_ptr<geometry::PointCloud> target,
+                             geometry::KDTreeFlann::Precision precision) {
+                     return std::make_shared<registration::RegistrationContext>(
+                             std::shared_ptr<const geometry::PointCloud>(
+                                     target),
+                             precision);
+                 }),
+                 "target"_a,
+                 "precision"_a = geometry::KDTreeFlann::Precision::Float64)
+            .def("get_target", &registration::RegistrationContext::GetTarget,
+                 py::return_value_policy::reference_internal,
+                 "Returns the target point cloud.")
+            .def("evaluate_registration",
+                 [](registration::RegistrationContext &context,
+                    const geometry::PointCloud &source,
+                    double max_correspondence_distance,
+                    const Eigen::Matrix4d &transformation) {
+                     return registration::EvaluateRegistration(
+                             source, context, max_correspondence_distance,
+                             transformation);
+                 },
+                 "Function for evaluating registration against the target of "
+                 "the context",
+                 "source"_a, "max_correspondence_distance"_a,
+                 "transformation"_a = Eigen::Matrix4d::Identity())
+            .def("registration_icp",
+                 [](registration::RegistrationContext &context,
+                    const geometry::PointCloud &source,
+                    double max_correspondence_distance,
+                    const Eigen::Matrix4d &init,
+                    const registration::TransformationEstimation &estimation,
+                    const registration::ICPConvergenceCriteria &criteria) {
+                     return registration::RegistrationICP(
+                             source, context, max_correspondence_distance,
+                             init, estimation, criteria);
+                 },
+                 "Function for ICP registration against the target of the "
+                 "context",
+                 "source"_a, "max_correspondence_distance"_a,
+                 "init"_a = Eigen::Matrix4d::Identity(),
+                 "estimation_method"_a =
+                         registration::TransformationEstimationPointToPoint(
+                                 false),
+                 "criteria"_a = registration::ICPConvergenceCriteria())
+            .def("registration_colored_icp",
+                 [](registration::RegistrationContext &context,
+                    const geometry::PointCloud &source,
+                    double max_correspondence_distance,
+                    const Eigen::Matrix4d &init,
+                    const registration::ICPConvergenceCriteria &criteria,
+                    double lambda_geometric) {
+                     return registration::RegistrationColoredICP(
+                             source, context, max_correspondence_distance,
+                             init, criteria, lambda_geometric);
+                 },
+                 "Function for Colored ICP registration against the target "
+                 "of a context created by "
+                 "create_registration_context_for_colored_icp",
+                 "source"_a, "max_correspondence_distance"_a,
+                 "init"_a = Eigen::Matrix4d::Identity(),
+                 "criteria"_a = registration::ICPConvergenceCriteria(),
+                 "lambda_geometric"_a = 0.968);
+    docstring::ClassMethodDocInject(m, "RegistrationContext",
+                                    "evaluate_registration",
+                                    map_shared_argument_docstrings);
+    docstring::ClassMethodDocInject(m, "RegistrationContext",
+                                    "registration_icp",
+                                    map_shared_argument_docstrings);
+    docstring::ClassMethodDocInject(m, "RegistrationContext",
+                                    "registration_colored_icp",
+                                    map_shared_argument_docstrings);
+
+    m.def("create_registration_context_for_colored_icp",
+          &registration::CreateRegistrationContextForColoredICP,
+          "Creates a RegistrationContext for Colored ICP, estimating the "
+          "target color gradients once",
+          "target"_a, "max_correspondence_distance"_a);
+    docstring::FunctionDocInject(m,
+                                 "create_registration_context_for_colored_icp",
+                                 map_shared_argument_docstrings);
+
+    // open3d.registration.PointCloudPyramid
+    py::class_<registration::PointCloudPyramid,
+               std::shared_ptr<registration::PointCloudPyramid>>
+            pyramid(m, "PointCloudPyramid",
+                    "Point cloud downsampled at a list of voxel sizes, with "
+                    "normals and cached KDTrees, for multi-scale "
+                    "registration.");
+    pyramid.def(py::init<const geometry::PointCloud &,
+                         const std::vector<double> &, bool, bool, double>(),
+                "cloud"_a, "voxel_sizes"_a, "estimate_normals"_a = true,
+                "estimate_covariances"_a = false,
+                "covariance_epsilon"_a = 1e-3)
+            .def("num_levels", &registration::PointCloudPyramid::NumLevels,
+                 "Returns the number of levels.")
+            .def("get_voxel_size",
+                 &registration::PointCloudPyramid::GetVoxelSize,
+                 "Returns the voxel size of a level.", "level"_a)
+            .def("get_level", &registration::PointCloudPyramid::GetLevel,
+                 py::return_value_policy::reference_internal,
+                 "Returns the point cloud of a level.", "level"_a);
+
+    // open3d.registration.MultiScaleICPLevelResult
+    py::class_<registration::MultiScaleICPLevelResult> level_result(
+            m, "MultiScaleICPLevelResult",
+            "Class that contains the result of one level of multi-scale ICP.");
+    py::detail::bind_default_constructor<
+            registration::MultiScaleICPLevelResult>(level_result);
+    py::detail::bind_copy_functions<registration::MultiScaleICPLevelResult>(
+            level_result);
+    level_result
+            .def_readwrite(
+                    "voxel_size",
+                    &registration::MultiScaleICPLevelResult::voxel_size_,
+                    "float: Voxel size of the level.")
+            .def_readwrite("max_correspondence_distance",
+                           &registration::MultiScaleICPLevelResult::
+                                   max_correspondence_distance_,
+                           "float: Maximum correspondence points-pair "
+                           "distance of the level.")
+            .def_readwrite("fitness",
+                           &registration::MultiScaleICPLevelResult::fitness_,
+                           "float: Fitness after the level.")
+            .def_readwrite(
+                    "inlier_rmse",
+                    &registration::MultiScaleICPLevelResult::inlier_rmse_,
+                    "float: RMSE of all inlier correspondences after the "
+                    "level.")
+            .def_readwrite("time",
+                           &registration::MultiScaleICPLevelResult::time_,
+                           "float: Time spent on the level, in milliseconds.")
+            .def("__repr__",
+                 [](const registration::MultiScaleICPLevelResult &r) {
+                     return fmt::format(
+                             "registration::MultiScaleICPLevelResult with "
+                             "voxel_size={:e}, fitness={:e}, "
+                             "inlier_rmse={:e}, and time={:.2f} ms",
+                             r.voxel_size_, r.fitness_, r.inlier_rmse_,
+                             r.time_);
+                 });
+
+    m.def("registration_multi_scale_icp",
+          static_cast<std::tuple<
+                  registration::RegistrationResult,
+                  std::vector<registration::MultiScaleICPLevelResult>> (*)(
+                  const registration::PointCloudPyramid &,
+                  registration::PointCloudPyramid &,
+                  const std::vector<double> &,
+                  const std::vector<registration::ICPConvergenceCriteria> &,
+                  const Eigen::Matrix4d &,
+                  const registration::TransformationEstimation &)>(
+                  &registration::RegistrationMultiScaleICP),
+          "Function for coarse-to-fine ICP registration of point cloud "
+          "pyramids. Returns the registration result of the last level and "
+          "the result of each level.",
+          "source"_a, "target"_a, "max_correspondence_distances"_a,
+          "criteria"_a, "init"_a = Eigen::Matrix4d::Identity(),
+          "estimation_method"_a =
+                  registration::TransformationEstimationPointToPoint(false));
+    docstring::FunctionDocInject(m, "registration_multi_scale_icp",
+                                 map_shared_argument_docstrings);
+
     m.def("registration_ransac_based_on_correspondence",
           &registration::RegistrationRANSACBasedOnCorrespondence,
           "Function for global RANSAC registration based on a set of "
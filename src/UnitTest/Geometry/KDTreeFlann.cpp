@@ -144,3 +144,219 @@ TEST(KDTreeFlann, SearchHybrid) {
     ExpectEQ(ref_indices, indices);
     ExpectEQ(ref_distance2, distance2);
 }
+
+TEST(KDTreeFlann, BatchSearchKNN) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    int knn = 7;
+    vector<int> indices;
+    vector<double> distance2;
+
+    int result = kdtree.BatchSearchKNN(pc.points_, knn, indices, distance2);
+
+    EXPECT_EQ(result, size * knn);
+    EXPECT_EQ(indices.size(), size_t(size * knn));
+    EXPECT_EQ(distance2.size(), size_t(size * knn));
+
+    for (int i = 0; i < size; i++) {
+        vector<int> ref_indices;
+        vector<double> ref_distance2;
+        kdtree.SearchKNN(pc.points_[i], knn, ref_indices, ref_distance2);
+        ExpectEQ(ref_indices, vector<int>(indices.begin() + i * knn,
+                                          indices.begin() + (i + 1) * knn));
+        ExpectEQ(ref_distance2,
+                 vector<double>(distance2.begin() + i * knn,
+                                distance2.begin() + (i + 1) * knn));
+    }
+
+    // Fewer points than knn.
+    MatrixXd data(3, 2);
+    data << 0.0, 2.0, 1.0, 0.0, 0.0, 0.0;
+    geometry::KDTreeFlann kdtree_small(data);
+    MatrixXd queries = MatrixXd::Zero(3, 1);
+    result = kdtree_small.BatchSearchKNN(queries, 3, indices, distance2);
+
+    EXPECT_EQ(result, 2);
+    ExpectEQ(vector<int>({0, 1, -1}), indices);
+}
+
+TEST(KDTreeFlann, BatchSearchRadius) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    double radius = 3.0;
+    vector<int> offsets;
+    vector<int> indices;
+    vector<double> distance2;
+
+    int result = kdtree.BatchSearchRadius(pc.points_, radius, offsets, indices,
+                                          distance2);
+
+    EXPECT_EQ(offsets.size(), size_t(size + 1));
+    EXPECT_EQ(result, offsets.back());
+    EXPECT_EQ(indices.size(), size_t(result));
+    EXPECT_EQ(distance2.size(), size_t(result));
+
+    for (int i = 0; i < size; i++) {
+        vector<int> ref_indices;
+        vector<double> ref_distance2;
+        kdtree.SearchRadius(pc.points_[i], radius, ref_indices, ref_distance2);
+        ExpectEQ(ref_indices, vector<int>(indices.begin() + offsets[i],
+                                          indices.begin() + offsets[i + 1]));
+        ExpectEQ(ref_distance2,
+                 vector<double>(distance2.begin() + offsets[i],
+                                distance2.begin() + offsets[i + 1]));
+    }
+}
+
+TEST(KDTreeFlann, BatchSearchHybrid) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    geometry::KDTreeFlann kdtree(pc);
+
+    int max_nn = 5;
+    double radius = 2.0;
+    vector<int> indices;
+    vector<double> distance2;
+    vector<int> counts;
+
+    int result = kdtree.BatchSearchHybrid(pc.points_, radius, max_nn, indices,
+                                          distance2, counts);
+
+    EXPECT_EQ(counts.size(), size_t(size));
+    EXPECT_EQ(indices.size(), size_t(size * max_nn));
+
+    int total = 0;
+    for (int i = 0; i < size; i++) {
+        vector<int> ref_indices;
+        vector<double> ref_distance2;
+        kdtree.SearchHybrid(pc.points_[i], radius, max_nn, ref_indices,
+                            ref_distance2);
+        EXPECT_EQ(counts[i], int(ref_indices.size()));
+        ExpectEQ(ref_indices,
+                 vector<int>(indices.begin() + i * max_nn,
+                             indices.begin() + i * max_nn + counts[i]));
+        ExpectEQ(ref_distance2,
+                 vector<double>(distance2.begin() + i * max_nn,
+                                distance2.begin() + i * max_nn + counts[i]));
+        for (int k = counts[i]; k < max_nn; k++) {
+            EXPECT_EQ(indices[i * max_nn + k], -1);
+        }
+        total += counts[i];
+    }
+    EXPECT_EQ(result, total);
+
+    // CSR output of the generic batch search.
+    vector<int> offsets;
+    vector<int> csr_indices;
+    vector<double> csr_distance2;
+    result = kdtree.BatchSearch(
+            pc.points_, geometry::KDTreeSearchParamHybrid(radius, max_nn),
+            offsets, csr_indices, csr_distance2);
+
+    EXPECT_EQ(result, total);
+    EXPECT_EQ(offsets.back(), total);
+    for (int i = 0; i < size; i++) {
+        EXPECT_EQ(offsets[i + 1] - offsets[i], counts[i]);
+        ExpectEQ(vector<int>(indices.begin() + i * max_nn,
+                             indices.begin() + i * max_nn + counts[i]),
+                 vector<int>(csr_indices.begin() + offsets[i],
+                             csr_indices.begin() + offsets[i + 1]));
+    }
+}
+
+TEST(KDTreeFlann, Float32) {
+    int size = 100;
+
+    geometry::PointCloud pc;
+
+    Vector3d vmin(0.0, 0.0, 0.0);
+    Vector3d vmax(10.0, 10.0, 10.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+
+    geometry::KDTreeFlann kdtree64(pc);
+    geometry::KDTreeFlann kdtree32(
+            pc, geometry::KDTreeFlann::Precision::Float32);
+    EXPECT_EQ(kdtree64.GetPrecision(),
+              geometry::KDTreeFlann::Precision::Float64);
+    EXPECT_EQ(kdtree32.GetPrecision(),
+              geometry::KDTreeFlann::Precision::Float32);
+
+    auto expect_near = [](const vector<double> &ref,
+                          const vector<double> &dist) {
+        EXPECT_EQ(ref.size(), dist.size());
+        for (size_t i = 0; i < (std::min)(ref.size(), dist.size()); i++) {
+            EXPECT_NEAR(ref[i], dist[i], 1e-5 * (1.0 + ref[i]));
+        }
+    };
+
+    int knn = 5;
+    double radius = 2.0;
+    for (int i = 0; i < size; i++) {
+        vector<int> ref_indices, indices;
+        vector<double> ref_distance2, distance2;
+
+        kdtree64.SearchKNN(pc.points_[i], knn, ref_indices, ref_distance2);
+        kdtree32.SearchKNN(pc.points_[i], knn, indices, distance2);
+        ExpectEQ(ref_indices, indices);
+        expect_near(ref_distance2, distance2);
+
+        kdtree64.SearchRadius(pc.points_[i], radius, ref_indices,
+                              ref_distance2);
+        kdtree32.SearchRadius(pc.points_[i], radius, indices, distance2);
+        ExpectEQ(ref_indices, indices);
+        expect_near(ref_distance2, distance2);
+
+        kdtree64.SearchHybrid(pc.points_[i], radius, knn, ref_indices,
+                              ref_distance2);
+        kdtree32.SearchHybrid(pc.points_[i], radius, knn, indices, distance2);
+        ExpectEQ(ref_indices, indices);
+        expect_near(ref_distance2, distance2);
+    }
+
+    vector<int> ref_indices, indices;
+    vector<double> ref_distance2, distance2;
+    EXPECT_EQ(kdtree64.BatchSearchKNN(pc.points_, knn, ref_indices,
+                                      ref_distance2),
+              kdtree32.BatchSearchKNN(pc.points_, knn, indices, distance2));
+    ExpectEQ(ref_indices, indices);
+    expect_near(ref_distance2, distance2);
+
+    vector<int> ref_offsets, offsets;
+    EXPECT_EQ(kdtree64.BatchSearchRadius(pc.points_, radius, ref_offsets,
+                                         ref_indices, ref_distance2),
+              kdtree32.BatchSearchRadius(pc.points_, radius, offsets, indices,
+                                         distance2));
+    ExpectEQ(ref_offsets, offsets);
+    ExpectEQ(ref_indices, indices);
+    expect_near(ref_distance2, distance2);
+}
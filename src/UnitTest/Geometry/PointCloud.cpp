@@ -24,7 +24,11 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <tuple>
 
 #include "Open3D/Camera/PinholeCameraIntrinsic.h"
 #include "Open3D/Geometry/BoundingVolume.h"
@@ -33,6 +37,10 @@
 #include "Open3D/Geometry/RGBDImage.h"
 #include "TestUtility/UnitTest.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace Eigen;
 using namespace open3d;
 using namespace std;
@@ -527,6 +535,57 @@ TEST(PointCloud, VoxelDownSample) {
     ExpectEQ(ref_colors, output_pc->colors_);
 }
 
+TEST(PointCloud, VoxelDownSampleAndTrace) {
+    // Large enough for the parallel sort to split the points into chunks.
+    size_t size = 50000;
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    Rand(pc.points_, Zero3d, Vector3d(10.0, 10.0, 10.0), 0);
+
+    double voxel_size = 1.0;
+    auto output = pc.VoxelDownSampleAndTrace(voxel_size, Zero3d,
+                                             Vector3d(10.0, 10.0, 10.0));
+    auto output_pc = get<0>(output);
+    const MatrixXi &cubic_id = get<1>(output);
+    const vector<vector<int>> &original_indices = get<2>(output);
+    ASSERT_EQ(output_pc->points_.size(), original_indices.size());
+    ASSERT_EQ(size_t(cubic_id.rows()), original_indices.size());
+
+    // Every point is traced once, to the voxel containing it, and the voxels
+    // are sorted by index.
+    auto voxel_of = [&](int i) {
+        return Vector3i(int(floor(pc.points_[i](0) / voxel_size)),
+                        int(floor(pc.points_[i](1) / voxel_size)),
+                        int(floor(pc.points_[i](2) / voxel_size)));
+    };
+    vector<int> num_traced(size, 0);
+    for (size_t v = 0; v < original_indices.size(); v++) {
+        const vector<int> &indices = original_indices[v];
+        ASSERT_FALSE(indices.empty());
+        const Vector3i voxel = voxel_of(indices[0]);
+        if (v > 0) {
+            const Vector3i prev_voxel = voxel_of(original_indices[v - 1][0]);
+            EXPECT_TRUE(lexicographical_compare(
+                    prev_voxel.data(), prev_voxel.data() + 3, voxel.data(),
+                    voxel.data() + 3));
+        }
+        Vector3d mean(0, 0, 0);
+        for (size_t j = 0; j < indices.size(); j++) {
+            EXPECT_TRUE(j == 0 || indices[j - 1] < indices[j]);
+            ExpectEQ(voxel_of(indices[j]), voxel);
+            num_traced[indices[j]]++;
+            mean += pc.points_[indices[j]];
+        }
+        ExpectEQ(output_pc->points_[v],
+                 Vector3d(mean / double(indices.size())));
+        for (int c = 0; c < 8; c++) {
+            EXPECT_TRUE(cubic_id(v, c) == -1 ||
+                        voxel_of(cubic_id(v, c)) == voxel);
+        }
+    }
+    EXPECT_EQ(count(num_traced.begin(), num_traced.end(), 1), int(size));
+}
+
 TEST(PointCloud, UniformDownSample) {
     vector<Vector3d> ref = {{839.215686, 392.156863, 780.392157},
                             {364.705882, 509.803922, 949.019608},
@@ -569,6 +628,98 @@ TEST(PointCloud, UniformDownSample) {
     ExpectEQ(ref, output_pc->points_);
 }
 
+TEST(PointCloud, RandomDownSample) {
+    geometry::PointCloud pc;
+    pc.points_.resize(1000);
+    pc.colors_.resize(1000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    Rand(pc.colors_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 1);
+
+    std::shared_ptr<geometry::PointCloud> output;
+    std::vector<size_t> indices;
+    std::tie(output, indices) = pc.RandomDownSample(100, 7);
+    EXPECT_EQ(100u, indices.size());
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_TRUE(std::adjacent_find(indices.begin(), indices.end()) ==
+                indices.end());
+    ASSERT_EQ(100u, output->points_.size());
+    ASSERT_EQ(100u, output->colors_.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        ExpectEQ(pc.points_[indices[i]], output->points_[i]);
+        ExpectEQ(pc.colors_[indices[i]], output->colors_[i]);
+    }
+
+    // The same seed selects the same points, another seed does not.
+    std::vector<size_t> same_seed = std::get<1>(pc.RandomDownSample(100, 7));
+    std::vector<size_t> other_seed = std::get<1>(pc.RandomDownSample(100, 8));
+    EXPECT_EQ(indices, same_seed);
+    EXPECT_NE(indices, other_seed);
+
+    std::vector<size_t> all(pc.points_.size());
+    std::iota(all.begin(), all.end(), 0);
+    EXPECT_EQ(all, std::get<1>(pc.RandomDownSample(pc.points_.size())));
+    EXPECT_TRUE(std::get<1>(pc.RandomDownSample(0)).empty());
+}
+
+TEST(PointCloud, FarthestPointDownSample) {
+    // Integer coordinates and duplicated points produce many equal
+    // distances, which exercises the tie breaking. The points fill several
+    // groups of buckets.
+    geometry::PointCloud pc;
+    pc.points_.resize(40000);
+    pc.normals_.resize(40000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(20.0, 20.0, 20.0), 0);
+    Rand(pc.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0), 1);
+    for (size_t i = 0; i < pc.points_.size(); i++) {
+        pc.points_[i] = pc.points_[i].array().round();
+    }
+    for (size_t i = 0; i < 2000; i++) {
+        pc.points_[20000 + i] = pc.points_[i];
+    }
+
+    // Brute force reference with the smallest index winning ties.
+    const size_t num_samples = 300;
+    const size_t start_index = 17;
+    std::vector<double> distance2(pc.points_.size(),
+                                  std::numeric_limits<double>::infinity());
+    std::vector<size_t> ref = {start_index};
+    while (ref.size() < num_samples) {
+        const Vector3d s = pc.points_[ref.back()];
+        distance2[ref.back()] = -1.0;
+        size_t farthest = 0;
+        for (size_t i = 0; i < pc.points_.size(); i++) {
+            distance2[i] = std::min(distance2[i],
+                                    (pc.points_[i] - s).squaredNorm());
+            if (distance2[i] > distance2[farthest]) {
+                farthest = i;
+            }
+        }
+        ref.push_back(farthest);
+    }
+
+    std::shared_ptr<geometry::PointCloud> output;
+    std::vector<size_t> indices;
+    std::tie(output, indices) =
+            pc.FarthestPointDownSample(num_samples, start_index);
+    EXPECT_EQ(ref, indices);
+    ASSERT_EQ(num_samples, output->points_.size());
+    ASSERT_EQ(num_samples, output->normals_.size());
+    for (size_t i = 0; i < indices.size(); i++) {
+        ExpectEQ(pc.points_[indices[i]], output->points_[i]);
+        ExpectEQ(pc.normals_[indices[i]], output->normals_[i]);
+    }
+
+    // Selecting every point visits each of them exactly once.
+    pc.points_.resize(1000);
+    pc.normals_.resize(1000);
+    indices = std::get<1>(pc.FarthestPointDownSample(pc.points_.size()));
+    EXPECT_EQ(0u, indices[0]);
+    std::sort(indices.begin(), indices.end());
+    std::vector<size_t> all(pc.points_.size());
+    std::iota(all.begin(), all.end(), 0);
+    EXPECT_EQ(all, indices);
+}
+
 TEST(PointCloud, CropPointCloud) {
     size_t size = 100;
     geometry::PointCloud pc;
@@ -588,6 +739,89 @@ TEST(PointCloud, CropPointCloud) {
     ExpectGE(maxBound, output_pc->points_);
 }
 
+TEST(PointCloud, CropAndTransform) {
+    // Several kernel blocks, so that the compaction crosses block borders.
+    size_t size = 10000;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    pc.normals_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(pc.colors_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 2);
+    for (size_t i = 0; i < size; i++) {
+        pc.covariances_.push_back(pc.normals_[i] * pc.normals_[i].transpose() +
+                                  Eigen::Matrix3d::Identity());
+    }
+
+    Eigen::Matrix4d transformation = Eigen::Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            geometry::Geometry3D::GetRotationMatrixFromXYZ({0.3, -0.2, 1.1});
+    transformation.block<3, 1>(0, 3) = Vector3d(1.0, -2.0, 3.0);
+
+    geometry::AxisAlignedBoundingBox aabb(Vector3d(2.0, 3.0, 1.0),
+                                          Vector3d(7.0, 8.0, 6.0));
+    geometry::OrientedBoundingBox obb(
+            Vector3d(5.0, 5.0, 5.0),
+            geometry::Geometry3D::GetRotationMatrixFromXYZ({0.5, 0.2, -0.4}),
+            Vector3d(6.0, 4.0, 3.0));
+
+    // Brute-force reference for the oriented box.
+    std::vector<size_t> obb_ref;
+    for (size_t i = 0; i < size; i++) {
+        Vector3d local = obb.R_.transpose() * (pc.points_[i] - obb.center_);
+        if ((local.cwiseAbs() - obb.extent_ / 2).maxCoeff() <= 0) {
+            obb_ref.push_back(i);
+        }
+    }
+    EXPECT_EQ(obb_ref, obb.GetPointIndicesWithinBoundingBox(pc.points_));
+    EXPECT_EQ(obb_ref.size(), pc.Crop(obb)->points_.size());
+
+    for (const Eigen::Matrix4d &T :
+         {transformation, Eigen::Matrix4d(transformation.transpose())}) {
+        auto ref_aabb = pc.Crop(aabb);
+        ref_aabb->Transform(T);
+        auto output_aabb = pc.CropAndTransform(aabb, T);
+        EXPECT_LT(0u, output_aabb->points_.size());
+        ExpectEQ(ref_aabb->points_, output_aabb->points_);
+        ExpectEQ(ref_aabb->normals_, output_aabb->normals_);
+        ExpectEQ(ref_aabb->colors_, output_aabb->colors_);
+        ExpectEQ(ref_aabb->covariances_, output_aabb->covariances_);
+
+        auto ref_obb = pc.Crop(obb);
+        ref_obb->Transform(T);
+        auto output_obb = pc.CropAndTransform(obb, T);
+        ExpectEQ(ref_obb->points_, output_obb->points_);
+        ExpectEQ(ref_obb->normals_, output_obb->normals_);
+        ExpectEQ(ref_obb->colors_, output_obb->colors_);
+    }
+}
+
+TEST(PointCloud, BoundsOfLargePointCloud) {
+    size_t size = 100000;
+    geometry::PointCloud pc;
+
+    pc.points_.resize(size);
+    Rand(pc.points_, Vector3d(-5.0, 0.0, 10.0), Vector3d(5.0, 20.0, 30.0), 0);
+
+    Vector3d min_bound = pc.points_[0];
+    Vector3d max_bound = pc.points_[0];
+    Vector3d sum(0.0, 0.0, 0.0);
+    for (const auto &point : pc.points_) {
+        min_bound = min_bound.cwiseMin(point);
+        max_bound = max_bound.cwiseMax(point);
+        sum += point;
+    }
+
+    ExpectEQ(min_bound, pc.GetMinBound());
+    ExpectEQ(max_bound, pc.GetMaxBound());
+    ExpectEQ(Vector3d(sum / double(size)), pc.GetCenter());
+    auto aabb = pc.GetAxisAlignedBoundingBox();
+    ExpectEQ(min_bound, aabb.min_bound_);
+    ExpectEQ(max_bound, aabb.max_bound_);
+}
+
 TEST(PointCloud, EstimateNormals) {
     vector<Vector3d> ref = {
             {0.282003, 0.866394, 0.412111},   {0.550791, 0.829572, -0.091869},
@@ -639,6 +873,63 @@ TEST(PointCloud, EstimateNormals) {
     ExpectEQ(ref, pc.normals_);
 }
 
+TEST(PointCloud, EstimateNormalsFloat32) {
+    // Points on a sphere, whose normals are well defined, unlike those of
+    // points spread in a volume.
+    size_t size = 1000;
+    geometry::PointCloud pc;
+
+    Vector3d vmin(-1.0, -1.0, -1.0);
+    Vector3d vmax(1.0, 1.0, 1.0);
+
+    pc.points_.resize(size);
+    Rand(pc.points_, vmin, vmax, 0);
+    for (auto &point : pc.points_) {
+        point = 100.0 * point.normalized();
+    }
+
+    geometry::PointCloud pc32 = pc;
+    pc.EstimateNormals(geometry::KDTreeSearchParamKNN(), false);
+    pc32.EstimateNormals(geometry::KDTreeSearchParamKNN(), false,
+                         geometry::KDTreeFlann::Precision::Float32);
+    ASSERT_EQ(pc.normals_.size(), pc32.normals_.size());
+    for (size_t idx = 0; idx < size; ++idx) {
+        EXPECT_NEAR(std::abs(pc.normals_[idx].dot(pc32.normals_[idx])), 1.0,
+                    1e-4);
+    }
+}
+
+TEST(PointCloud, EstimateCovariances) {
+    geometry::PointCloud pc;
+    pc.points_.resize(500);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 0.0), 0);
+
+    EXPECT_TRUE(pc.EstimateCovariances(geometry::KDTreeSearchParamKNN(10)));
+    EXPECT_TRUE(pc.HasCovariances());
+    for (const auto &covariance : pc.covariances_) {
+        // Points on the plane z = 0 do not vary along z.
+        EXPECT_NEAR(covariance.col(2).norm(), 0.0, 1e-12);
+        EXPECT_GT(covariance(0, 0), 0.0);
+        EXPECT_GT(covariance(1, 1), 0.0);
+    }
+
+    Matrix3d R = AngleAxisd(0.5, Vector3d(1.0, 2.0, 3.0).normalized())
+                         .toRotationMatrix();
+    geometry::PointCloud rotated = pc;
+    rotated.Rotate(R, false);
+    for (size_t i = 0; i < pc.points_.size(); i++) {
+        ExpectEQ(Matrix3d(R * pc.covariances_[i] * R.transpose()),
+                 rotated.covariances_[i]);
+    }
+
+    auto selected = pc.SelectByIndex({1, 3, 5});
+    EXPECT_EQ(selected->covariances_.size(), size_t(3));
+    ExpectEQ(pc.covariances_[3], selected->covariances_[1]);
+
+    geometry::PointCloud empty;
+    EXPECT_FALSE(empty.EstimateCovariances());
+}
+
 TEST(PointCloud, OrientNormalsToAlignWithDirection) {
     vector<Vector3d> ref = {
             {0.282003, 0.866394, 0.412111},   {0.550791, 0.829572, -0.091869},
@@ -1057,6 +1348,66 @@ TEST(PointCloud, CreatePointCloudFromRGBDImage_1_4) {
                                        ref_colors);
 }
 
+TEST(PointCloud, ClusterDBSCAN) {
+    // Three dense blobs in uniform noise.
+    geometry::PointCloud pc;
+    vector<Vector3d> blob(400);
+    for (int b = 0; b < 3; b++) {
+        const Vector3d corner(100.0 * b, 50.0, 300.0 - 100.0 * b);
+        Rand(blob, corner, corner + Vector3d(30.0, 30.0, 30.0), b);
+        pc.points_.insert(pc.points_.end(), blob.begin(), blob.end());
+    }
+    vector<Vector3d> noise(300);
+    Rand(noise, Zero3d, Vector3d(400.0, 400.0, 400.0), 3);
+    pc.points_.insert(pc.points_.end(), noise.begin(), noise.end());
+
+    const double eps = 6.0;
+    const size_t min_points = 5;
+    vector<int> labels = pc.ClusterDBSCAN(eps, min_points);
+
+    // Reference: the serial breadth-first DBSCAN with brute force
+    // neighbourhoods.
+    const int num_points = int(pc.points_.size());
+    vector<vector<int>> nbs(num_points);
+    for (int i = 0; i < num_points; i++) {
+        for (int j = 0; j < num_points; j++) {
+            if ((pc.points_[i] - pc.points_[j]).norm() <= eps) {
+                nbs[i].push_back(j);
+            }
+        }
+    }
+    vector<int> ref_labels(num_points, -2);
+    int num_clusters = 0;
+    for (int i = 0; i < num_points; i++) {
+        if (ref_labels[i] != -2) {
+            continue;
+        }
+        if (nbs[i].size() < min_points) {
+            ref_labels[i] = -1;
+            continue;
+        }
+        vector<int> queue(1, i);
+        ref_labels[i] = num_clusters;
+        for (size_t q = 0; q < queue.size(); q++) {
+            if (nbs[queue[q]].size() < min_points) {
+                continue;
+            }
+            for (int nb : nbs[queue[q]]) {
+                if (ref_labels[nb] < 0) {
+                    if (ref_labels[nb] == -2) {
+                        queue.push_back(nb);
+                    }
+                    ref_labels[nb] = num_clusters;
+                }
+            }
+        }
+        num_clusters++;
+    }
+
+    EXPECT_GE(num_clusters, 3);
+    EXPECT_TRUE(labels == ref_labels);
+}
+
 TEST(PointCloud, SegmentPlane) {
     // Points sampled from the plane x + y + z + 1 = 0
     vector<Vector3d> ref = {{1.0, 1.0, -3.0},
@@ -1078,3 +1429,78 @@ TEST(PointCloud, SegmentPlane) {
 
     ExpectEQ(ref, output_pc->points_);
 }
+
+TEST(PointCloud, SegmentPlaneSeed) {
+    // Points sampled from the plane z = 0, and as many points of noise.
+    geometry::PointCloud pc;
+    vector<Vector3d> points(500);
+    Rand(points, Zero3d, Vector3d(10.0, 10.0, 0.0), 0);
+    pc.points_.insert(pc.points_.end(), points.begin(), points.end());
+    Rand(points, Vector3d(0.0, 0.0, 0.5), Vector3d(10.0, 10.0, 10.0), 1);
+    pc.points_.insert(pc.points_.end(), points.begin(), points.end());
+
+    // The same seed gives the same inliers for any number of threads.
+    Vector4d plane_model;
+    vector<size_t> inliers;
+    vector<Vector4d> plane_models;
+    vector<vector<size_t>> plane_inliers;
+#ifdef _OPENMP
+    const int max_threads = omp_get_max_threads();
+    omp_set_num_threads(1);
+#endif
+    tie(plane_model, inliers) = pc.SegmentPlane(0.1, 3, 1000, 0.99, 7);
+    tie(plane_models, plane_inliers) =
+            pc.SegmentPlanes(2, 0.1, 3, 1000, 3, 0.99, 7);
+    EXPECT_GE(inliers.size(), 500u);
+    for (int num_threads : {2, 3, 8}) {
+#ifdef _OPENMP
+        omp_set_num_threads(num_threads);
+#endif
+        Vector4d plane_model_threads;
+        vector<size_t> inliers_threads;
+        tie(plane_model_threads, inliers_threads) =
+                pc.SegmentPlane(0.1, 3, 1000, 0.99, 7);
+        EXPECT_TRUE(inliers_threads == inliers) << num_threads;
+        ExpectEQ(plane_model_threads, plane_model);
+
+        vector<Vector4d> plane_models_threads;
+        vector<vector<size_t>> plane_inliers_threads;
+        tie(plane_models_threads, plane_inliers_threads) =
+                pc.SegmentPlanes(2, 0.1, 3, 1000, 3, 0.99, 7);
+        EXPECT_TRUE(plane_inliers_threads == plane_inliers) << num_threads;
+    }
+#ifdef _OPENMP
+    omp_set_num_threads(max_threads);
+#endif
+}
+
+TEST(PointCloud, SegmentPlanes) {
+    // Points sampled from the planes z = 0 and x = 20, and noise far from
+    // both.
+    geometry::PointCloud pc;
+    vector<Vector3d> points(500);
+    Rand(points, Zero3d, Vector3d(10.0, 10.0, 0.0), 0);
+    pc.points_.insert(pc.points_.end(), points.begin(), points.end());
+    points.resize(300);
+    Rand(points, Vector3d(20.0, 1.0, 1.0), Vector3d(20.0, 10.0, 10.0), 1);
+    pc.points_.insert(pc.points_.end(), points.begin(), points.end());
+    points.resize(50);
+    Rand(points, Vector3d(30.0, 30.0, 30.0), Vector3d(40.0, 40.0, 40.0), 2);
+    pc.points_.insert(pc.points_.end(), points.begin(), points.end());
+
+    vector<Vector4d> plane_models;
+    vector<vector<size_t>> inliers;
+    tie(plane_models, inliers) = pc.SegmentPlanes(3, 0.01, 3, 100, 60);
+
+    // The noise is too sparse for a third plane.
+    ASSERT_EQ(plane_models.size(), 2u);
+    ASSERT_EQ(inliers.size(), 2u);
+    ExpectEQ(Vector4d(plane_models[0].cwiseAbs()), Vector4d(0, 0, 1, 0));
+    ExpectEQ(Vector4d(plane_models[1].cwiseAbs()), Vector4d(1, 0, 0, 20));
+    vector<size_t> ref_inliers0(500);
+    iota(ref_inliers0.begin(), ref_inliers0.end(), 0);
+    vector<size_t> ref_inliers1(300);
+    iota(ref_inliers1.begin(), ref_inliers1.end(), 500);
+    EXPECT_TRUE(inliers[0] == ref_inliers0);
+    EXPECT_TRUE(inliers[1] == ref_inliers1);
+}
@@ -0,0 +1,188 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Geometry/SoAPointCloud.h"
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+geometry::PointCloud CreateRandomPointCloud(size_t size) {
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    pc.normals_.resize(size);
+    pc.colors_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0), 1);
+    Rand(pc.colors_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 2);
+    return pc;
+}
+
+}  // unnamed namespace
+
+TEST(SoAPointCloud, Constructor) {
+    geometry::SoAPointCloud<float> pc;
+
+    EXPECT_EQ(0u, pc.Size());
+    EXPECT_TRUE(pc.IsEmpty());
+    EXPECT_FALSE(pc.HasNormals());
+    EXPECT_FALSE(pc.HasColors());
+    EXPECT_TRUE(pc.GetAttributeNames().empty());
+}
+
+TEST(SoAPointCloud, ConvertPointCloud) {
+    size_t size = 1000;
+    geometry::PointCloud pc = CreateRandomPointCloud(size);
+
+    geometry::SoAPointCloud<double> pc_double(pc);
+    EXPECT_EQ(size, pc_double.Size());
+    EXPECT_TRUE(pc_double.HasNormals());
+    EXPECT_TRUE(pc_double.HasColors());
+    for (size_t i = 0; i < size; i++) {
+        ExpectEQ(pc.points_[i], Vector3d(pc_double.GetPoints().col(i)));
+        ExpectEQ(pc.normals_[i], Vector3d(pc_double.GetNormals().col(i)));
+        ExpectEQ(pc.colors_[i], Vector3d(pc_double.GetColors().col(i)));
+    }
+    auto output = pc_double.ToPointCloud();
+    ExpectEQ(pc.points_, output->points_);
+    ExpectEQ(pc.normals_, output->normals_);
+    ExpectEQ(pc.colors_, output->colors_);
+
+    // Half the memory, within single precision of the original.
+    geometry::SoAPointCloud<float> pc_float(pc);
+    EXPECT_EQ(size * 3 * sizeof(float),
+              pc_float.points_.size() * sizeof(pc_float.points_[0]));
+    output = pc_float.ToPointCloud();
+    ExpectEQ(pc.points_, output->points_, 1e-5);
+    ExpectEQ(pc.normals_, output->normals_, 1e-6);
+    ExpectEQ(pc.colors_, output->colors_, 1e-6);
+
+    // Missing attributes stay missing.
+    pc.normals_.clear();
+    pc.colors_.clear();
+    geometry::SoAPointCloud<float> pc_points(pc);
+    EXPECT_FALSE(pc_points.HasNormals());
+    EXPECT_FALSE(pc_points.HasColors());
+    EXPECT_FALSE(pc_points.ToPointCloud()->HasNormals());
+}
+
+TEST(SoAPointCloud, Attributes) {
+    geometry::SoAPointCloud<float> pc;
+    pc.Resize(10);
+    EXPECT_EQ(30u, pc.points_.size());
+    EXPECT_FALSE(pc.HasNormals());
+
+    auto intensity = pc.AddAttribute("intensity");
+    EXPECT_EQ(1, intensity.rows());
+    EXPECT_EQ(10, intensity.cols());
+    for (int i = 0; i < 10; i++) {
+        intensity(0, i) = float(i);
+    }
+    auto feature = pc.AddAttribute("feature", 4);
+    EXPECT_EQ(4, feature.rows());
+    EXPECT_EQ(10, feature.cols());
+    feature.setOnes();
+
+    // Adding an existing attribute keeps it, unless the channels differ.
+    EXPECT_EQ(intensity.data(), pc.AddAttribute("intensity").data());
+    EXPECT_EQ(9.0f, pc.GetAttribute("intensity")(0, 9));
+    EXPECT_ANY_THROW(pc.AddAttribute("feature", 3));
+
+    EXPECT_TRUE(pc.HasAttribute("intensity"));
+    EXPECT_FALSE(pc.HasAttribute("label"));
+    EXPECT_EQ(4, pc.GetAttributeChannels("feature"));
+    EXPECT_EQ(vector<string>({"feature", "intensity"}),
+              pc.GetAttributeNames());
+
+    // Resizing keeps the values and zero-fills the new points.
+    pc.Resize(20);
+    EXPECT_EQ(20u, pc.Size());
+    EXPECT_EQ(20, pc.GetAttribute("intensity").cols());
+    EXPECT_EQ(80, pc.GetAttribute("feature").size());
+    EXPECT_EQ(9.0f, pc.GetAttribute("intensity")(0, 9));
+    EXPECT_EQ(0.0f, pc.GetAttribute("intensity")(0, 10));
+    EXPECT_EQ(1.0f, pc.GetAttribute("feature")(3, 9));
+    EXPECT_EQ(0.0f, pc.GetAttribute("feature")(0, 10));
+
+    EXPECT_TRUE(pc.RemoveAttribute("feature"));
+    EXPECT_FALSE(pc.RemoveAttribute("feature"));
+    EXPECT_EQ(vector<string>({"intensity"}), pc.GetAttributeNames());
+    EXPECT_ANY_THROW(pc.GetAttribute("feature"));
+
+    pc.Clear();
+    EXPECT_TRUE(pc.IsEmpty());
+    EXPECT_TRUE(pc.GetAttributeNames().empty());
+}
+
+TEST(SoAPointCloud, Transform) {
+    geometry::PointCloud pc = CreateRandomPointCloud(1000);
+    geometry::SoAPointCloud<double> pc_double(pc);
+
+    Matrix4d transformation;
+    transformation << 0.10, 0.20, 0.30, 0.40, 0.50, 0.60, 0.70, 0.80, 0.90,
+            0.10, 0.20, 0.30, 0.00, 0.00, 0.00, 1.00;
+    pc.Transform(transformation);
+    pc_double.Transform(transformation);
+
+    auto output = pc_double.ToPointCloud();
+    ExpectEQ(pc.points_, output->points_);
+    ExpectEQ(pc.normals_, output->normals_);
+    ExpectEQ(pc.colors_, output->colors_);
+}
+
+TEST(SoAPointCloud, KDTreeFlann) {
+    geometry::PointCloud pc = CreateRandomPointCloud(1000);
+    geometry::SoAPointCloud<float> pc_float(pc);
+
+    // The single precision index is built on the point buffer itself.
+    geometry::KDTreeFlann kdtree(geometry::KDTreeFlann::Precision::Float32);
+    EXPECT_TRUE(kdtree.SetSoAPointCloud(pc_float));
+    // The double precision index keeps its own converted copy.
+    geometry::KDTreeFlann kdtree_double;
+    EXPECT_TRUE(kdtree_double.SetSoAPointCloud(pc_float));
+    geometry::KDTreeFlann kdtree_ref(*pc_float.ToPointCloud());
+
+    Vector3d query(5.0, 5.0, 5.0);
+    vector<int> indices, indices_double, indices_ref;
+    vector<double> distance2, distance2_double, distance2_ref;
+    EXPECT_EQ(30, kdtree.SearchKNN(query, 30, indices, distance2));
+    EXPECT_EQ(30, kdtree_double.SearchKNN(query, 30, indices_double,
+                                          distance2_double));
+    EXPECT_EQ(30, kdtree_ref.SearchKNN(query, 30, indices_ref, distance2_ref));
+    EXPECT_EQ(indices_ref, indices);
+    EXPECT_EQ(indices_ref, indices_double);
+    ExpectEQ(distance2_ref, distance2, 1e-4);
+    ExpectEQ(distance2_ref, distance2_double);
+
+    geometry::SoAPointCloud<float> empty;
+    EXPECT_FALSE(kdtree.SetSoAPointCloud(empty));
+}
@@ -0,0 +1,152 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/IO/ClassIO/SoAPointCloudIO.h"
+
+#include <cstdio>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+geometry::SoAPointCloud<float> CreateSoAPointCloud() {
+    geometry::PointCloud pc;
+    pc.points_.resize(100);
+    pc.normals_.resize(100);
+    pc.colors_.resize(100);
+    Rand(pc.points_, Eigen::Vector3d(-10.0, -10.0, -10.0),
+         Eigen::Vector3d(10.0, 10.0, 10.0), 0);
+    Rand(pc.normals_, Eigen::Vector3d(-1.0, -1.0, -1.0),
+         Eigen::Vector3d(1.0, 1.0, 1.0), 1);
+    // Colors that survive the conversion to 8 bits.
+    for (size_t i = 0; i < pc.colors_.size(); i++) {
+        pc.colors_[i] = Eigen::Vector3d(i % 256, (3 * i) % 256, 7) / 255.0;
+    }
+    geometry::SoAPointCloud<float> soa(pc);
+    auto intensity = soa.AddAttribute("intensity");
+    auto feature = soa.AddAttribute("feature", 3);
+    for (int i = 0; i < 100; i++) {
+        intensity(0, i) = 0.5f * i;
+        feature.col(i) = Eigen::Vector3f(float(i), -1.0f, 0.25f);
+    }
+    return soa;
+}
+
+template <typename Scalar>
+void ExpectSoAPointCloudEQ(const geometry::SoAPointCloud<float> &src,
+                           const geometry::SoAPointCloud<Scalar> &dst,
+                           double threshold) {
+    ASSERT_EQ(src.Size(), dst.Size());
+    ASSERT_EQ(src.GetAttributeNames(), dst.GetAttributeNames());
+    ExpectEQ(Eigen::MatrixXd(src.GetPoints().template cast<double>()),
+             Eigen::MatrixXd(dst.GetPoints().template cast<double>()),
+             threshold);
+    ExpectEQ(Eigen::MatrixXd(src.GetNormals().template cast<double>()),
+             Eigen::MatrixXd(dst.GetNormals().template cast<double>()),
+             threshold);
+    ExpectEQ(Eigen::MatrixXd(src.GetColors().template cast<double>()),
+             Eigen::MatrixXd(dst.GetColors().template cast<double>()),
+             threshold);
+    for (const auto &name : src.GetAttributeNames()) {
+        Eigen::MatrixXd src_attribute =
+                src.GetAttribute(name).template cast<double>();
+        Eigen::MatrixXd dst_attribute =
+                dst.GetAttribute(name).template cast<double>();
+        ExpectEQ(src_attribute, dst_attribute, threshold);
+    }
+}
+
+}  // unnamed namespace
+
+TEST(SoAPointCloudIO, PLYWriteRead) {
+    auto src = CreateSoAPointCloud();
+    std::string file_name =
+            std::string(TEST_DATA_DIR) + "/temp_soa_point_cloud.ply";
+
+    for (bool write_ascii : {false, true}) {
+        // ASCII files only keep 6 significant digits.
+        double threshold = write_ascii ? 1e-4 : THRESHOLD_1E_6;
+        EXPECT_TRUE(io::WriteSoAPointCloud(file_name, src, write_ascii));
+
+        geometry::SoAPointCloud<float> dst_float;
+        EXPECT_TRUE(io::ReadSoAPointCloud(file_name, dst_float));
+        ExpectSoAPointCloudEQ(src, dst_float, threshold);
+        EXPECT_EQ(3, dst_float.GetAttributeChannels("feature"));
+
+        geometry::SoAPointCloud<double> dst_double;
+        EXPECT_TRUE(io::ReadSoAPointCloud(file_name, dst_double));
+        ExpectSoAPointCloudEQ(src, dst_double, threshold);
+    }
+    EXPECT_EQ(std::remove(file_name.c_str()), 0);
+}
+
+TEST(SoAPointCloudIO, PLYReadChannelNameCollision) {
+    std::string file_name =
+            std::string(TEST_DATA_DIR) + "/temp_soa_point_cloud_collision.ply";
+    FILE *file = fopen(file_name.c_str(), "w");
+    ASSERT_NE(file, nullptr);
+    // "feature" collides with the attribute feature_0 and feature_1 would
+    // form, so all three must be read as attributes of their own.
+    fprintf(file,
+            "ply\n"
+            "format ascii 1.0\n"
+            "element vertex 2\n"
+            "property float x\n"
+            "property float y\n"
+            "property float z\n"
+            "property float feature\n"
+            "property float feature_0\n"
+            "property float feature_1\n"
+            "property float label_0\n"
+            "property float label_1\n"
+            "end_header\n"
+            "0 1 2 3 4 5 6 7\n"
+            "8 9 10 11 12 13 14 15\n");
+    fclose(file);
+
+    geometry::SoAPointCloud<float> pc;
+    EXPECT_TRUE(io::ReadSoAPointCloud(file_name, pc));
+    ASSERT_EQ(2u, pc.Size());
+    EXPECT_EQ(std::vector<std::string>(
+                      {"feature", "feature_0", "feature_1", "label"}),
+              pc.GetAttributeNames());
+    for (int i = 0; i < 2; i++) {
+        const float base = 8.0f * i;
+        ExpectEQ(Eigen::Vector3d(base, base + 1, base + 2),
+                 Eigen::Vector3d(pc.GetPoints().col(i).cast<double>()));
+        EXPECT_EQ(base + 3, pc.GetAttribute("feature")(0, i));
+        EXPECT_EQ(base + 4, pc.GetAttribute("feature_0")(0, i));
+        EXPECT_EQ(base + 5, pc.GetAttribute("feature_1")(0, i));
+        EXPECT_EQ(2, pc.GetAttributeChannels("label"));
+        EXPECT_EQ(base + 6, pc.GetAttribute("label")(0, i));
+        EXPECT_EQ(base + 7, pc.GetAttribute("label")(1, i));
+    }
+    EXPECT_EQ(std::remove(file_name.c_str()), 0);
+}
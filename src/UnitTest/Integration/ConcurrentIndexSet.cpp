@@ -0,0 +1,86 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/ConcurrentIndexSet.h"
+#include "TestUtility/UnitTest.h"
+
+#include <algorithm>
+
+using namespace open3d;
+using namespace unit_test;
+
+TEST(ConcurrentIndexSet, Insert) {
+    // Every index is inserted by several iterations, possibly on different
+    // threads, and is stored once.
+    const int size = 8;
+    integration::ConcurrentIndexSet index_set(size * size * size);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < 4 * size * size * size; i++) {
+        const int n = i % (size * size * size);
+        EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(
+                n % size - size / 2, (n / size) % size - size / 2,
+                n / (size * size) - size / 2)));
+    }
+    auto indices = index_set.GetIndices();
+    EXPECT_EQ(indices.size(), size_t(size * size * size));
+    std::sort(indices.begin(), indices.end(),
+              [](const Eigen::Vector3i &a, const Eigen::Vector3i &b) {
+                  return std::lexicographical_compare(a.data(), a.data() + 3,
+                                                      b.data(), b.data() + 3);
+              });
+    ExpectEQ(indices.front(), Eigen::Vector3i(-4, -4, -4));
+    ExpectEQ(indices.back(), Eigen::Vector3i(3, 3, 3));
+    EXPECT_TRUE(std::unique(indices.begin(), indices.end()) == indices.end());
+}
+
+TEST(ConcurrentIndexSet, Full) {
+    integration::ConcurrentIndexSet index_set(1);
+    EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(0, 0, 0)));
+    EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(-1, 2, 1 << 19)));
+    EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(0, 0, 0)));
+    EXPECT_FALSE(index_set.Insert(Eigen::Vector3i(5, 5, 5)));
+    EXPECT_EQ(index_set.GetIndices().size(), 2u);
+}
+
+TEST(ConcurrentIndexSet, ExtractIndicesReset) {
+    // An empty set has room for a single index.
+    integration::ConcurrentIndexSet index_set;
+    EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(0, 0, 0)));
+    EXPECT_FALSE(index_set.Insert(Eigen::Vector3i(1, 0, 0)));
+    index_set.Reset(4);
+    EXPECT_GE(index_set.GetMaxSize(), 4u);
+    EXPECT_TRUE(index_set.GetIndices().empty());
+    EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(0, 0, 0)));
+    EXPECT_TRUE(index_set.Insert(Eigen::Vector3i(1, 0, 0)));
+    EXPECT_EQ(index_set.ExtractIndices().size(), 2u);
+    EXPECT_TRUE(index_set.GetIndices().empty());
+
+    // A smaller size keeps the table.
+    index_set.Reset(1);
+    EXPECT_GE(index_set.GetMaxSize(), 4u);
+}
@@ -24,8 +24,62 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Integration/ScalableTSDFVolume.h"
+#include "Open3D/Camera/PinholeCameraTrajectory.h"
+#include "Open3D/Geometry/RGBDImage.h"
+#include "Open3D/IO/ClassIO/ImageIO.h"
+#include "Open3D/IO/ClassIO/PinholeCameraTrajectoryIO.h"
+#include "Open3D/Utility/FileSystem.h"
 #include "TestUtility/UnitTest.h"
 
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+using namespace open3d;
+using namespace unit_test;
+
+namespace {
+
+// Reads frame i of the RGBD test sequence.
+std::shared_ptr<geometry::RGBDImage> ReadTestFrame(size_t i) {
+    geometry::Image im_color;
+    std::ostringstream im_color_path;
+    im_color_path << TEST_DATA_DIR << "/RGBD/color/" << std::setfill('0')
+                  << std::setw(5) << i << ".jpg";
+    io::ReadImage(im_color_path.str(), im_color);
+
+    geometry::Image im_depth;
+    std::ostringstream im_depth_path;
+    im_depth_path << TEST_DATA_DIR << "/RGBD/depth/" << std::setfill('0')
+                  << std::setw(5) << i << ".png";
+    io::ReadImage(im_depth_path.str(), im_depth);
+
+    return geometry::RGBDImage::CreateFromColorAndDepth(
+            im_color, im_depth, /*depth_scale*/ 1000.0,
+            /*depth_func*/ 4.0, /*convert_rgb_to_intensity*/ false);
+}
+
+// Integrates the frames [first_frame, end) of the RGBD test sequence into
+// volume.
+void IntegrateTestSequence(integration::TSDFVolume &volume,
+                           size_t first_frame = 0) {
+    camera::PinholeCameraTrajectory trajectory;
+    ASSERT_TRUE(io::ReadPinholeCameraTrajectory(
+            std::string(TEST_DATA_DIR) + "/RGBD/odometry.log", trajectory));
+    camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    for (size_t i = first_frame; i < trajectory.parameters_.size(); ++i) {
+        volume.Integrate(*ReadTestFrame(i), intrinsic,
+                         trajectory.parameters_[i].extrinsic_);
+    }
+}
+
+}  // unnamed namespace
+
 TEST(ScalableTSDFVolume, DISABLED_VolumeUnit) { unit_test::NotImplemented(); }
 
 TEST(ScalableTSDFVolume, DISABLED_Constructor) { unit_test::NotImplemented(); }
@@ -36,7 +90,75 @@ TEST(ScalableTSDFVolume, DISABLED_MemberData) { unit_test::NotImplemented(); }
 
 TEST(ScalableTSDFVolume, DISABLED_Reset) { unit_test::NotImplemented(); }
 
-TEST(ScalableTSDFVolume, DISABLED_Integrate) { unit_test::NotImplemented(); }
+TEST(ScalableTSDFVolume, Integrate) {
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    IntegrateTestSequence(tsdf_volume);
+
+    // These hard-coded values are for unit test only. They are used to make
+    // sure that after code refactoring, the numerical values still stay the
+    // same.
+    EXPECT_EQ(tsdf_volume.volume_units_.size(), 855u);
+
+    std::shared_ptr<geometry::TriangleMesh> mesh =
+            tsdf_volume.ExtractTriangleMesh();
+    EXPECT_EQ(mesh->vertices_.size(), 146627u);
+    EXPECT_EQ(mesh->triangles_.size(), 278898u);
+    Eigen::Vector3d color_sum(0, 0, 0);
+    for (const Eigen::Vector3d &color : mesh->vertex_colors_) {
+        color_sum += color;
+    }
+    ExpectEQ(color_sum,
+             Eigen::Vector3d(123544.925147, 114671.946540, 109856.311690),
+             /*threshold*/ 0.1);
+
+    std::shared_ptr<geometry::PointCloud> pcd = tsdf_volume.ExtractPointCloud();
+    EXPECT_EQ(pcd->points_.size(), 139913u);
+    Eigen::Vector3d normal_sum(0, 0, 0);
+    for (const Eigen::Vector3d &normal : pcd->normals_) {
+        normal_sum += normal;
+    }
+    ExpectEQ(normal_sum,
+             Eigen::Vector3d(463.582170, -38659.147422, -70848.712599),
+             /*threshold*/ 0.1);
+}
+
+TEST(ScalableTSDFVolume, IntegrateSequence) {
+    camera::PinholeCameraTrajectory trajectory;
+    ASSERT_TRUE(io::ReadPinholeCameraTrajectory(
+            std::string(TEST_DATA_DIR) + "/RGBD/odometry.log", trajectory));
+    for (auto &parameters : trajectory.parameters_) {
+        parameters.intrinsic_ = camera::PinholeCameraIntrinsic(
+                camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    }
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    tsdf_volume.IntegrateSequence(ReadTestFrame, trajectory);
+
+    // Same values as the frame by frame integration.
+    EXPECT_EQ(tsdf_volume.volume_units_.size(), 855u);
+    std::shared_ptr<geometry::TriangleMesh> mesh =
+            tsdf_volume.ExtractTriangleMesh();
+    EXPECT_EQ(mesh->vertices_.size(), 146627u);
+    EXPECT_EQ(mesh->triangles_.size(), 278898u);
+
+    // Missing frames are skipped.
+    integration::ScalableTSDFVolume tsdf_volume_skipped(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    tsdf_volume_skipped.IntegrateSequence(
+            [](size_t i) {
+                return i == 0 ? ReadTestFrame(i)
+                              : std::shared_ptr<geometry::RGBDImage>();
+            },
+            trajectory);
+    integration::ScalableTSDFVolume tsdf_volume_first(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    tsdf_volume_first.Integrate(*ReadTestFrame(0),
+                                trajectory.parameters_[0].intrinsic_,
+                                trajectory.parameters_[0].extrinsic_);
+    EXPECT_EQ(tsdf_volume_skipped.volume_units_.size(),
+              tsdf_volume_first.volume_units_.size());
+}
 
 TEST(ScalableTSDFVolume, DISABLED_ExtractPointCloud) {
     unit_test::NotImplemented();
@@ -50,6 +172,226 @@ TEST(ScalableTSDFVolume, DISABLED_ExtractVoxelPointCloud) {
     unit_test::NotImplemented();
 }
 
+TEST(ScalableTSDFVolume, ExtractDirtyTriangleMeshes) {
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    IntegrateTestSequence(tsdf_volume);
+
+    // Every cube belongs to exactly one unit, so the unit meshes hold the
+    // triangles of the full mesh.
+    auto meshes = tsdf_volume.ExtractDirtyTriangleMeshes();
+    EXPECT_EQ(meshes.size(), tsdf_volume.volume_units_.size());
+    std::unordered_map<Eigen::Vector3i, size_t,
+                       utility::hash_eigen::hash<Eigen::Vector3i>>
+            num_triangles;
+    for (size_t i = 0; i < meshes.size(); i++) {
+        if (i > 0) {
+            EXPECT_TRUE(std::lexicographical_compare(
+                    meshes[i - 1].first.data(), meshes[i - 1].first.data() + 3,
+                    meshes[i].first.data(), meshes[i].first.data() + 3));
+        }
+        num_triangles[meshes[i].first] = meshes[i].second->triangles_.size();
+    }
+    size_t total = 0;
+    for (const auto &unit : num_triangles) {
+        total += unit.second;
+    }
+    EXPECT_EQ(total, tsdf_volume.ExtractTriangleMesh()->triangles_.size());
+    EXPECT_TRUE(tsdf_volume.ExtractDirtyTriangleMeshes().empty());
+
+    // Integrating the last frame again only re-meshes part of the volume,
+    // and patching the previous unit meshes gives the full mesh again.
+    IntegrateTestSequence(tsdf_volume, 4);
+    meshes = tsdf_volume.ExtractDirtyTriangleMeshes();
+    EXPECT_GT(meshes.size(), 0u);
+    EXPECT_LT(meshes.size(), tsdf_volume.volume_units_.size());
+    for (const auto &unit_mesh : meshes) {
+        num_triangles[unit_mesh.first] = unit_mesh.second->triangles_.size();
+    }
+    total = 0;
+    for (const auto &unit : num_triangles) {
+        total += unit.second;
+    }
+    EXPECT_EQ(total, tsdf_volume.ExtractTriangleMesh()->triangles_.size());
+
+    tsdf_volume.Reset();
+    EXPECT_TRUE(tsdf_volume.ExtractDirtyTriangleMeshes().empty());
+}
+
+TEST(ScalableTSDFVolume, Raycast) {
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    IntegrateTestSequence(tsdf_volume);
+
+    // The surface rendered from the first camera matches its depth image.
+    camera::PinholeCameraTrajectory trajectory;
+    ASSERT_TRUE(io::ReadPinholeCameraTrajectory(
+            std::string(TEST_DATA_DIR) + "/RGBD/odometry.log", trajectory));
+    camera::PinholeCameraIntrinsic intrinsic(
+            camera::PinholeCameraIntrinsicParameters::PrimeSenseDefault);
+    geometry::Image im_depth;
+    io::ReadImage(std::string(TEST_DATA_DIR) + "/RGBD/depth/00000.png",
+                  im_depth);
+    auto depth = im_depth.ConvertDepthToFloatImage(/*depth_scale*/ 1000.0,
+                                                   /*depth_trunc*/ 4.0);
+    auto result =
+            tsdf_volume.Raycast(intrinsic, trajectory.parameters_[0].extrinsic_,
+                                /*depth_min*/ 0.1, /*depth_max*/ 4.0);
+    EXPECT_EQ(result->color_.num_of_channels_, 3);
+
+    int num_valid = 0;
+    int num_hits = 0;
+    double error_sum = 0.0;
+    for (int v = 0; v < intrinsic.height_; v++) {
+        for (int u = 0; u < intrinsic.width_; u++) {
+            float d = *depth->PointerAt<float>(u, v);
+            float d_raycast = *result->depth_.PointerAt<float>(u, v);
+            if (d <= 0.0f) {
+                continue;
+            }
+            num_valid++;
+            if (d_raycast > 0.0f) {
+                num_hits++;
+                error_sum += std::abs(d - d_raycast);
+            }
+        }
+    }
+    EXPECT_GT(num_hits, 0.9 * num_valid);
+    EXPECT_LT(error_sum / num_hits, 0.01);
+}
+
+TEST(ScalableTSDFVolume, WriteToFileReadFromFile) {
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    IntegrateTestSequence(tsdf_volume);
+    auto mesh = tsdf_volume.ExtractTriangleMesh();
+
+    const std::string filename =
+            std::string(TEST_DATA_DIR) + "/temp_scalable_tsdf_volume.bin";
+    EXPECT_TRUE(tsdf_volume.WriteToFile(filename));
+    integration::ScalableTSDFVolume tsdf_volume_read(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    EXPECT_TRUE(tsdf_volume_read.ReadFromFile(filename));
+    EXPECT_EQ(tsdf_volume_read.volume_units_.size(),
+              tsdf_volume.volume_units_.size());
+    auto mesh_read = tsdf_volume_read.ExtractTriangleMesh();
+    EXPECT_EQ(mesh_read->vertices_.size(), mesh->vertices_.size());
+    EXPECT_EQ(mesh_read->triangles_.size(), mesh->triangles_.size());
+    ExpectEQ(mesh_read->vertices_, mesh->vertices_);
+    ExpectEQ(mesh_read->vertex_colors_, mesh->vertex_colors_);
+
+    // The volume parameters must match.
+    integration::ScalableTSDFVolume tsdf_volume_gray(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::Gray32);
+    EXPECT_FALSE(tsdf_volume_gray.ReadFromFile(filename));
+    EXPECT_TRUE(tsdf_volume_gray.volume_units_.empty());
+    utility::filesystem::RemoveFile(filename);
+}
+
+TEST(ScalableTSDFVolume, Paging) {
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    IntegrateTestSequence(tsdf_volume);
+    auto mesh = tsdf_volume.ExtractTriangleMesh();
+    auto pcd = tsdf_volume.ExtractPointCloud();
+
+    const std::string directory =
+            std::string(TEST_DATA_DIR) + "/temp_scalable_tsdf_pages";
+    const size_t unit_size = 16 * 16 * 16 * 9;
+    const size_t budget = 820 * unit_size;
+    integration::ScalableTSDFVolume tsdf_volume_paged(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    EXPECT_TRUE(tsdf_volume_paged.EnablePaging(directory, budget));
+    EXPECT_TRUE(tsdf_volume_paged.IsPagingEnabled());
+    IntegrateTestSequence(tsdf_volume_paged);
+    EXPECT_EQ(tsdf_volume_paged.volume_units_.size(),
+              tsdf_volume.volume_units_.size());
+    EXPECT_LE(tsdf_volume_paged.GetResidentMemorySize(), budget);
+    size_t num_evictions = 0;
+    for (const auto &unit : tsdf_volume_paged.volume_units_) {
+        num_evictions += unit.num_evictions_;
+        EXPECT_GT(unit.num_accesses_, 0u);
+    }
+    EXPECT_GT(num_evictions, 0u);
+
+    // Extraction loads the paged out units in batches and gives the same
+    // geometry.
+    auto mesh_paged = tsdf_volume_paged.ExtractTriangleMesh();
+    EXPECT_LE(tsdf_volume_paged.GetResidentMemorySize(), budget);
+    EXPECT_EQ(mesh_paged->vertices_.size(), mesh->vertices_.size());
+    EXPECT_EQ(mesh_paged->triangles_.size(), mesh->triangles_.size());
+    ExpectEQ(mesh_paged->vertices_, mesh->vertices_);
+    auto pcd_paged = tsdf_volume_paged.ExtractPointCloud();
+    EXPECT_EQ(pcd_paged->points_.size(), pcd->points_.size());
+    ExpectEQ(pcd_paged->normals_, pcd->normals_);
+
+    // Units farther than the working radius from the camera are paged out.
+    EXPECT_TRUE(tsdf_volume_paged.EnablePaging(directory, 0, 1.0));
+    IntegrateTestSequence(tsdf_volume_paged, 4);
+    EXPECT_LT(tsdf_volume_paged.GetResidentMemorySize(),
+              tsdf_volume_paged.volume_units_.size() * unit_size);
+
+    tsdf_volume_paged.DisablePaging();
+    EXPECT_FALSE(tsdf_volume_paged.IsPagingEnabled());
+    EXPECT_EQ(tsdf_volume_paged.GetResidentMemorySize(),
+              tsdf_volume_paged.volume_units_.size() * unit_size);
+    std::vector<std::string> filenames;
+    utility::filesystem::ListFilesInDirectory(directory, filenames);
+    EXPECT_TRUE(filenames.empty());
+    utility::filesystem::DeleteDirectory(directory);
+}
+
+TEST(ScalableTSDFVolume, PagingCopy) {
+    integration::ScalableTSDFVolume tsdf_volume(
+            4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8);
+    IntegrateTestSequence(tsdf_volume);
+    auto mesh = tsdf_volume.ExtractTriangleMesh();
+
+    // Two volumes paging to the same directory keep their pages apart.
+    const std::string directory =
+            std::string(TEST_DATA_DIR) + "/temp_scalable_tsdf_pages_copy";
+    const size_t budget = 200 * 16 * 16 * 16 * 9;
+    std::unique_ptr<integration::ScalableTSDFVolume> tsdf_volume_paged(
+            new integration::ScalableTSDFVolume(
+                    4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8));
+    std::unique_ptr<integration::ScalableTSDFVolume> tsdf_volume_other(
+            new integration::ScalableTSDFVolume(
+                    4.0 / 512, 0.04, integration::TSDFVolumeColorType::RGB8));
+    EXPECT_TRUE(tsdf_volume_paged->EnablePaging(directory, budget));
+    EXPECT_TRUE(tsdf_volume_other->EnablePaging(directory, budget));
+    EXPECT_NE(tsdf_volume_paged->paging_directory_,
+              tsdf_volume_other->paging_directory_);
+    IntegrateTestSequence(*tsdf_volume_paged);
+    IntegrateTestSequence(*tsdf_volume_other, 4);
+
+    // The copy has page files of its own and outlives the original.
+    integration::ScalableTSDFVolume tsdf_volume_copy(*tsdf_volume_paged);
+    EXPECT_TRUE(tsdf_volume_copy.IsPagingEnabled());
+    EXPECT_NE(tsdf_volume_copy.paging_directory_,
+              tsdf_volume_paged->paging_directory_);
+    const std::string paging_directory = tsdf_volume_paged->paging_directory_;
+    tsdf_volume_paged.reset();
+    EXPECT_FALSE(utility::filesystem::DirectoryExists(paging_directory));
+
+    auto mesh_copy = tsdf_volume_copy.ExtractTriangleMesh();
+    EXPECT_EQ(mesh_copy->vertices_.size(), mesh->vertices_.size());
+    EXPECT_EQ(mesh_copy->triangles_.size(), mesh->triangles_.size());
+    ExpectEQ(mesh_copy->vertices_, mesh->vertices_);
+
+    // Assignment replaces the page files of the target.
+    const std::string other_directory = tsdf_volume_other->paging_directory_;
+    *tsdf_volume_other = tsdf_volume_copy;
+    EXPECT_FALSE(utility::filesystem::DirectoryExists(other_directory));
+    auto mesh_other = tsdf_volume_other->ExtractTriangleMesh();
+    EXPECT_EQ(mesh_other->triangles_.size(), mesh->triangles_.size());
+    ExpectEQ(mesh_other->vertices_, mesh->vertices_);
+
+    // Disabling paging and destroying a volume remove its page files.
+    tsdf_volume_copy.DisablePaging();
+    tsdf_volume_other.reset();
+    EXPECT_TRUE(utility::filesystem::DeleteDirectory(directory));
+}
+
 TEST(ScalableTSDFVolume, DISABLED_LocateVolumeUnit) {
     unit_test::NotImplemented();
 }
@@ -0,0 +1,100 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/TSDFVoxelArray.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+using namespace unit_test;
+
+TEST(TSDFVoxelArray, Constructor) {
+    integration::TSDFVoxelArray no_color(
+            integration::TSDFVolumeColorType::NoColor, 8);
+    EXPECT_EQ(no_color.size(), 8u);
+    EXPECT_EQ(no_color.BytesPerVoxel(), 6u);
+    EXPECT_EQ(no_color.color_rgb_.size(), 0u);
+    EXPECT_EQ(no_color.color_gray_.size(), 0u);
+
+    integration::TSDFVoxelArray rgb8(integration::TSDFVolumeColorType::RGB8,
+                                     8);
+    EXPECT_EQ(rgb8.BytesPerVoxel(), 9u);
+    EXPECT_EQ(rgb8.color_rgb_.size(), 24u);
+
+    integration::TSDFVoxelArray gray32(
+            integration::TSDFVolumeColorType::Gray32, 8);
+    EXPECT_EQ(gray32.BytesPerVoxel(), 10u);
+    EXPECT_EQ(gray32.color_gray_.size(), 8u);
+
+    for (size_t i = 0; i < rgb8.size(); i++) {
+        EXPECT_EQ(rgb8.weight_[i], 0);
+        EXPECT_EQ(rgb8.tsdf_[i], 0.0f);
+        ExpectEQ(rgb8.GetColor(i), Eigen::Vector3d(0, 0, 0));
+    }
+}
+
+TEST(TSDFVoxelArray, IntegrateVoxel) {
+    integration::TSDFVoxelArray voxels(integration::TSDFVolumeColorType::RGB8,
+                                       2);
+    geometry::Image color;
+    color.Prepare(2, 1, 3, 1);
+    uint8_t *rgb = color.PointerAt<uint8_t>(0, 0, 0);
+    rgb[0] = 10;
+    rgb[1] = 100;
+    rgb[2] = 255;
+    rgb = color.PointerAt<uint8_t>(1, 0, 0);
+    rgb[0] = 11;
+    rgb[1] = 200;
+    rgb[2] = 0;
+
+    voxels.IntegrateVoxel(1, 0.5f, color, 0, 0);
+    voxels.IntegrateVoxel(1, -0.25f, color, 1, 0);
+    EXPECT_EQ(voxels.weight_[0], 0);
+    EXPECT_EQ(voxels.weight_[1], 2);
+    EXPECT_NEAR(voxels.tsdf_[1], 0.125f, 1e-6f);
+    // The colors are averaged and rounded to the nearest integer.
+    ExpectEQ(voxels.GetColor(1),
+             Eigen::Vector3d(11 / 255.0, 150 / 255.0, 128 / 255.0));
+
+    voxels.Reset();
+    EXPECT_EQ(voxels.size(), 2u);
+    EXPECT_EQ(voxels.weight_[1], 0);
+    EXPECT_EQ(voxels.tsdf_[1], 0.0f);
+    ExpectEQ(voxels.GetColor(1), Eigen::Vector3d(0, 0, 0));
+}
+
+TEST(TSDFVoxelArray, IntegrateVoxelGray32) {
+    integration::TSDFVoxelArray voxels(
+            integration::TSDFVolumeColorType::Gray32, 1);
+    geometry::Image color;
+    color.Prepare(1, 1, 1, 4);
+    *color.PointerAt<float>(0, 0) = 0.2f;
+    voxels.IntegrateVoxel(0, 1.0f, color, 0, 0);
+    *color.PointerAt<float>(0, 0) = 0.6f;
+    voxels.IntegrateVoxel(0, 0.0f, color, 0, 0);
+    EXPECT_EQ(voxels.weight_[0], 2);
+    EXPECT_NEAR(voxels.tsdf_[0], 0.5f, 1e-6f);
+    ExpectEQ(voxels.GetColor(0), Eigen::Vector3d(0.4, 0.4, 0.4), 1e-6);
+}
@@ -32,6 +32,7 @@
 #include "Open3D/Visualization/Utility/DrawGeometry.h"
 #include "TestUtility/UnitTest.h"
 
+#include <algorithm>
 #include <sstream>
 
 using namespace open3d;
@@ -75,6 +76,26 @@ bool ReadPoses(const std::string& trajectory_path,
     return true;
 }
 
+// Sets the TSDF of a sphere, positive outside and observed everywhere.
+void FillSphere(integration::UniformTSDFVolume& tsdf_volume,
+                const Eigen::Vector3d& center,
+                double radius) {
+    const int resolution = tsdf_volume.resolution_;
+    for (int x = 0; x < resolution; x++) {
+        for (int y = 0; y < resolution; y++) {
+            for (int z = 0; z < resolution; z++) {
+                Eigen::Vector3d p = (Eigen::Vector3d(x, y, z).array() + 0.5) *
+                                    tsdf_volume.voxel_length_;
+                double sdf = (p - center).norm() - radius;
+                int ind = tsdf_volume.IndexOf(x, y, z);
+                tsdf_volume.voxels_.tsdf_[ind] = float(std::max(
+                        -1.0, std::min(1.0, sdf / tsdf_volume.sdf_trunc_)));
+                tsdf_volume.voxels_.weight_[ind] = 1;
+            }
+        }
+    }
+}
+
 TEST(UniformTSDFVolume, Constructor) {
     double length = 4.0;
     int resolution = 128;
@@ -160,7 +181,7 @@ TEST(UniformTSDFVolume, RealData) {
     for (const Eigen::Vector3d& color : mesh->vertex_colors_) {
         color_sum += color;
     }
-    ExpectEQ(color_sum, Eigen::Vector3d(2703.841944, 2561.480949, 2481.503805),
+    ExpectEQ(color_sum, Eigen::Vector3d(2705.601210, 2563.471258, 2483.468872),
              /*threshold*/ 0.1);
     // Uncomment to visualize
     // visualization::DrawGeometries({mesh});
@@ -173,7 +194,7 @@ TEST(UniformTSDFVolume, RealData) {
     for (const Eigen::Vector3d& color : pcd->colors_) {
         color_sum += color;
     }
-    ExpectEQ(color_sum, Eigen::Vector3d(1877.673116, 1862.126057, 1862.190616),
+    ExpectEQ(color_sum, Eigen::Vector3d(1878.831366, 1863.423597, 1863.484435),
              /*threshold*/ 0.1);
     Eigen::Vector3d normal_sum(0, 0, 0);
     for (const Eigen::Vector3d& normal : pcd->normals_) {
@@ -205,13 +226,98 @@ TEST(UniformTSDFVolume, DISABLED_Integrate) {}
 
 TEST(UniformTSDFVolume, DISABLED_ExtractPointCloud) {}
 
-TEST(UniformTSDFVolume, DISABLED_ExtractTriangleMesh) {}
+TEST(UniformTSDFVolume, ExtractTriangleMesh) {
+    // A sphere whose surface crosses several of the blocks that are meshed in
+    // parallel, so that the vertices on the block faces must be stitched.
+    const int resolution = 40;
+    const double radius = 0.3;
+    const Eigen::Vector3d center(0.5, 0.5, 0.5);
+    integration::UniformTSDFVolume tsdf_volume(
+            1.0, resolution, 0.1, integration::TSDFVolumeColorType::NoColor);
+    FillSphere(tsdf_volume, center, radius);
+    const double voxel_length = tsdf_volume.voxel_length_;
+
+    // Every grid edge with a sign change holds exactly one vertex.
+    const std::vector<float>& tsdf = tsdf_volume.voxels_.tsdf_;
+    size_t num_crossings = 0;
+    for (int x = 0; x < resolution; x++) {
+        for (int y = 0; y < resolution; y++) {
+            for (int z = 0; z < resolution; z++) {
+                float f0 = tsdf[tsdf_volume.IndexOf(x, y, z)];
+                for (int i = 0; i < 3; i++) {
+                    Eigen::Vector3i idx1(x, y, z);
+                    idx1(i)++;
+                    if (idx1(i) >= resolution) {
+                        continue;
+                    }
+                    float f1 = tsdf[tsdf_volume.IndexOf(idx1)];
+                    if ((f0 < 0.0f) != (f1 < 0.0f)) {
+                        num_crossings++;
+                    }
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<geometry::TriangleMesh> mesh =
+            tsdf_volume.ExtractTriangleMesh();
+    EXPECT_EQ(mesh->vertices_.size(), num_crossings);
+    EXPECT_FALSE(mesh->HasVertexColors());
+    EXPECT_TRUE(mesh->IsEdgeManifold(/*allow_boundary_edges*/ false));
+    for (const Eigen::Vector3d& vertex : mesh->vertices_) {
+        EXPECT_NEAR((vertex - center).norm(), radius, 0.5 * voxel_length);
+    }
+}
 
 TEST(UniformTSDFVolume, DISABLED_ExtractVoxelPointCloud) {}
 
 TEST(UniformTSDFVolume, DISABLED_IntegrateWithDepthToCameraDistanceMultiplier) {
 }
 
+TEST(UniformTSDFVolume, Raycast) {
+    const double radius = 0.3;
+    const Eigen::Vector3d center(0.5, 0.5, 0.5);
+    integration::UniformTSDFVolume tsdf_volume(
+            1.0, 40, 0.1, integration::TSDFVolumeColorType::NoColor);
+    FillSphere(tsdf_volume, center, radius);
+
+    // Camera at (0.5, 0.5, -0.5) looking along +z.
+    camera::PinholeCameraIntrinsic intrinsic(65, 49, 60.0, 60.0, 32.0, 24.0);
+    Eigen::Matrix4d extrinsic = Eigen::Matrix4d::Identity();
+    extrinsic.block<3, 1>(0, 3) = Eigen::Vector3d(-0.5, -0.5, 0.5);
+    auto result = tsdf_volume.Raycast(intrinsic, extrinsic);
+    EXPECT_EQ(result->depth_.width_, 65);
+    EXPECT_EQ(result->depth_.height_, 49);
+    EXPECT_FALSE(result->color_.HasData());
+
+    // The ray through the principal point hits the front of the sphere.
+    EXPECT_NEAR(*result->depth_.PointerAt<float>(32, 24), 0.7, 1e-3);
+    const float* vertex = result->vertex_map_.PointerAt<float>(32, 24, 0);
+    ExpectEQ(Eigen::Vector3d(vertex[0], vertex[1], vertex[2]),
+             Eigen::Vector3d(0.0, 0.0, 0.7), 1e-3);
+    const float* normal = result->normal_map_.PointerAt<float>(32, 24, 0);
+    ExpectEQ(Eigen::Vector3d(normal[0], normal[1], normal[2]),
+             Eigen::Vector3d(0.0, 0.0, -1.0), 1e-2);
+    // The ray through the corner misses it.
+    EXPECT_EQ(*result->depth_.PointerAt<float>(0, 0), 0.0f);
+
+    int num_hits = 0;
+    for (int v = 0; v < 49; v++) {
+        for (int u = 0; u < 65; u++) {
+            if (*result->depth_.PointerAt<float>(u, v) == 0.0f) {
+                continue;
+            }
+            num_hits++;
+            vertex = result->vertex_map_.PointerAt<float>(u, v, 0);
+            Eigen::Vector3d p = Eigen::Vector3d(vertex[0], vertex[1],
+                                                vertex[2]) -
+                                extrinsic.block<3, 1>(0, 3);
+            EXPECT_NEAR((p - center).norm(), radius, 5e-3);
+        }
+    }
+    EXPECT_GT(num_hits, 1000);
+}
+
 TEST(UniformTSDFVolume, DISABLED_IndexOf) {}
 
 TEST(UniformTSDFVolume, DISABLED_GetNormalAt) {}
@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Integration/VoxelBlockHashMap.h"
+#include "TestUtility/UnitTest.h"
+
+#include <vector>
+
+using namespace open3d;
+using namespace unit_test;
+
+TEST(VoxelBlockHashMap, Insert) {
+    // Every index is inserted by several iterations, possibly on different
+    // threads. Each is stored once and the handles are dense.
+    const int size = 8;
+    const int num_blocks = size * size * size;
+    integration::VoxelBlockHashMap map(num_blocks);
+    std::vector<int> num_inserted(num_blocks, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (int i = 0; i < 4 * num_blocks; i++) {
+        const int n = i % num_blocks;
+        bool inserted;
+        const int handle = map.Insert(
+                Eigen::Vector3i(n % size - size / 2, (n / size) % size,
+                                n / (size * size) - size),
+                inserted);
+        EXPECT_GE(handle, 0);
+        EXPECT_LT(handle, num_blocks);
+        if (inserted) {
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+            num_inserted[n]++;
+        }
+    }
+    EXPECT_EQ(map.size(), size_t(num_blocks));
+    std::vector<bool> used(num_blocks, false);
+    for (int n = 0; n < num_blocks; n++) {
+        EXPECT_EQ(num_inserted[n], 1);
+        const Eigen::Vector3i index(n % size - size / 2, (n / size) % size,
+                                    n / (size * size) - size);
+        const int handle = map.Find(index);
+        ASSERT_GE(handle, 0);
+        EXPECT_FALSE(used[handle]);
+        used[handle] = true;
+        ExpectEQ(map.GetIndex(handle), index);
+    }
+}
+
+TEST(VoxelBlockHashMap, Find) {
+    integration::VoxelBlockHashMap map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.Find(Eigen::Vector3i(0, 0, 0)), -1);
+    bool inserted;
+    map.Reserve(2);
+    EXPECT_EQ(map.Insert(Eigen::Vector3i(1, -2, 3), inserted), 0);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(map.Insert(Eigen::Vector3i(-1, 2, -3), inserted), 1);
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(map.Insert(Eigen::Vector3i(1, -2, 3), inserted), 0);
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(map.Find(Eigen::Vector3i(1, -2, 3)), 0);
+    EXPECT_EQ(map.Find(Eigen::Vector3i(-1, 2, -3)), 1);
+    EXPECT_EQ(map.Find(Eigen::Vector3i(1, 2, 3)), -1);
+}
+
+TEST(VoxelBlockHashMap, Reserve) {
+    // Growing the table and copying the map keep the handles.
+    integration::VoxelBlockHashMap map;
+    bool inserted;
+    for (int i = 0; i < 1000; i++) {
+        map.Reserve(map.size() + 1);
+        EXPECT_EQ(map.Insert(Eigen::Vector3i(i, -i, 2 * i), inserted), i);
+    }
+    integration::VoxelBlockHashMap map_copy(map);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_EQ(map.Find(Eigen::Vector3i(i, -i, 2 * i)), i);
+        EXPECT_EQ(map_copy.Find(Eigen::Vector3i(i, -i, 2 * i)), i);
+    }
+
+    map.Clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.Find(Eigen::Vector3i(0, 0, 0)), -1);
+    EXPECT_EQ(map_copy.size(), 1000u);
+}
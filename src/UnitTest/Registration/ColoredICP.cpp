@@ -24,10 +24,46 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/ColoredICP.h"
 #include "TestUtility/UnitTest.h"
 
-TEST(ColoredICP, DISABLED_RegistrationColoredICP) {
-    unit_test::NotImplemented();
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+TEST(ColoredICP, RegistrationColoredICP) {
+    int size = 500;
+    geometry::PointCloud target;
+    target.points_.resize(size);
+    target.normals_.resize(size);
+    target.colors_.resize(size);
+    Rand(target.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    Rand(target.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0),
+         1);
+    Rand(target.colors_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 2);
+    target.NormalizeNormals();
+
+    Matrix4d motion = Matrix4d::Identity();
+    motion.block<3, 1>(0, 3) = Vector3d(0.01, -0.01, 0.01);
+    geometry::PointCloud source = target;
+    source.Transform(motion);
+
+    auto result = registration::RegistrationColoredICP(source, target, 0.1);
+
+    // Repeated registrations against one context give the same result as the
+    // plain function.
+    auto context =
+            registration::CreateRegistrationContextForColoredICP(target, 0.1);
+    for (int i = 0; i < 2; i++) {
+        auto result_context =
+                registration::RegistrationColoredICP(source, *context, 0.1);
+        ExpectEQ(Matrix4d(result.transformation_),
+                 Matrix4d(result_context.transformation_));
+        EXPECT_EQ(result_context.fitness_, result.fitness_);
+        EXPECT_EQ(result_context.inlier_rmse_, result.inlier_rmse_);
+    }
 }
 
 TEST(ColoredICP, DISABLED_ICPConvergenceCriteria) {
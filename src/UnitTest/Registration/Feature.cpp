@@ -24,14 +24,86 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include "Open3D/Geometry/KDTreeFlann.h"
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/Feature.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
 TEST(Feature, DISABLED_Resize) { unit_test::NotImplemented(); }
 
 TEST(Feature, DISABLED_Dimension) { unit_test::NotImplemented(); }
 
 TEST(Feature, DISABLED_Num) { unit_test::NotImplemented(); }
 
-TEST(Feature, DISABLED_ComputeFPFHFeature) { unit_test::NotImplemented(); }
+TEST(Feature, ComputeFPFHFeature) {
+    int size = 500;
+    geometry::PointCloud pc;
+    pc.points_.resize(size);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    pc.EstimateNormals(geometry::KDTreeSearchParamKNN(10));
+
+    auto fpfh = registration::ComputeFPFHFeature(
+            pc, geometry::KDTreeSearchParamKNN(20));
+    EXPECT_EQ(fpfh->Dimension(), size_t(33));
+    EXPECT_EQ(fpfh->Num(), size_t(size));
+
+    // Each of the three 11-bin histograms sums to 100 in the SPFH of the point
+    // and to 100 in the weighted SPFH of its neighbors.
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < 3; j++) {
+            EXPECT_NEAR(fpfh->data_.col(i).segment<11>(j * 11).sum(), 200.0,
+                        1e-9);
+        }
+    }
+
+    // A hybrid search whose radius covers the whole cloud finds the same
+    // neighborhoods as the KNN search.
+    auto fpfh_hybrid = registration::ComputeFPFHFeature(
+            pc, geometry::KDTreeSearchParamHybrid(10.0, 20));
+    EXPECT_EQ((fpfh->data_ - fpfh_hybrid->data_).cwiseAbs().maxCoeff(), 0.0);
+}
+
+TEST(Feature, MatchFPFHFeatureFloat32) {
+    int size = 500;
+    geometry::PointCloud target;
+    target.points_.resize(size);
+    Rand(target.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    geometry::PointCloud source = target;
+    vector<Vector3d> noise(size);
+    Rand(noise, Vector3d(-0.01, -0.01, -0.01), Vector3d(0.01, 0.01, 0.01), 1);
+    for (int i = 0; i < size; i++) {
+        source.points_[i] += noise[i];
+    }
+    target.EstimateNormals(geometry::KDTreeSearchParamKNN(10));
+    source.EstimateNormals(geometry::KDTreeSearchParamKNN(10));
+    auto target_fpfh = registration::ComputeFPFHFeature(
+            target, geometry::KDTreeSearchParamKNN(20));
+    auto source_fpfh = registration::ComputeFPFHFeature(
+            source, geometry::KDTreeSearchParamKNN(20));
+
+    // The float index used for feature matching finds the same
+    // correspondences as the double one.
+    geometry::KDTreeFlann kdtree64(*target_fpfh);
+    geometry::KDTreeFlann kdtree32(*target_fpfh,
+                                   geometry::KDTreeFlann::Precision::Float32);
+    vector<int> indices64, indices32;
+    vector<double> distance2_64, distance2_32;
+    EXPECT_EQ(kdtree64.BatchSearchKNN(source_fpfh->data_, 1, indices64,
+                                      distance2_64),
+              size);
+    EXPECT_EQ(kdtree32.BatchSearchKNN(source_fpfh->data_, 1, indices32,
+                                      distance2_32),
+              size);
+    ExpectEQ(indices64, indices32);
+    for (int i = 0; i < size; i++) {
+        EXPECT_NEAR(distance2_64[i], distance2_32[i],
+                    1e-4 * (1.0 + distance2_64[i]));
+    }
+}
 
 TEST(Feature, DISABLED_KDTreeSearchParamKNN) { unit_test::NotImplemented(); }
@@ -0,0 +1,110 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/GeneralizedICP.h"
+
+#include <Eigen/Geometry>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Samples three orthogonal planes meeting at the origin, which constrain all
+// six degrees of freedom of a rigid motion.
+geometry::PointCloud CreatePlanarCorner() {
+    geometry::PointCloud corner;
+    vector<Vector3d> uv(1000);
+    Rand(uv, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 0.0), 0);
+    for (const auto &p : uv) {
+        corner.points_.push_back(Vector3d(p(0), p(1), 0.0));
+        corner.points_.push_back(Vector3d(p(1), 0.0, p(0)));
+        corner.points_.push_back(Vector3d(0.0, p(0), p(1)));
+    }
+    return corner;
+}
+
+Matrix4d CreateMotion() {
+    Matrix4d motion = Matrix4d::Identity();
+    motion.block<3, 3>(0, 0) =
+            AngleAxisd(0.05, Vector3d(1.0, 2.0, 3.0).normalized()).matrix();
+    motion.block<3, 1>(0, 3) = Vector3d(0.02, -0.01, 0.03);
+    return motion;
+}
+
+}  // unnamed namespace
+
+TEST(GeneralizedICP, ComputeRMSE) {
+    geometry::PointCloud source;
+    source.points_ = {{0.0, 0.0, 0.1}};
+    source.covariances_ = {Matrix3d::Identity()};
+    geometry::PointCloud target;
+    target.points_ = {{0.0, 0.0, 0.0}};
+    target.covariances_ = {Matrix3d::Identity()};
+    registration::CorrespondenceSet corres = {Vector2i(0, 0)};
+
+    registration::TransformationEstimationForGeneralizedICP estimation;
+    EXPECT_EQ(estimation.GetTransformationEstimationType(),
+              registration::TransformationEstimationType::GeneralizedICP);
+    // Mahalanobis distance of 0.1 under the covariance 2 * I.
+    EXPECT_NEAR(estimation.ComputeRMSE(source, target, corres),
+                0.1 / sqrt(2.0), 1e-12);
+    EXPECT_EQ(estimation.ComputeRMSE(source, geometry::PointCloud(), {}), 0.0);
+}
+
+TEST(GeneralizedICP, RegistrationGeneralizedICP) {
+    geometry::PointCloud target = CreatePlanarCorner();
+    Matrix4d motion = CreateMotion();
+    geometry::PointCloud source = target;
+    source.Transform(motion);
+
+    auto criteria = registration::ICPConvergenceCriteria(1e-8, 1e-8, 50);
+    auto result = registration::RegistrationGeneralizedICP(
+            source, target, 0.1, Matrix4d::Identity(),
+            registration::TransformationEstimationForGeneralizedICP(),
+            criteria);
+    ExpectEQ(Matrix4d(motion.inverse()), Matrix4d(result.transformation_),
+             1e-4);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+    EXPECT_FALSE(source.HasCovariances());
+
+    // Covariances estimated beforehand are reused, and a robust kernel gives
+    // the same solution on outlier-free data.
+    source.EstimateCovariances(geometry::KDTreeSearchParamKNN(20));
+    target.EstimateCovariances(geometry::KDTreeSearchParamKNN(20));
+    auto robust_result = registration::RegistrationGeneralizedICP(
+            source, target, 0.1, Matrix4d::Identity(),
+            registration::TransformationEstimationForGeneralizedICP(
+                    1e-3, make_shared<registration::HuberLoss>(0.5)),
+            criteria);
+    ExpectEQ(Matrix4d(motion.inverse()),
+             Matrix4d(robust_result.transformation_), 1e-4);
+}
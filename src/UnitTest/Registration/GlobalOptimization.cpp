@@ -24,14 +24,106 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Dense>
+
+#include "Open3D/Registration/GlobalOptimization.h"
+#include "Open3D/Registration/PoseGraph.h"
+#include "Open3D/Utility/Eigen.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Pose graph of a closed loop of n_nodes nodes, with exact odometry and loop
+// closure edges and perturbed node poses.
+void CreateLoopPoseGraph(registration::PoseGraph &pose_graph,
+                         vector<Matrix4d, utility::Matrix4d_allocator> &poses,
+                         int n_nodes) {
+    poses.clear();
+    pose_graph.nodes_.clear();
+    pose_graph.edges_.clear();
+    Vector6d noise;
+    noise << 0.01, -0.02, 0.01, 0.05, -0.03, 0.02;
+    for (int i = 0; i < n_nodes; i++) {
+        double angle = 2.0 * M_PI * i / n_nodes;
+        Vector6d x;
+        x << 0.0, 0.0, angle, std::cos(angle), std::sin(angle), 0.1 * i;
+        poses.push_back(utility::TransformVector6dToMatrix4d(x));
+        Matrix4d perturbation = Matrix4d::Identity();
+        if (i > 0) {
+            perturbation =
+                    utility::TransformVector6dToMatrix4d(noise * (i % 3 + 1));
+        }
+        pose_graph.nodes_.push_back(
+                registration::PoseGraphNode(perturbation * poses[i]));
+    }
+    for (int i = 0; i < n_nodes; i++) {
+        for (int k = 1; k <= 2; k++) {
+            int j = (i + k) % n_nodes;
+            Matrix4d trans = poses[j].inverse() * poses[i];
+            pose_graph.edges_.push_back(registration::PoseGraphEdge(
+                    i, j, trans, Matrix6d::Identity() * 100.0, k != 1, 1.0));
+        }
+    }
+}
+
+void TestGlobalOptimization(
+        const registration::GlobalOptimizationMethod &method) {
+    registration::PoseGraph pose_graph;
+    vector<Matrix4d, utility::Matrix4d_allocator> poses;
+    CreateLoopPoseGraph(pose_graph, poses, 12);
+
+    registration::GlobalOptimizationConvergenceCriteria criteria;
+    registration::GlobalOptimizationOption option;
+    option.reference_node_ = 0;
+    registration::GlobalOptimization(pose_graph, method, criteria, option);
+
+    EXPECT_EQ(pose_graph.nodes_.size(), poses.size());
+    EXPECT_EQ(pose_graph.edges_.size(), 24u);
+    for (size_t i = 0; i < poses.size(); i++) {
+        Matrix4d pose = pose_graph.nodes_[i].pose_;
+        ExpectEQ(poses[i], pose, 1e-4);
+    }
+}
+
+}  // unnamed namespace
+
 TEST(GlobalOptimization, DISABLED_Constructor) { unit_test::NotImplemented(); }
 
 TEST(GlobalOptimization, DISABLED_MemberData) { unit_test::NotImplemented(); }
 
-TEST(GlobalOptimization, DISABLED_GlobalOptimizationLevenbergMarquardt) {
-    unit_test::NotImplemented();
+TEST(GlobalOptimization, GlobalOptimizationLevenbergMarquardt) {
+    TestGlobalOptimization(
+            registration::GlobalOptimizationLevenbergMarquardt());
+}
+
+TEST(GlobalOptimization, GlobalOptimizationGaussNewton) {
+    TestGlobalOptimization(registration::GlobalOptimizationGaussNewton());
+}
+
+TEST(GlobalOptimization, GlobalOptimizationGaussNewtonWithoutReferenceNode) {
+    // Without a reference node the Gauss-Newton system is rank deficient, so
+    // the solver anchors the first node, which is unperturbed here.
+    registration::PoseGraph pose_graph;
+    vector<Matrix4d, utility::Matrix4d_allocator> poses;
+    CreateLoopPoseGraph(pose_graph, poses, 12);
+
+    registration::GlobalOptimizationConvergenceCriteria criteria;
+    registration::GlobalOptimizationOption option;
+    option.reference_node_ = -1;
+    registration::GlobalOptimization(
+            pose_graph, registration::GlobalOptimizationGaussNewton(), criteria,
+            option);
+
+    EXPECT_EQ(pose_graph.nodes_.size(), poses.size());
+    for (size_t i = 0; i < poses.size(); i++) {
+        Matrix4d pose = pose_graph.nodes_[i].pose_;
+        ExpectEQ(poses[i], pose, 1e-4);
+    }
 }
 
 TEST(GlobalOptimization, DISABLED_GlobalOptimizationConvergenceCriteria) {
@@ -0,0 +1,137 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include <Eigen/Geometry>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/GeneralizedICP.h"
+#include "Open3D/Registration/MultiScaleICP.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+TEST(MultiScaleICP, PointCloudPyramid) {
+    geometry::PointCloud pc;
+    pc.points_.resize(2000);
+    Rand(pc.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+
+    registration::PointCloudPyramid pyramid(pc, {0.2, 0.1, 0.0});
+    EXPECT_EQ(pyramid.NumLevels(), size_t(3));
+    EXPECT_LT(pyramid.GetLevel(0).points_.size(),
+              pyramid.GetLevel(1).points_.size());
+    EXPECT_LT(pyramid.GetLevel(1).points_.size(),
+              pyramid.GetLevel(2).points_.size());
+    EXPECT_EQ(pyramid.GetLevel(2).points_.size(), pc.points_.size());
+    for (size_t i = 0; i < pyramid.NumLevels(); i++) {
+        EXPECT_TRUE(pyramid.GetLevel(i).HasNormals());
+    }
+
+    // The context of a level is built once.
+    EXPECT_EQ(&pyramid.GetContext(1), &pyramid.GetContext(1));
+    EXPECT_EQ(&pyramid.GetContext(1).GetTarget(), &pyramid.GetLevel(1));
+}
+
+TEST(MultiScaleICP, RegistrationMultiScaleICP) {
+    geometry::PointCloud target;
+    target.points_.resize(2000);
+    Rand(target.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+
+    Matrix4d motion = Matrix4d::Identity();
+    motion.block<3, 3>(0, 0) =
+            AngleAxisd(0.1, Vector3d(1.0, 2.0, 3.0).normalized()).matrix();
+    motion.block<3, 1>(0, 3) = Vector3d(0.05, -0.03, 0.04);
+    geometry::PointCloud source = target;
+    source.Transform(motion);
+
+    vector<double> voxel_sizes = {0.1, 0.05, 0.0};
+    vector<double> distances = {0.3, 0.1, 0.05};
+    vector<registration::ICPConvergenceCriteria> criteria(
+            3, registration::ICPConvergenceCriteria(1e-8, 1e-8, 100));
+
+    registration::RegistrationResult result;
+    vector<registration::MultiScaleICPLevelResult> level_results;
+    std::tie(result, level_results) = registration::RegistrationMultiScaleICP(
+            source, target, voxel_sizes, distances, criteria);
+    ExpectEQ(Matrix4d(motion.inverse()), Matrix4d(result.transformation_),
+             1e-4);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+
+    EXPECT_EQ(level_results.size(), size_t(3));
+    for (size_t i = 0; i < level_results.size(); i++) {
+        EXPECT_EQ(level_results[i].voxel_size_, voxel_sizes[i]);
+        EXPECT_EQ(level_results[i].max_correspondence_distance_,
+                  distances[i]);
+        EXPECT_GE(level_results[i].time_, 0.0);
+    }
+    EXPECT_EQ(level_results.back().fitness_, result.fitness_);
+}
+
+TEST(MultiScaleICP, RegistrationMultiScaleGeneralizedICP) {
+    // Points on three faces of a box, so that every level has well defined
+    // local planes.
+    geometry::PointCloud target;
+    vector<Vector3d> samples(3000);
+    Rand(samples, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    for (size_t i = 0; i < samples.size(); i++) {
+        Vector3d point = samples[i];
+        point(i % 3) = 0.0;
+        target.points_.push_back(point);
+    }
+
+    Matrix4d motion = Matrix4d::Identity();
+    motion.block<3, 3>(0, 0) =
+            AngleAxisd(0.05, Vector3d(1.0, 2.0, 3.0).normalized()).matrix();
+    motion.block<3, 1>(0, 3) = Vector3d(0.03, -0.02, 0.02);
+    geometry::PointCloud source = target;
+    source.Transform(motion);
+
+    vector<double> voxel_sizes = {0.1, 0.05, 0.0};
+    vector<double> distances = {0.3, 0.1, 0.05};
+    vector<registration::ICPConvergenceCriteria> criteria(
+            3, registration::ICPConvergenceCriteria(1e-8, 1e-8, 100));
+
+    // The pyramids built for Generalized ICP carry covariances on each level.
+    registration::PointCloudPyramid pyramid(target, voxel_sizes, false, true);
+    for (size_t i = 0; i < pyramid.NumLevels(); i++) {
+        EXPECT_TRUE(pyramid.GetLevel(i).HasCovariances());
+        EXPECT_EQ(pyramid.GetLevel(i).covariances_.size(),
+                  pyramid.GetLevel(i).points_.size());
+    }
+
+    registration::RegistrationResult result;
+    vector<registration::MultiScaleICPLevelResult> level_results;
+    std::tie(result, level_results) = registration::RegistrationMultiScaleICP(
+            source, target, voxel_sizes, distances, criteria,
+            Matrix4d::Identity(),
+            registration::TransformationEstimationForGeneralizedICP());
+    ExpectEQ(Matrix4d(motion.inverse()), Matrix4d(result.transformation_),
+             1e-4);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+    EXPECT_EQ(level_results.size(), size_t(3));
+}
@@ -24,8 +24,72 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
+#include <atomic>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Registration/CorrespondenceChecker.h"
+#include "Open3D/Registration/Feature.h"
+#include "Open3D/Registration/Registration.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Target: random points in a box. Source: the target moved by a small rigid
+// motion, so that ICP aligns source to target with the inverse motion.
+void CreateRegistrationPair(geometry::PointCloud &source,
+                            geometry::PointCloud &target,
+                            Matrix4d &ground_truth) {
+    int size = 1000;
+    target.points_.resize(size);
+    Rand(target.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+
+    Matrix4d motion = Matrix4d::Identity();
+    motion.block<3, 3>(0, 0) =
+            AngleAxisd(0.05, Vector3d(1.0, 2.0, 3.0).normalized()).matrix();
+    motion.block<3, 1>(0, 3) = Vector3d(0.02, -0.01, 0.015);
+    source = target;
+    source.Transform(motion);
+    ground_truth = motion.inverse();
+}
+
+// Distinctive random features, with a third of the source features replaced
+// by unrelated ones to create outlier correspondences.
+void CreateRegistrationFeatures(int size,
+                                registration::Feature &source_feature,
+                                registration::Feature &target_feature) {
+    target_feature.Resize(8, size);
+    source_feature.Resize(8, size);
+    Rand(target_feature.data_.data(), int(target_feature.data_.size()), 0.0,
+         1.0, 0);
+    source_feature.data_ = target_feature.data_;
+    for (int i = 0; i < size; i += 3) {
+        Rand(source_feature.data_.col(i).data(), 8, 0.0, 1.0, i + 1);
+    }
+}
+
+// Accepts every sample and counts the RANSAC iterations, since every
+// iteration runs the checkers that do not require alignment.
+class IterationCounter : public registration::CorrespondenceChecker {
+public:
+    IterationCounter() : registration::CorrespondenceChecker(false) {}
+    bool Check(const geometry::PointCloud &,
+               const geometry::PointCloud &,
+               const registration::CorrespondenceSet &,
+               const Eigen::Matrix4d &) const override {
+        count_++;
+        return true;
+    }
+    mutable std::atomic<int> count_{0};
+};
+
+}  // unnamed namespace
+
 TEST(Registration, DISABLED_ICPConvergenceCriteria) {
     unit_test::NotImplemented();
 }
@@ -42,11 +106,87 @@ TEST(Registration, DISABLED_RANSACConvergenceCriteria) {
 
 TEST(Registration, DISABLED_RegistrationResult) { unit_test::NotImplemented(); }
 
-TEST(Registration, DISABLED_EvaluateRegistration) {
-    unit_test::NotImplemented();
+TEST(Registration, EvaluateRegistration) {
+    geometry::PointCloud source, target;
+    Matrix4d ground_truth;
+    CreateRegistrationPair(source, target, ground_truth);
+
+    auto result = registration::EvaluateRegistration(source, target, 0.01,
+                                                     ground_truth);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+    EXPECT_NEAR(result.inlier_rmse_, 0.0, 1e-6);
+    EXPECT_EQ(result.correspondence_set_.size(), source.points_.size());
+
+    registration::RegistrationContext context(target);
+    for (int i = 0; i < 2; i++) {
+        auto result_context = registration::EvaluateRegistration(
+                source, context, 0.01, ground_truth);
+        EXPECT_EQ(result_context.fitness_, result.fitness_);
+        EXPECT_EQ(result_context.inlier_rmse_, result.inlier_rmse_);
+    }
 }
 
-TEST(Registration, DISABLED_RegistrationICP) { unit_test::NotImplemented(); }
+TEST(Registration, EvaluateRegistrationCorrespondences) {
+    // A grid with enough points to span several compaction blocks, with a
+    // part of the source moved out of range of the target.
+    geometry::PointCloud target;
+    for (int x = 0; x < 22; x++) {
+        for (int y = 0; y < 22; y++) {
+            for (int z = 0; z < 22; z++) {
+                target.points_.push_back(Vector3d(x, y, z) * 0.05);
+            }
+        }
+    }
+    int size = (int)target.points_.size();
+    geometry::PointCloud source = target;
+    for (int i = 0; i < size; i += 3) {
+        source.points_[i] += Vector3d(2.0, 0.0, 0.0);
+    }
+
+    auto result = registration::EvaluateRegistration(source, target, 0.01);
+    registration::CorrespondenceSet ref;
+    for (int i = 0; i < size; i++) {
+        if (i % 3 != 0) {
+            ref.push_back(Vector2i(i, i));
+        }
+    }
+    ExpectEQ(ref, result.correspondence_set_);
+    EXPECT_NEAR(result.fitness_, double(ref.size()) / size, 1e-12);
+    EXPECT_EQ(result.inlier_rmse_, 0.0);
+
+    auto empty_result = registration::EvaluateRegistration(
+            source, geometry::PointCloud(), 0.01);
+    EXPECT_EQ(empty_result.fitness_, 0.0);
+    EXPECT_TRUE(empty_result.correspondence_set_.empty());
+}
+
+TEST(Registration, RegistrationICP) {
+    geometry::PointCloud source, target;
+    Matrix4d ground_truth;
+    CreateRegistrationPair(source, target, ground_truth);
+
+    auto result = registration::RegistrationICP(
+            source, target, 0.2, Matrix4d::Identity(),
+            registration::TransformationEstimationPointToPoint(),
+            registration::ICPConvergenceCriteria(1e-6, 1e-6, 100));
+    ExpectEQ(ground_truth, Matrix4d(result.transformation_), 1e-4);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+
+    // Repeated registrations against one context give the same result as the
+    // plain function, and the source is not modified.
+    registration::RegistrationContext context(target);
+    for (int i = 0; i < 2; i++) {
+        auto result_context = registration::RegistrationICP(
+                source, context, 0.2, Matrix4d::Identity(),
+                registration::TransformationEstimationPointToPoint(),
+                registration::ICPConvergenceCriteria(1e-6, 1e-6, 100));
+        ExpectEQ(Matrix4d(result.transformation_),
+                 Matrix4d(result_context.transformation_));
+        EXPECT_EQ(result_context.correspondence_set_.size(),
+                  result.correspondence_set_.size());
+    }
+    EXPECT_EQ(&context.GetTarget(), &target);
+}
 
 TEST(Registration, DISABLED_TransformationEstimationPointToPoint) {
     unit_test::NotImplemented();
@@ -56,8 +196,43 @@ TEST(Registration, DISABLED_RegistrationRANSACBasedOnCorrespondence) {
     unit_test::NotImplemented();
 }
 
-TEST(Registration, DISABLED_RegistrationRANSACBasedOnFeatureMatching) {
-    unit_test::NotImplemented();
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatching) {
+    geometry::PointCloud source, target;
+    Matrix4d ground_truth;
+    CreateRegistrationPair(source, target, ground_truth);
+
+    registration::Feature source_feature, target_feature;
+    CreateRegistrationFeatures(int(target.points_.size()), source_feature,
+                               target_feature);
+
+    auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.01,
+            registration::TransformationEstimationPointToPoint(false), 4, {},
+            registration::RANSACConvergenceCriteria(100000, 100000));
+    ExpectEQ(ground_truth, Matrix4d(result.transformation_), 1e-6);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+}
+
+TEST(Registration, RegistrationRANSACBasedOnFeatureMatchingAdaptive) {
+    geometry::PointCloud source, target;
+    Matrix4d ground_truth;
+    CreateRegistrationPair(source, target, ground_truth);
+    registration::Feature source_feature, target_feature;
+    CreateRegistrationFeatures(int(target.points_.size()), source_feature,
+                               target_feature);
+
+    // Two thirds of the matches are correct, so a confidence of 0.999 needs
+    // about 31 samples of 4 matches.
+    IterationCounter counter;
+    auto result = registration::RegistrationRANSACBasedOnFeatureMatching(
+            source, target, source_feature, target_feature, 0.01,
+            registration::TransformationEstimationPointToPoint(false), 4,
+            {counter},
+            registration::RANSACConvergenceCriteria(100000, 100000, 0.999));
+    ExpectEQ(ground_truth, Matrix4d(result.transformation_), 1e-6);
+    EXPECT_NEAR(result.fitness_, 1.0, 1e-12);
+    EXPECT_GT(int(counter.count_), 0);
+    EXPECT_LT(int(counter.count_), 1000);
 }
 
 TEST(Registration, DISABLED_GetInformationMatrixFromPointClouds) {
@@ -0,0 +1,55 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Registration/RobustKernel.h"
+#include "TestUtility/UnitTest.h"
+
+using namespace open3d;
+
+TEST(RobustKernel, Weight) {
+    registration::L2Loss l2;
+    EXPECT_EQ(l2.Weight(0.0), 1.0);
+    EXPECT_EQ(l2.Weight(-5.0), 1.0);
+
+    registration::HuberLoss huber(0.5);
+    EXPECT_EQ(huber.Weight(0.3), 1.0);
+    EXPECT_EQ(huber.Weight(-0.5), 1.0);
+    EXPECT_NEAR(huber.Weight(-2.0), 0.25, 1e-12);
+
+    registration::CauchyLoss cauchy(0.5);
+    EXPECT_EQ(cauchy.Weight(0.0), 1.0);
+    EXPECT_NEAR(cauchy.Weight(1.0), 0.2, 1e-12);
+
+    registration::GMLoss gm(0.5);
+    EXPECT_EQ(gm.Weight(0.0), 1.0);
+    EXPECT_NEAR(gm.Weight(-0.5), 0.25 / 0.5625, 1e-12);
+
+    registration::TukeyLoss tukey(0.5);
+    EXPECT_EQ(tukey.Weight(0.0), 1.0);
+    EXPECT_NEAR(tukey.Weight(0.25), 0.5625, 1e-12);
+    EXPECT_EQ(tukey.Weight(0.5), 0.0);
+    EXPECT_EQ(tukey.Weight(-0.6), 0.0);
+}
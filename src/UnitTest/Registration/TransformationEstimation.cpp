@@ -24,8 +24,60 @@
 // IN THE SOFTWARE.
 // ----------------------------------------------------------------------------
 
+#include <Eigen/Geometry>
+
+#include "Open3D/Geometry/PointCloud.h"
+#include "Open3D/Geometry/SoAPointCloud.h"
+#include "Open3D/Registration/TransformationEstimation.h"
 #include "TestUtility/UnitTest.h"
 
+using namespace Eigen;
+using namespace open3d;
+using namespace std;
+using namespace unit_test;
+
+namespace {
+
+// Runs point to plane ICP steps with fixed correspondences, a fifth of which
+// are outliers, and returns the distance of the estimated transformation to
+// the ground truth.
+double PointToPlaneError(
+        const registration::TransformationEstimationPointToPlane &estimation) {
+    int size = 1000;
+    geometry::PointCloud target;
+    target.points_.resize(size);
+    target.normals_.resize(size);
+    Rand(target.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    Rand(target.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0),
+         1);
+    target.NormalizeNormals();
+
+    Matrix4d motion = Matrix4d::Identity();
+    motion.block<3, 3>(0, 0) =
+            AngleAxisd(0.02, Vector3d(1.0, 2.0, 3.0).normalized()).matrix();
+    motion.block<3, 1>(0, 3) = Vector3d(0.01, -0.02, 0.015);
+    geometry::PointCloud source = target;
+    source.Transform(motion);
+
+    registration::CorrespondenceSet corres(size);
+    vector<int> outliers(size / 5);
+    Rand(outliers, 0, size - 1, 2);
+    for (int i = 0; i < size; i++) {
+        corres[i] = Vector2i(i, i < size / 5 ? outliers[i] : i);
+    }
+
+    Matrix4d transformation = Matrix4d::Identity();
+    for (int i = 0; i < 20; i++) {
+        Matrix4d update =
+                estimation.ComputeTransformation(source, target, corres);
+        source.Transform(update);
+        transformation = update * transformation;
+    }
+    return (transformation * motion - Matrix4d::Identity()).norm();
+}
+
+}  // unnamed namespace
+
 TEST(TransformationEstimation, DISABLED_Constructor) {
     unit_test::NotImplemented();
 }
@@ -54,6 +106,72 @@ TEST(TransformationEstimation, DISABLED_TransformationEstimationPointToPoint) {
     unit_test::NotImplemented();
 }
 
-TEST(TransformationEstimation, DISABLED_TransformationEstimationPointToPlane) {
-    unit_test::NotImplemented();
+TEST(TransformationEstimation, TransformationEstimationPointToPlane) {
+    double error_l2 = PointToPlaneError(
+            registration::TransformationEstimationPointToPlane());
+    double error_tukey = PointToPlaneError(
+            registration::TransformationEstimationPointToPlane(
+                    make_shared<registration::TukeyLoss>(0.05)));
+    double error_huber = PointToPlaneError(
+            registration::TransformationEstimationPointToPlane(
+                    make_shared<registration::HuberLoss>(0.01)));
+    EXPECT_LT(error_tukey, 0.1 * error_l2);
+    EXPECT_LT(error_huber, 0.1 * error_l2);
+}
+
+TEST(TransformationEstimation, SoAPointCloud) {
+    size_t size = 100;
+    geometry::PointCloud source;
+    source.points_.resize(size);
+    source.normals_.resize(size);
+    Rand(source.points_, Vector3d(0.0, 0.0, 0.0), Vector3d(1.0, 1.0, 1.0), 0);
+    Rand(source.normals_, Vector3d(-1.0, -1.0, -1.0), Vector3d(1.0, 1.0, 1.0),
+         1);
+    geometry::PointCloud target = source;
+    Matrix4d transformation = Matrix4d::Identity();
+    transformation.block<3, 3>(0, 0) =
+            geometry::Geometry3D::GetRotationMatrixFromXYZ({0.1, 0.2, -0.1});
+    transformation.block<3, 1>(0, 3) = Vector3d(0.05, -0.02, 0.03);
+    target.Transform(transformation);
+    registration::CorrespondenceSet corres;
+    for (int i = 0; i < int(size); i++) {
+        corres.push_back(Vector2i(i, i));
+    }
+
+    geometry::SoAPointCloud<double> source_double(source);
+    geometry::SoAPointCloud<double> target_double(target);
+    geometry::SoAPointCloud<float> source_float(source);
+    geometry::SoAPointCloud<float> target_float(target);
+
+    registration::TransformationEstimationPointToPoint point_to_point;
+    double rmse = point_to_point.ComputeRMSE(source, target, corres);
+    Matrix4d result =
+            point_to_point.ComputeTransformation(source, target, corres);
+    ExpectEQ(transformation, result);
+    EXPECT_EQ(rmse, point_to_point.ComputeRMSE(source_double, target_double,
+                                               corres));
+    ExpectEQ(result, point_to_point.ComputeTransformation(
+                             source_double, target_double, corres));
+    EXPECT_NEAR(rmse,
+                point_to_point.ComputeRMSE(source_float, target_float, corres),
+                1e-6);
+    ExpectEQ(result,
+             point_to_point.ComputeTransformation(source_float, target_float,
+                                                  corres),
+             1e-5);
+
+    registration::TransformationEstimationPointToPlane point_to_plane;
+    rmse = point_to_plane.ComputeRMSE(source, target, corres);
+    result = point_to_plane.ComputeTransformation(source, target, corres);
+    EXPECT_EQ(rmse, point_to_plane.ComputeRMSE(source_double, target_double,
+                                               corres));
+    ExpectEQ(result, point_to_plane.ComputeTransformation(
+                             source_double, target_double, corres));
+    EXPECT_NEAR(rmse,
+                point_to_plane.ComputeRMSE(source_float, target_float, corres),
+                1e-6);
+    ExpectEQ(result,
+             point_to_plane.ComputeTransformation(source_float, target_float,
+                                                  corres),
+             1e-5);
 }
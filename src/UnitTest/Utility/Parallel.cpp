@@ -0,0 +1,58 @@
+// ----------------------------------------------------------------------------
+// -                        Open3D: www.open3d.org                            -
+// ----------------------------------------------------------------------------
+// The MIT License (MIT)
+//
+// Copyright (c) 2018 www.open3d.org
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+// ----------------------------------------------------------------------------
+
+#include "Open3D/Utility/Parallel.h"
+#include "TestUtility/UnitTest.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace open3d;
+
+TEST(Parallel, ParallelSort) {
+    // Large enough to be split into chunks, with many equal keys.
+    const int size = 200000;
+    std::vector<std::pair<int, int>> values(size);
+    for (int i = 0; i < size; i++) {
+        values[i] = std::make_pair(int((i * 7919LL) % 1013), size - i);
+    }
+    std::vector<std::pair<int, int>> values_ref = values;
+    std::sort(values_ref.begin(), values_ref.end());
+    utility::ParallelSort(values.begin(), values.end());
+    EXPECT_TRUE(values == values_ref);
+
+    std::sort(values_ref.begin(), values_ref.end(),
+              std::greater<std::pair<int, int>>());
+    utility::ParallelSort(values.begin(), values.end(),
+                          std::greater<std::pair<int, int>>());
+    EXPECT_TRUE(values == values_ref);
+
+    std::vector<int> empty;
+    utility::ParallelSort(empty.begin(), empty.end());
+    EXPECT_TRUE(empty.empty());
+}